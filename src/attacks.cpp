@@ -26,13 +26,41 @@ namespace Stockfish::Attacks {
 
 namespace {
 
-Bitboard LineBB[SQUARE_NB][SQUARE_NB];
-Bitboard BetweenBB[SQUARE_NB][SQUARE_NB];
-Bitboard RayPassBB[SQUARE_NB][SQUARE_NB];
+// The line, between and ray-pass tables are fully deterministic, so they
+// are built at compile time: they live in .rodata, cost no startup work
+// and their pages are shared across processes by the page cache instead
+// of being recomputed and dirtied in every one.
+struct LineTables {
+    Bitboard line[SQUARE_NB][SQUARE_NB];
+    Bitboard between[SQUARE_NB][SQUARE_NB];
+    Bitboard rayPass[SQUARE_NB][SQUARE_NB];
+};
+
+constexpr LineTables Lines = []() {
+    LineTables t{};
 
-#ifdef USE_DUAL_HYPERBOLA_QUINT
-alignas(64) DualMagic DualMagics[SQUARE_NB];
-#else
+    for (Square s1 = SQ_A1; s1 <= SQ_H8; ++s1)
+    {
+        for (PieceType pt : {BISHOP, ROOK})
+            for (Square s2 = SQ_A1; s2 <= SQ_H8; ++s2)
+            {
+                if (PseudoAttacks[pt][s1] & s2)
+                {
+                    t.line[s1][s2] =
+                      (sliding_attack(pt, s1, 0) & sliding_attack(pt, s2, 0)) | s1 | s2;
+                    t.between[s1][s2] = sliding_attack(pt, s1, square_bb(s2))
+                                      & sliding_attack(pt, s2, square_bb(s1));
+                    t.rayPass[s1][s2] =
+                      sliding_attack(pt, s1, 0) & (sliding_attack(pt, s2, square_bb(s1)) | s2);
+                }
+                t.between[s1][s2] |= s2;
+            }
+    }
+
+    return t;
+}();
+
+#if !defined(USE_DUAL_HYPERBOLA_QUINT) && !defined(USE_HYPERBOLA_QUINT)
 alignas(64) Magic Magics[SQUARE_NB][2];
 #endif
 
@@ -44,8 +72,8 @@ using MagicMask = u16;
 using MagicMask = Bitboard;
 #endif
 
-[[maybe_unused]] static Bitboard line_mask(Square sq, Direction d1, Direction d2) {
-    Bitboard mask = 0, dest;
+[[maybe_unused]] static constexpr Bitboard line_mask(Square sq, Direction d1, Direction d2) {
+    Bitboard mask = 0, dest = 0;
     for (Direction d : {d1, d2})
     {
         Square s = sq;
@@ -59,7 +87,12 @@ using MagicMask = Bitboard;
 }
 
 #ifdef USE_HYPERBOLA_QUINT
-static void init_magics(Magic magics[][2]) {
+namespace {
+// Only masks are needed on this configuration, so the whole table is a
+// compile-time constant.
+constexpr auto Magics = []() {
+    std::array<std::array<Magic, 2>, SQUARE_NB> magics{};
+
     for (Square s = SQ_A1; s <= SQ_H8; ++s)
     {
         Magic& rook = magics[s][ROOK - BISHOP];
@@ -70,6 +103,9 @@ static void init_magics(Magic magics[][2]) {
         bishop.mask1  = line_mask(s, NORTH_EAST, SOUTH_WEST);
         bishop.mask2  = line_mask(s, NORTH_WEST, SOUTH_EAST);
     }
+
+    return magics;
+}();
 }
 
 #elif defined(USE_DUAL_HYPERBOLA_QUINT)
@@ -84,7 +120,12 @@ constexpr auto RankAttacks = []() {
     return table;
 }();
 
-static void init_dual_magics(DualMagic magics[]) {
+namespace {
+// RankAttacks has static storage duration, so the lookup pointers below
+// are themselves compile-time constants.
+alignas(64) constexpr auto DualMagics = []() {
+    std::array<DualMagic, SQUARE_NB> magics{};
+
     for (Square s = SQ_A1; s <= SQ_H8; ++s)
     {
         DualMagic& m        = magics[s];
@@ -97,6 +138,9 @@ static void init_dual_magics(DualMagic magics[]) {
         m.rankAttacksLookup = RankAttacks[int(file_of(s))].data();
         m.shift             = 8 * int(rank_of(s));
     }
+
+    return magics;
+}();
 }
 
 #else
@@ -219,31 +263,12 @@ std::array<MagicMask, 0x1480>  BishopTable;
 
 void init() {
 
-#ifdef USE_HYPERBOLA_QUINT
-    init_magics(Magics);
-#elif defined(USE_DUAL_HYPERBOLA_QUINT)
-    init_dual_magics(DualMagics);
-#else
+    // The hyperbola-quintessence tables and the line tables above are
+    // compile-time constants, so only the classic magics need runtime work.
+#if !defined(USE_HYPERBOLA_QUINT) && !defined(USE_DUAL_HYPERBOLA_QUINT)
     init_magics(ROOK, const_cast<MagicMask*>(RookTable.data()), Magics, true);
     init_magics(BISHOP, const_cast<MagicMask*>(BishopTable.data()), Magics, true);
 #endif
-
-    for (Square s1 = SQ_A1; s1 <= SQ_H8; ++s1)
-    {
-        for (PieceType pt : {BISHOP, ROOK})
-            for (Square s2 = SQ_A1; s2 <= SQ_H8; ++s2)
-            {
-                if (PseudoAttacks[pt][s1] & s2)
-                {
-                    LineBB[s1][s2] = (attacks_bb(pt, s1, 0) & attacks_bb(pt, s2, 0)) | s1 | s2;
-                    BetweenBB[s1][s2] =
-                      (attacks_bb(pt, s1, square_bb(s2)) & attacks_bb(pt, s2, square_bb(s1)));
-                    RayPassBB[s1][s2] =
-                      attacks_bb(pt, s1, 0) & (attacks_bb(pt, s2, square_bb(s1)) | s2);
-                }
-                BetweenBB[s1][s2] |= s2;
-            }
-    }
 }
 
 #ifdef USE_DUAL_HYPERBOLA_QUINT
@@ -257,17 +282,17 @@ const Magic& magic(Square s, PieceType pt) {
 
 Bitboard line_bb(Square s1, Square s2) {
     assert(is_ok(s1) && is_ok(s2));
-    return LineBB[s1][s2];
+    return Lines.line[s1][s2];
 }
 
 Bitboard between_bb(Square s1, Square s2) {
     assert(is_ok(s1) && is_ok(s2));
-    return BetweenBB[s1][s2];
+    return Lines.between[s1][s2];
 }
 
 Bitboard ray_pass_bb(Square s1, Square s2) {
     assert(is_ok(s1) && is_ok(s2));
-    return RayPassBB[s1][s2];
+    return Lines.rayPass[s1][s2];
 }
 
 }  // namespace Stockfish::Attacks
@@ -22,6 +22,7 @@
 #include <cassert>
 #include <array>
 #include <initializer_list>
+#include <utility>
 
 #include "types.h"
 #include "bitboard.h"
@@ -331,6 +332,41 @@ inline Bitboard attacks_bb(Piece pc, Square s, Bitboard occupied) {
                                : attacks_bb(type_of(pc), s, occupied);
 }
 
+// Computes the [bishop, rook] attack boards over 'occupied' for every square
+// in 'sliders' in one batched pass, written to out[] in pop_lsb() order; the
+// caller must provide popcount(sliders) slots. Queens consume both boards, so
+// a whole position's sliders need just one pass. On the dual hyperbola-
+// quintessence path two sliders are processed per iteration: the two inlined
+// HQ chains are independent and share the broadcast occupancy, so they
+// interleave and hide each other's shuffle/sub latency. Other paths (PEXT,
+// classic magics) are single-load lookups with nothing left to batch and fall
+// back to the single-square helpers.
+inline void all_slider_attacks(Bitboard sliders, Bitboard occupied, std::pair<Bitboard, Bitboard>* out) {
+
+#ifdef USE_DUAL_HYPERBOLA_QUINT
+    while (sliders & (sliders - 1))
+    {
+        Square s1 = pop_lsb(sliders);
+        Square s2 = pop_lsb(sliders);
+
+        auto a1 = dual_magic(s1).both_attacks_bb(occupied);
+        auto a2 = dual_magic(s2).both_attacks_bb(occupied);
+
+        *out++ = a1;
+        *out++ = a2;
+    }
+
+    if (sliders)
+        *out = dual_magic(lsb(sliders)).both_attacks_bb(occupied);
+#else
+    while (sliders)
+    {
+        Square s = pop_lsb(sliders);
+        *out++   = {attacks_bb<BISHOP>(s, occupied), attacks_bb<ROOK>(s, occupied)};
+    }
+#endif
+}
+
 }  // namespace Stockfish::Attacks
 
 #endif  // #ifndef ATTACKS_H_INCLUDED
@@ -23,6 +23,7 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 namespace {
@@ -504,4 +505,108 @@ BenchmarkSetup setup_benchmark(std::istream& is) {
     return setup;
 }
 
+
+// Builds the setup for the benchrun command, which sweeps thread count and
+// TT size configurations over the bench positions and repeats each one to
+// get variance figures. There are five parameters: the number of measured
+// repeats per configuration, the search depth, a comma-separated list of
+// thread counts, a comma-separated list of TT sizes in MB, and a file name
+// where to look for positions in FEN format. Examples:
+//
+// benchrun                    : 5 repeats at depth 13, 1 thread, TT = 16MB
+// benchrun 10 15              : 10 repeats at depth 15
+// benchrun 5 13 1,2,4 16,64   : sweep 1, 2 and 4 threads against 16MB and 64MB TTs
+BenchRunSetup setup_benchrun(std::istream& is) {
+
+    static constexpr int DEFAULT_REPEATS = 5;
+    static constexpr int DEFAULT_DEPTH   = 13;
+
+    BenchRunSetup setup{};
+    std::string   token;
+
+    auto parseIntList = [](const std::string& str) {
+        std::vector<int>   values;
+        std::istringstream ss(str);
+        std::string        item;
+        while (std::getline(ss, item, ','))
+            values.push_back(std::stoi(item));
+        return values;
+    };
+
+    auto joinIntList = [](const std::vector<int>& values) {
+        std::string str;
+        for (int v : values)
+            str += (str.empty() ? "" : ",") + std::to_string(v);
+        return str;
+    };
+
+    if (is >> setup.repeats)
+        setup.originalInvocation += std::to_string(setup.repeats);
+    else
+        setup.repeats = DEFAULT_REPEATS;
+
+    if (is >> setup.depth)
+        setup.originalInvocation += " " + std::to_string(setup.depth);
+    else
+        setup.depth = DEFAULT_DEPTH;
+
+    if (is >> token)
+    {
+        setup.threadCounts = parseIntList(token);
+        setup.originalInvocation += " " + token;
+    }
+    else
+        setup.threadCounts = {1};
+
+    if (is >> token)
+    {
+        setup.ttSizes = parseIntList(token);
+        setup.originalInvocation += " " + token;
+    }
+    else
+        setup.ttSizes = {16};
+
+    std::string fenFile = (is >> token) ? token : "default";
+    if (fenFile != "default")
+        setup.originalInvocation += " " + fenFile;
+
+    setup.filledInvocation = std::to_string(setup.repeats) + " " + std::to_string(setup.depth)
+                           + " " + joinIntList(setup.threadCounts) + " "
+                           + joinIntList(setup.ttSizes) + " " + fenFile;
+
+    std::vector<std::string> fens;
+
+    if (fenFile == "default")
+        fens = Defaults;
+    else
+    {
+        std::string   fen;
+        std::ifstream file(fenFile);
+
+        if (!file.is_open())
+        {
+            std::cerr << "Unable to open file " << fenFile << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        while (getline(file, fen))
+            if (!fen.empty())
+                fens.push_back(fen);
+
+        file.close();
+    }
+
+    for (const std::string& fen : fens)
+        if (fen.find("setoption") != std::string::npos)
+            setup.commands.emplace_back(fen);
+        else
+        {
+            setup.commands.emplace_back("position fen " + fen);
+            setup.commands.emplace_back("go depth " + std::to_string(setup.depth));
+        }
+
+    return setup;
+}
+
+
 }  // namespace Stockfish
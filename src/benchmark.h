@@ -37,6 +37,18 @@ struct BenchmarkSetup {
 
 BenchmarkSetup setup_benchmark(std::istream&);
 
+struct BenchRunSetup {
+    std::vector<int>         threadCounts;
+    std::vector<int>         ttSizes;
+    int                      repeats;
+    int                      depth;
+    std::vector<std::string> commands;
+    std::string              originalInvocation;
+    std::string              filledInvocation;
+};
+
+BenchRunSetup setup_benchrun(std::istream&);
+
 }  // namespace Stockfish
 
 #endif  // #ifndef BENCHMARK_H_INCLUDED
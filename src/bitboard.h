@@ -20,6 +20,7 @@
 #define BITBOARD_H_INCLUDED
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -33,7 +34,6 @@ namespace Stockfish {
 
 namespace Bitboards {
 
-void        init();
 std::string pretty(Bitboard b);
 
 }  // namespace Stockfish::Bitboards
@@ -65,9 +65,6 @@ constexpr Bitboard Rank6BB = Rank1BB << (8 * 5);
 constexpr Bitboard Rank7BB = Rank1BB << (8 * 6);
 constexpr Bitboard Rank8BB = Rank1BB << (8 * 7);
 
-extern u8 PopCnt16[1 << 16];
-extern u8 SquareDistance[SQUARE_NB][SQUARE_NB];
-
 constexpr Bitboard square_bb(Square s) {
     assert(is_ok(s));
     return 1ULL << s;
@@ -149,6 +146,21 @@ inline int distance<Rank>(Square x, Square y) {
     return std::abs(rank_of(x) - rank_of(y));
 }
 
+// Built at compile time so the table lives in .rodata: the pages cost no
+// startup work and are shared between processes by the page cache.
+inline constexpr auto SquareDistance = []() {
+    constexpr auto abs = [](int v) { return v < 0 ? -v : v; };
+
+    std::array<std::array<u8, SQUARE_NB>, SQUARE_NB> dist{};
+
+    for (Square x = SQ_A1; x <= SQ_H8; ++x)
+        for (Square y = SQ_A1; y <= SQ_H8; ++y)
+            dist[x][y] =
+              u8(std::max(abs(file_of(x) - file_of(y)), abs(rank_of(x) - rank_of(y))));
+
+    return dist;
+}();
+
 template<>
 inline int distance<Square>(Square x, Square y) {
     return SquareDistance[x][y];
@@ -164,6 +176,19 @@ constexpr int constexpr_popcount(Bitboard b) {
     return static_cast<int>((b * 0x0101010101010101ULL) >> 56);
 }
 
+#ifndef USE_POPCNT
+// 16-bit popcount lookup for the software fallback below, built at compile
+// time for the same .rodata sharing reasons as SquareDistance.
+inline constexpr auto PopCnt16 = []() {
+    std::array<u8, 1 << 16> counts{};
+
+    for (unsigned i = 0; i < counts.size(); ++i)
+        counts[i] = u8(constexpr_popcount(i));
+
+    return counts;
+}();
+#endif
+
 // Counts the number of non-zero bits in a bitboard.
 inline int popcount(Bitboard b) {
 
@@ -0,0 +1,213 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "book.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "misc.h"
+#include "movegen.h"
+#include "position.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Stockfish {
+
+namespace {
+
+constexpr usize EntrySize = 16;
+
+u64 read_be(const unsigned char* p, int bytes) {
+    u64 v = 0;
+    for (int i = 0; i < bytes; ++i)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+// Resolves a PolyGlot-encoded move against the position's legal moves:
+// to-square in bits 0-5, from-square in bits 6-11, promotion piece in bits
+// 12-14 (0 = none, 1 = knight .. 4 = queen). Castling is encoded king-takes-
+// rook, which matches our own castling to-square convention directly.
+Move decode(u16 raw, const MoveList<LEGAL>& legal) {
+
+    Square to    = make_square(File(raw & 7), Rank((raw >> 3) & 7));
+    Square from  = make_square(File((raw >> 6) & 7), Rank((raw >> 9) & 7));
+    int    promo = (raw >> 12) & 7;
+
+    for (const Move m : legal)
+    {
+        if (m.from_sq() != from)
+            continue;
+
+        if (m.type_of() == CASTLING)
+        {
+            if (m.to_sq() == to)
+                return m;
+        }
+        else if (m.to_sq() == to)
+        {
+            if (m.type_of() == PROMOTION)
+            {
+                if (promo && m.promotion_type() == PieceType(KNIGHT + promo - 1))
+                    return m;
+            }
+            else if (!promo)
+                return m;
+        }
+    }
+
+    return Move::none();
+}
+
+}  // namespace
+
+
+Book::~Book() { close(); }
+
+void Book::close() {
+#ifndef _WIN32
+    if (mapped)
+        munmap(const_cast<unsigned char*>(data), mapSize);
+#endif
+    data    = nullptr;
+    count   = 0;
+    mapped  = false;
+    mapSize = 0;
+    owned.clear();
+    owned.shrink_to_fit();
+}
+
+
+std::string Book::open(const std::string& path) {
+
+    close();
+
+    if (path.empty())
+        return "Book disabled";
+
+    usize size = 0;
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            size = usize(st.st_size);
+
+            void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                data    = static_cast<const unsigned char*>(p);
+                mapped  = true;
+                mapSize = size;
+            }
+        }
+        ::close(fd);
+    }
+#endif
+
+    if (!mapped)
+    {
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        if (!stream)
+            return "Failed to open book file " + path;
+
+        size = usize(stream.tellg());
+        owned.resize(size);
+        stream.seekg(0);
+        stream.read(reinterpret_cast<char*>(owned.data()), std::streamsize(size));
+        if (!stream)
+        {
+            close();
+            return "Failed to read book file " + path;
+        }
+        data = owned.data();
+    }
+
+    if (size == 0 || size % EntrySize != 0)
+    {
+        usize s = size;
+        close();
+        return "Book file " + path + " has invalid size " + std::to_string(s);
+    }
+
+    count = size / EntrySize;
+    return "Book loaded: " + path + " (" + std::to_string(count) + " entries)";
+}
+
+
+Move Book::probe(const Position& pos, bool pickBest) const {
+
+    if (!count)
+        return Move::none();
+
+    const Key key = pos.key();
+
+    auto entry_key = [this](usize i) { return read_be(data + i * EntrySize, 8); };
+
+    // Entries are sorted by key; find the first one at or above ours
+    usize lo = 0, hi = count;
+    while (lo < hi)
+    {
+        usize mid = (lo + hi) / 2;
+        if (entry_key(mid) < u64(key))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    const MoveList<LEGAL> legal(pos);
+
+    Move best       = Move::none();
+    u64  bestWeight = 0;
+    u64  total      = 0;
+
+    // Seeded once, not per probe: consecutive probes within the same
+    // millisecond must not draw the same line. Only the UCI thread probes.
+    static PRNG rng{u64(now())};
+
+    for (usize i = lo; i < count && entry_key(i) == u64(key); ++i)
+    {
+        Move m = decode(u16(read_be(data + i * EntrySize + 8, 2)), legal);
+        if (!m)
+            continue;
+
+        // Zero-weighted entries stay playable, just minimally likely
+        u64 weight = std::max<u64>(read_be(data + i * EntrySize + 10, 2), 1);
+        total += weight;
+
+        if (pickBest ? weight > bestWeight
+                     : rng.rand<u64>() % total < weight)  // reservoir sampling
+        {
+            bestWeight = weight;
+            best       = m;
+        }
+    }
+
+    return best;
+}
+
+}  // namespace Stockfish
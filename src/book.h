@@ -0,0 +1,69 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BOOK_H_INCLUDED
+#define BOOK_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "types.h"
+
+namespace Stockfish {
+
+class Position;
+
+// Native opening book in the PolyGlot container format: 16-byte big-endian
+// entries (key, move, weight, learn), sorted by key for binary search. The
+// entries are keyed by the engine's own Position::key() — our books are built
+// in-house with this same engine — not by the original PolyGlot Zobrist
+// table, so a stock PolyGlot book will simply never hit. The file is mapped
+// read-only where possible, so the pages are shared between all engine
+// processes on the host through the page cache.
+class Book {
+   public:
+    Book() = default;
+    ~Book();
+
+    Book(const Book&)            = delete;
+    Book& operator=(const Book&) = delete;
+
+    // Maps/loads the given book, replacing any open one; an empty path just
+    // closes it. Returns a printable status line.
+    std::string open(const std::string& path);
+
+    bool enabled() const { return count > 0; }
+
+    // A legal book move for the position, or Move::none(). With pickBest the
+    // highest-weighted move is returned, otherwise one is drawn with
+    // probability proportional to its weight.
+    Move probe(const Position& pos, bool pickBest) const;
+
+   private:
+    void close();
+
+    const unsigned char*       data    = nullptr;  // entries, mapped or owned
+    usize                      count   = 0;        // number of entries
+    bool                       mapped  = false;
+    usize                      mapSize = 0;        // mapped byte length, for munmap
+    std::vector<unsigned char> owned;  // fallback storage when mmap is unavailable
+};
+
+}  // namespace Stockfish
+
+#endif  // #ifndef BOOK_H_INCLUDED
@@ -0,0 +1,249 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "capi.h"
+
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "attacks.h"
+#include "engine.h"
+#include "misc.h"
+#include "position.h"
+#include "score.h"
+#include "search.h"
+#include "uci.h"
+
+using namespace Stockfish;
+
+// The C handle: one Engine plus the latest results, which the listeners
+// installed at creation keep up to date. pvBuf backs the pv pointer handed
+// out in sf_info/sf_search_result; it is stable until the next search.
+struct sf_engine {
+    Engine engine{std::nullopt};
+
+    std::mutex       mutex;
+    sf_search_result last{};
+    std::string      pvBuf;
+
+    sf_info_cb     infoCb = nullptr;
+    sf_bestmove_cb bestCb = nullptr;
+    void*          user   = nullptr;
+};
+
+namespace {
+
+void copy_move(char (&dst)[8], std::string_view src) {
+    usize n = std::min(src.size(), sizeof(dst) - 1);
+    std::memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+}
+
+// UCI conventions, as in UCIEngine::format_score: tablebase scores become
+// large centipawn values, mate scores full-move counts
+void fill_score(sf_info& info, const Score& s) {
+    constexpr int TB_CP = 20000;
+
+    info.score_cp = info.score_mate = 0;
+
+    if (s.is<Score::Mate>())
+        info.score_mate = [&] {
+            int plies = s.get<Score::Mate>().plies;
+            return (plies > 0 ? plies + 1 : plies) / 2;
+        }();
+    else if (s.is<Score::Tablebase>())
+    {
+        auto tb       = s.get<Score::Tablebase>();
+        info.score_cp = (tb.win ? TB_CP : -TB_CP) - tb.plies;
+    }
+    else
+        info.score_cp = s.get<Score::InternalUnits>().value;
+}
+
+Search::LimitsType to_limits(const sf_limits* l) {
+    Search::LimitsType limits;
+    limits.startTime = now();
+
+    if (l)
+    {
+        limits.depth       = l->depth;
+        limits.nodes       = l->nodes;
+        limits.movetime    = l->movetime_ms;
+        limits.time[WHITE] = l->wtime_ms;
+        limits.time[BLACK] = l->btime_ms;
+        limits.inc[WHITE]  = l->winc_ms;
+        limits.inc[BLACK]  = l->binc_ms;
+        limits.movestogo   = l->movestogo;
+        limits.mate        = l->mate;
+    }
+
+    if (!limits.depth && !limits.nodes && !limits.movetime && !limits.use_time_management()
+        && !limits.mate)
+        limits.infinite = 1;
+
+    return limits;
+}
+
+}  // namespace
+
+
+sf_engine* sf_create(void) {
+
+    // The one-time table setup main() normally does
+    static const bool initialized = [] {
+        Attacks::init();
+        Position::init();
+        return true;
+    }();
+    (void) initialized;
+
+    sf_engine* e = new (std::nothrow) sf_engine;
+    if (!e)
+        return nullptr;
+
+    e->engine.set_on_update_full([e](const Engine::InfoFull& i) {
+        std::lock_guard lk(e->mutex);
+
+        sf_info& info = e->last.info;
+        info.depth    = i.depth;
+        info.seldepth = i.selDepth;
+        info.nodes    = i.nodes;
+        info.nps      = i.nps;
+        info.time_ms  = i64(i.timeMs);
+        info.hashfull = i.hashfull;
+        fill_score(info, i.score);
+
+        e->pvBuf.assign(i.pv);
+        info.pv = e->pvBuf.c_str();
+
+        if (e->infoCb)
+            e->infoCb(&info, e->user);
+    });
+
+    e->engine.set_on_update_no_moves([e](const Engine::InfoShort& i) {
+        std::lock_guard lk(e->mutex);
+        e->last.info.depth = i.depth;
+        fill_score(e->last.info, i.score);
+    });
+
+    e->engine.set_on_bestmove([e](std::string_view bm, std::string_view pn) {
+        std::lock_guard lk(e->mutex);
+        copy_move(e->last.bestmove, bm);
+        copy_move(e->last.ponder, pn);
+
+        if (e->bestCb)
+            e->bestCb(&e->last, e->user);
+    });
+
+    e->engine.set_on_iter([](const Engine::InfoIter&) {});
+
+    return e;
+}
+
+
+void sf_destroy(sf_engine* e) { delete e; }
+
+
+const char* sf_version(void) {
+    static const std::string version = engine_info();
+    return version.c_str();
+}
+
+
+int sf_set_option(sf_engine* e, const char* name, const char* value) {
+    if (!e || !name || !value)
+        return 1;
+
+    std::istringstream is("name " + std::string(name) + " value " + std::string(value));
+    e->engine.get_options().setoption(is);
+    return 0;
+}
+
+
+int sf_set_position(sf_engine* e, const char* fen, const char* uci_moves) {
+    if (!e)
+        return 1;
+
+    std::vector<std::string> moves;
+    if (uci_moves)
+    {
+        std::istringstream is(uci_moves);
+        for (std::string m; is >> m;)
+            moves.push_back(m);
+    }
+
+    return e->engine.set_position(fen ? fen : StartFEN, moves).has_value();
+}
+
+
+int sf_search(sf_engine* e, const sf_limits* limits, sf_search_result* result) {
+    if (!e || !result)
+        return 1;
+
+    {
+        std::lock_guard lk(e->mutex);
+        e->infoCb = nullptr;
+        e->bestCb = nullptr;
+        e->user   = nullptr;
+        e->last   = {};
+    }
+
+    Search::LimitsType lim = to_limits(limits);
+    e->engine.go(lim);
+    e->engine.wait_for_search_finished();
+
+    std::lock_guard lk(e->mutex);
+    *result = e->last;
+    return 0;
+}
+
+
+int sf_search_async(
+  sf_engine* e, const sf_limits* limits, sf_info_cb on_info, sf_bestmove_cb on_bestmove, void* user) {
+    if (!e)
+        return 1;
+
+    {
+        std::lock_guard lk(e->mutex);
+        e->infoCb = on_info;
+        e->bestCb = on_bestmove;
+        e->user   = user;
+        e->last   = {};
+    }
+
+    Search::LimitsType lim = to_limits(limits);
+    e->engine.go(lim);
+    return 0;
+}
+
+
+void sf_stop(sf_engine* e) {
+    if (e)
+        e->engine.stop();
+}
+
+
+void sf_wait(sf_engine* e) {
+    if (e)
+        e->engine.wait_for_search_finished();
+}
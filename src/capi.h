@@ -0,0 +1,118 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CAPI_H_INCLUDED
+#define CAPI_H_INCLUDED
+
+/*
+  C embedding API around the Engine class, for linking the engine straight
+  into a host process instead of talking UCI over pipes. Build the archive
+  with 'make lib ARCH=... COMP=...' (produces libstockfish.a, everything but
+  main.o) and include only this header from the host; it deliberately pulls
+  in no engine headers so the ABI surface stays a handful of plain structs.
+
+  One sf_engine corresponds to one Engine: its own threads, transposition
+  table and options. All calls on a given sf_engine must come from one host
+  thread at a time; searches run on the engine's internal pool and the
+  callbacks of sf_search_async fire from those threads. Scores follow UCI
+  conventions (centipawns from the side to move, or mate in full moves).
+*/
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct sf_engine sf_engine;
+
+/* All zero means no limit of that kind; an all-zero struct (or NULL)
+   searches until sf_stop(). Mirrors Search::LimitsType. */
+typedef struct sf_limits {
+    int      depth;
+    uint64_t nodes;
+    int64_t  movetime_ms;
+    int64_t  wtime_ms, btime_ms, winc_ms, binc_ms;
+    int      movestogo;
+    int      mate; /* search for a mate in this many moves */
+} sf_limits;
+
+/* One principal-variation update, as in SearchManager::UpdateContext's
+   onUpdateFull. Either score_mate is nonzero (mate in that many full moves,
+   negative when being mated) or score_cp holds a centipawn value. The pv
+   string is only valid for the duration of the callback. */
+typedef struct sf_info {
+    int         depth;
+    int         seldepth;
+    int         score_cp;
+    int         score_mate;
+    uint64_t    nodes;
+    uint64_t    nps;
+    int64_t     time_ms;
+    int         hashfull;
+    const char* pv;
+} sf_info;
+
+/* Final state of a finished search. bestmove is "(none)" when the position
+   has no legal moves; ponder is empty when there is none. info.pv points at
+   engine-owned storage that stays valid until the next search or
+   sf_destroy, and is NULL when no PV was ever reported. */
+typedef struct sf_search_result {
+    char    bestmove[8];
+    char    ponder[8];
+    sf_info info;
+} sf_search_result;
+
+typedef void (*sf_info_cb)(const sf_info* info, void* user);
+typedef void (*sf_bestmove_cb)(const sf_search_result* result, void* user);
+
+/* Engine lifetime. sf_create returns NULL on failure. The engine starts
+   with default options; load a network with sf_set_option("EvalFile", path)
+   unless one is embedded in the build. */
+sf_engine* sf_create(void);
+void       sf_destroy(sf_engine* e);
+
+const char* sf_version(void);
+
+/* As 'setoption name <name> value <value>'. Returns 0 on success. */
+int sf_set_option(sf_engine* e, const char* name, const char* value);
+
+/* fen NULL means the start position; uci_moves is a space-separated move
+   list in UCI notation or NULL. Returns 0 on success, nonzero when the FEN
+   or a move is invalid (the previous position is kept). */
+int sf_set_position(sf_engine* e, const char* fen, const char* uci_moves);
+
+/* Blocking search; fills *result. Returns 0 on success. */
+int sf_search(sf_engine* e, const sf_limits* limits, sf_search_result* result);
+
+/* Non-blocking search. on_info fires per PV update, on_bestmove once at the
+   end; either may be NULL. The callbacks run on engine threads. A second
+   search may only be started after the previous one finished. */
+int sf_search_async(
+  sf_engine* e, const sf_limits* limits, sf_info_cb on_info, sf_bestmove_cb on_bestmove, void* user);
+
+/* Ask a running search to stop (it still reports through the callbacks),
+   and block until the search has finished. */
+void sf_stop(sf_engine* e);
+void sf_wait(sf_engine* e);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAPI_H_INCLUDED */
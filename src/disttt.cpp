@@ -0,0 +1,538 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "disttt.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "misc.h"
+#include "tt.h"
+
+#ifndef _WIN32
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+namespace Stockfish::DistTT {
+
+namespace Detail {
+std::atomic<bool> active{false};
+}
+
+#ifndef _WIN32
+
+namespace {
+
+// Everything a peer needs to reproduce a TTEntry. The cluster is assumed
+// homogeneous, so fields go on the wire in host byte order.
+struct Record {
+    u64 key;
+    u16 move;
+    i16 value;
+    i16 eval;
+    u8  depth;
+    u8  boundPv;  // bound in bits 0-1, pv flag in bit 2
+};
+
+static_assert(sizeof(Record) == 16, "Wire format is 16 bytes per record");
+
+constexpr usize     MaxBatch    = 256;   // records per frame
+constexpr usize     QueueMax    = 8192;  // publish() drops beyond this
+constexpr int       FlushMs     = 2;     // max batching delay per hop
+constexpr TimePoint RetryMs     = 2000;  // reconnect cadence
+constexpr u32       FrameMagic  = 0x53465454;  // "SFTT"
+
+// A frame is the magic, a record count, then count records back to back
+struct FrameHeader {
+    u32 magic;
+    u32 count;
+};
+
+std::mutex          queueMutex;
+std::vector<Record> queue;
+
+std::mutex          installMutex;  // serializes installs against InstallPause
+TranspositionTable* table = nullptr;
+
+std::thread       serviceThread;
+std::atomic<bool> stopFlag{false};
+
+// Set while the service thread is writing remote records into the local
+// table, so that those writes are not echoed back out through publish().
+thread_local bool installing = false;
+
+
+// The transport moves opaque frames between this host and its peers. TCP is
+// what we ship; an RDMA verbs transport only needs to implement this same
+// interface (broadcast maps naturally onto posted writes, receive onto
+// completion polling) and be returned from make_transport() instead.
+class Transport {
+   public:
+    virtual ~Transport() = default;
+
+    // Called from the service thread before the first broadcast/receive
+    virtual bool start(int listenPort, const std::vector<std::string>& peers) = 0;
+
+    // Sends one frame towards every reachable peer, dropping it on links
+    // that are down or backed up (fire and forget)
+    virtual void broadcast(const char* data, usize len) = 0;
+
+    // Waits up to timeoutMs for inbound data and hands complete frames of
+    // records to the sink. Also drives connection upkeep.
+    virtual void receive(int timeoutMs, void (*sink)(const Record*, usize)) = 0;
+
+    virtual void stop() = 0;
+};
+
+
+class TcpTransport: public Transport {
+
+    struct Link {
+        std::string       hostport;  // empty for accepted inbound links
+        int               fd          = -1;
+        bool              connecting  = false;
+        TimePoint         nextAttempt = 0;
+        std::vector<char> inbuf;
+    };
+
+    int               listenFd = -1;
+    std::vector<Link> links;
+
+    static void set_nonblocking(int fd) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK); }
+
+    static void close_link(Link& link) {
+        if (link.fd >= 0)
+            close(link.fd);
+        link.fd         = -1;
+        link.connecting = false;
+        link.nextAttempt = now() + RetryMs;
+        link.inbuf.clear();
+    }
+
+    // Begins a non-blocking connect; completion is detected in receive()
+    void try_connect(Link& link) {
+        auto colon = link.hostport.rfind(':');
+        if (colon == std::string::npos)
+            return;
+
+        std::string host = link.hostport.substr(0, colon);
+        std::string port = link.hostport.substr(colon + 1);
+
+        addrinfo hints{};
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo* res = nullptr;
+        if (getaddrinfo(host.c_str(), port.c_str(), &hints, &res) != 0 || !res)
+        {
+            link.nextAttempt = now() + RetryMs;
+            return;
+        }
+
+        int fd = socket(res->ai_family, SOCK_STREAM, 0);
+        if (fd >= 0)
+        {
+            set_nonblocking(fd);
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            int rc = ::connect(fd, res->ai_addr, socklen_t(res->ai_addrlen));
+            if (rc == 0 || errno == EINPROGRESS)
+            {
+                link.fd         = fd;
+                link.connecting = rc != 0;
+            }
+            else
+                close(fd);
+        }
+
+        link.nextAttempt = now() + RetryMs;
+        freeaddrinfo(res);
+    }
+
+    // Peels complete frames off the link's stream buffer
+    static void drain_frames(Link& link, void (*sink)(const Record*, usize)) {
+        usize offset = 0;
+        while (link.inbuf.size() - offset >= sizeof(FrameHeader))
+        {
+            FrameHeader hdr;
+            std::memcpy(&hdr, link.inbuf.data() + offset, sizeof(hdr));
+
+            if (hdr.magic != FrameMagic || hdr.count > MaxBatch)
+            {
+                close_link(link);  // stream is out of sync, start over
+                return;
+            }
+
+            usize frameLen = sizeof(FrameHeader) + hdr.count * sizeof(Record);
+            if (link.inbuf.size() - offset < frameLen)
+                break;
+
+            // The stream buffer has no alignment guarantee, so copy out
+            Record records[MaxBatch];
+            std::memcpy(records, link.inbuf.data() + offset + sizeof(hdr),
+                        hdr.count * sizeof(Record));
+            sink(records, hdr.count);
+
+            offset += frameLen;
+        }
+
+        if (offset)
+            link.inbuf.erase(link.inbuf.begin(), link.inbuf.begin() + std::ptrdiff_t(offset));
+    }
+
+   public:
+    bool start(int listenPort, const std::vector<std::string>& peers) override {
+
+        for (const std::string& p : peers)
+            links.push_back({p, -1, false, 0, {}});
+
+        if (listenPort <= 0)
+            return !links.empty();
+
+        listenFd = socket(AF_INET6, SOCK_STREAM, 0);
+        if (listenFd < 0)
+        {
+            // Fall back to IPv4-only hosts
+            listenFd = socket(AF_INET, SOCK_STREAM, 0);
+            if (listenFd < 0)
+                return false;
+
+            sockaddr_in addr{};
+            addr.sin_family      = AF_INET;
+            addr.sin_addr.s_addr = INADDR_ANY;
+            addr.sin_port        = htons(u16(listenPort));
+            if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+                return false;
+        }
+        else
+        {
+            int off = 0;
+            setsockopt(listenFd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+            int one = 1;
+            setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+            sockaddr_in6 addr{};
+            addr.sin6_family = AF_INET6;
+            addr.sin6_addr   = in6addr_any;
+            addr.sin6_port   = htons(u16(listenPort));
+            if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+                return false;
+        }
+
+        if (listen(listenFd, 8) != 0)
+            return false;
+
+        set_nonblocking(listenFd);
+        return true;
+    }
+
+    void broadcast(const char* data, usize len) override {
+
+        for (Link& link : links)
+        {
+            if (link.fd < 0 || link.connecting)
+                continue;
+
+            // A frame either goes out whole or is dropped; a short write
+            // would desynchronize the stream for the peer.
+            ssize_t n = send(link.fd, data, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+                close_link(link);
+            else if (n >= 0 && usize(n) != len)
+                close_link(link);
+        }
+    }
+
+    void receive(int timeoutMs, void (*sink)(const Record*, usize)) override {
+
+        TimePoint t = now();
+        for (Link& link : links)
+            if (link.fd < 0 && !link.hostport.empty() && t >= link.nextAttempt)
+                try_connect(link);
+
+        pollfd fds[64];
+        Link*  owners[64];
+        nfds_t n = 0;
+
+        if (listenFd >= 0)
+        {
+            fds[n]    = {listenFd, POLLIN, 0};
+            owners[n] = nullptr;
+            n++;
+        }
+
+        for (Link& link : links)
+            if (link.fd >= 0 && n < 64)
+            {
+                fds[n]    = {link.fd, short(POLLIN | (link.connecting ? POLLOUT : 0)), 0};
+                owners[n] = &link;
+                n++;
+            }
+
+        if (poll(fds, n, timeoutMs) <= 0)
+            return;
+
+        for (nfds_t i = 0; i < n; i++)
+        {
+            if (!fds[i].revents)
+                continue;
+
+            if (!owners[i])
+            {
+                int fd = accept(listenFd, nullptr, nullptr);
+                if (fd >= 0)
+                {
+                    set_nonblocking(fd);
+                    int one = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                    links.push_back({"", fd, false, 0, {}});
+                }
+                continue;
+            }
+
+            Link& link = *owners[i];
+
+            if (link.connecting && (fds[i].revents & (POLLOUT | POLLERR | POLLHUP)))
+            {
+                int       err = 0;
+                socklen_t len = sizeof(err);
+                getsockopt(link.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+                if (err)
+                {
+                    close_link(link);
+                    continue;
+                }
+                link.connecting = false;
+            }
+
+            if (fds[i].revents & POLLIN)
+            {
+                char    buf[4096];
+                ssize_t got = recv(link.fd, buf, sizeof(buf), 0);
+                if (got <= 0)
+                    close_link(link);
+                else
+                {
+                    link.inbuf.insert(link.inbuf.end(), buf, buf + got);
+                    drain_frames(link, sink);
+                }
+            }
+            else if (fds[i].revents & (POLLERR | POLLHUP))
+                close_link(link);
+        }
+
+        // Accepted links that died are of no further use
+        links.erase(std::remove_if(links.begin(), links.end(),
+                                   [](const Link& l) { return l.fd < 0 && l.hostport.empty(); }),
+                    links.end());
+    }
+
+    void stop() override {
+        for (Link& link : links)
+            if (link.fd >= 0)
+                close(link.fd);
+        links.clear();
+
+        if (listenFd >= 0)
+            close(listenFd);
+        listenFd = -1;
+    }
+};
+
+std::unique_ptr<Transport> make_transport() { return std::make_unique<TcpTransport>(); }
+
+
+// Writes a batch of remote records into the local table. The entries then
+// compete under the normal replacement policy, so a deep remote entry
+// displaces shallow local work exactly as a deep local entry would.
+void install(const Record* records, usize count) {
+
+    std::lock_guard lk(installMutex);
+
+    if (!table)
+        return;
+
+    installing = true;
+
+    for (usize i = 0; i < count; i++)
+    {
+        const Record& r = records[i];
+
+        Bound b = Bound(r.boundPv & 0x3);
+        if (b == BOUND_NONE || r.depth < MinShareDepth || r.depth >= MAX_PLY)
+            continue;
+
+        auto [ttHit, ttData, ttWriter] = table->probe(Key(r.key));
+        (void) ttHit, (void) ttData;
+
+        ttWriter.write(Key(r.key), Value(r.value), r.boundPv & 0x4, b, Depth(r.depth),
+                       Move(r.move), Value(r.eval), table->generation());
+    }
+
+    installing = false;
+}
+
+
+void service_loop(std::unique_ptr<Transport> transport) {
+
+    std::vector<Record> out;
+    char                frame[sizeof(FrameHeader) + MaxBatch * sizeof(Record)];
+
+    while (!stopFlag.load(std::memory_order_relaxed))
+    {
+        {
+            std::lock_guard lk(queueMutex);
+            queue.swap(out);
+        }
+
+        for (usize i = 0; i < out.size(); i += MaxBatch)
+        {
+            FrameHeader hdr{FrameMagic, u32(std::min(MaxBatch, out.size() - i))};
+            std::memcpy(frame, &hdr, sizeof(hdr));
+            std::memcpy(frame + sizeof(hdr), out.data() + i, hdr.count * sizeof(Record));
+            transport->broadcast(frame, sizeof(hdr) + hdr.count * sizeof(Record));
+        }
+        out.clear();
+
+        // Doubles as the batching delay, bounding how stale a peer can be
+        transport->receive(FlushMs, install);
+    }
+
+    transport->stop();
+}
+
+
+void stop_service() {
+
+    if (serviceThread.joinable())
+    {
+        stopFlag.store(true, std::memory_order_relaxed);
+        serviceThread.join();
+    }
+
+    Detail::active.store(false, std::memory_order_relaxed);
+    stopFlag.store(false, std::memory_order_relaxed);
+
+    std::lock_guard lk(installMutex);
+    table = nullptr;
+    queue.clear();
+}
+
+}  // namespace
+
+
+void publish(Key k, Value v, bool pv, Bound b, Depth d, Move m, Value ev) {
+
+    if (installing)
+        return;
+
+    // Never stall a search thread on the queue lock; a dropped record only
+    // costs a peer some re-search, like any other fire-and-forget loss.
+    std::unique_lock lk(queueMutex, std::try_to_lock);
+    if (!lk.owns_lock() || queue.size() >= QueueMax)
+        return;
+
+    queue.push_back({u64(k), m.raw(), i16(v), i16(ev), u8(d), u8(b | (pv << 2))});
+}
+
+
+std::string configure(TranspositionTable* tt, const std::string& spec) {
+
+    stop_service();
+
+    if (spec.empty())
+        return "Distributed TT disabled";
+
+    std::istringstream       is(spec);
+    std::string              token;
+    std::vector<std::string> peers;
+
+    is >> token;
+    int listenPort = std::atoi(token.c_str());
+
+    while (is >> token)
+        peers.push_back(token);
+
+    if (listenPort <= 0 && peers.empty())
+        return "Distributed TT: invalid spec '" + spec + "'";
+
+    auto transport = make_transport();
+    if (!transport->start(listenPort, peers))
+    {
+        transport->stop();
+        return "Distributed TT: failed to listen on port " + std::to_string(listenPort);
+    }
+
+    table = tt;
+    Detail::active.store(true, std::memory_order_relaxed);
+    serviceThread = std::thread(service_loop, std::move(transport));
+
+    return "Distributed TT enabled, " + std::to_string(peers.size()) + " peer(s), "
+         + (listenPort > 0 ? "listening on port " + std::to_string(listenPort) : "not listening");
+}
+
+
+void shutdown(const TranspositionTable* tt) {
+
+    bool bound;
+    {
+        std::lock_guard lk(installMutex);
+        bound = table == tt;
+    }
+
+    if (bound)
+        stop_service();
+}
+
+
+InstallPause::InstallPause() { installMutex.lock(); }
+InstallPause::~InstallPause() { installMutex.unlock(); }
+
+#else
+
+// The tier is POSIX only for now, like the prefork UCI server
+
+void publish(Key, Value, bool, Bound, Depth, Move, Value) {}
+
+std::string configure(TranspositionTable*, const std::string& spec) {
+    return spec.empty() ? "Distributed TT disabled" : "Distributed TT is not supported on Windows";
+}
+
+void shutdown(const TranspositionTable*) {}
+
+InstallPause::InstallPause() {}
+InstallPause::~InstallPause() {}
+
+#endif
+
+}  // namespace Stockfish::DistTT
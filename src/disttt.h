@@ -0,0 +1,84 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DISTTT_H_INCLUDED
+#define DISTTT_H_INCLUDED
+
+#include <atomic>
+#include <string>
+
+#include "types.h"
+
+namespace Stockfish {
+
+class TranspositionTable;
+
+// Distributed transposition-table tier. shm.h shares a table between
+// processes on one host; this module extends the idea across hosts for
+// workloads that run one search topic on a whole cluster.
+//
+// The local TranspositionTable stays the only synchronous tier: probes
+// never wait on the network. Instead, every locally written entry of at
+// least MinShareDepth is queued and asynchronously broadcast to the
+// configured peers (fire and forget: when the queue or a link is full,
+// records are dropped), and records received from peers are installed
+// into the local table by a background thread. High-value entries thus
+// appear on every host within the batching delay plus one network hop,
+// without putting remote latency on the probe path.
+namespace DistTT {
+
+// Only entries at least this deep are shared; shallower ones are
+// regenerated locally faster than they can cross the network.
+constexpr Depth MinShareDepth = 8;
+
+namespace Detail {
+extern std::atomic<bool> active;
+}
+
+// Cheap enough for the TT write path when the tier is disabled
+inline bool enabled() { return Detail::active.load(std::memory_order_relaxed); }
+
+// Queues a locally written entry for replication. Called from
+// TTWriter::write on the search threads; never blocks.
+void publish(Key k, Value v, bool pv, Bound b, Depth d, Move m, Value ev);
+
+// Starts the tier from a spec of the form
+//   "<listen-port> <host>:<port> <host>:<port> ..."
+// (every host lists all its peers), or stops it when the spec is empty.
+// Returns a printable status line. POSIX only; a no-op on Windows.
+std::string configure(TranspositionTable* tt, const std::string& spec);
+
+// Stops the tier if it is currently bound to this table. Called when the
+// owning engine goes away, so the service thread never outlives the table.
+void shutdown(const TranspositionTable* tt);
+
+// Holds remote installs off the table for the lifetime of the object.
+// Taken while the local table is being reshaped (resize).
+class InstallPause {
+   public:
+    InstallPause();
+    ~InstallPause();
+
+    InstallPause(const InstallPause&)            = delete;
+    InstallPause& operator=(const InstallPause&) = delete;
+};
+
+}  // namespace DistTT
+}  // namespace Stockfish
+
+#endif  // #ifndef DISTTT_H_INCLUDED
@@ -19,9 +19,11 @@
 #include "engine.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
-#include <deque>
+#include <fstream>
 #include <iosfwd>
+#include <istream>
 #include <memory>
 #include <ostream>
 #include <sstream>
@@ -29,8 +31,10 @@
 #include <utility>
 #include <vector>
 
+#include "disttt.h"
 #include "evaluate.h"
 #include "misc.h"
+#include "movegen.h"
 #include "nnue/network.h"
 #include "nnue/nnue_common.h"
 #include "nnue/nnue_misc.h"
@@ -60,10 +64,13 @@ constexpr NumaAutoPolicy DefaultNumaPolicy = BundledL3Policy{32};
 Engine::Engine(std::optional<std::string> path) :
     binaryDirectory(path ? CommandLine::get_binary_directory(*path) : ""),
     numaContext(NumaConfig::from_system(DefaultNumaPolicy)),
-    states(new std::deque<StateInfo>(1)),
+    states(new StateList(1)),
     threads(),
     network(numaContext, get_default_network()) {
 
+    // Safe to call once per Engine: it is per-process idempotent
+    CoarseClock::init();
+
     pos.set(StartFEN, false, &states->back());
 
     options.add(  //
@@ -85,30 +92,83 @@ Engine::Engine(std::optional<std::string> path) :
           return thread_allocation_information_as_string();
       }));
 
+    options.add(  //
+      "PCoreShare", Option(0, 0, 100, [this](const Option&) {
+          resize_threads();
+          return thread_allocation_information_as_string();
+      }));
+
     options.add(  //
       "Hash", Option(16, 1, MaxHashMB, [this](const Option& o) {
           set_tt_size(o);
           return std::nullopt;
       }));
 
+    options.add(  //
+      "SharedHistories", Option(false, [this](const Option& o) {
+          if (o)
+              sharedHistRegion = SystemWideSharedRegion<SharedHistoryRegion>("SharedHistories");
+          else
+              sharedHistRegion = SystemWideSharedRegion<SharedHistoryRegion>();
+          resize_threads();
+
+          if (!o)
+              return std::optional<std::string>(std::nullopt);
+          switch (sharedHistRegion.get_status())
+          {
+          case SystemWideSharedConstantAllocationStatus::SharedMemory :
+              return std::optional<std::string>("History tables shared between processes.");
+          case SystemWideSharedConstantAllocationStatus::LocalMemory :
+              return std::optional<std::string>(
+                "Shared memory unavailable, history tables are process-local.");
+          default :
+              return std::optional<std::string>("Failed to allocate shared history tables.");
+          }
+      }));
+
+    options.add(  //
+      "NumaShardedHash", Option(false, [this](const Option& o) {
+          tt.set_sharding(o);
+          set_tt_size(options["Hash"]);
+          return std::nullopt;
+      }));
+
+    options.add(  //
+      "DistributedTT", Option("", [this](const Option& o) {
+          return std::optional(DistTT::configure(&tt, o));
+      }));
+
     options.add(  //
       "Clear Hash", Option([this](const Option&) {
-          search_clear();
+          search_clear(true);
           return std::nullopt;
       }));
 
     options.add(  //
       "Ponder", Option(false));
 
+    options.add(  //
+      "MultiPonder", Option(false));
+
+    options.add(  //
+      "RootCoordination", Option(false));
+
     options.add(  //
       "MultiPV", Option(1, 1, MAX_MOVES));
 
+    options.add(  //
+      "ParallelMultiPV", Option(false));
+
     options.add("Skill Level", Option(20, 0, 20));
 
     options.add("Move Overhead", Option(10, 0, 5000));
 
     options.add("nodestime", Option(0, 0, 10000));
 
+    // Percentage of each history entry kept across ucinewgame; 0 resets the
+    // tables to their usual baselines instead of decaying them
+    options.add("History Retention", Option(0, 0, 90));
+
     options.add("UCI_Chess960", Option(false));
 
     options.add("UCI_LimitStrength", Option(false));
@@ -119,9 +179,21 @@ Engine::Engine(std::optional<std::string> path) :
 
     options.add("UCI_ShowWDL", Option(false));
 
+    // Solve "go mate N" with df-pn proof-number search instead of alpha-beta;
+    // proves or disproves the mate without establishing the exact distance
+    options.add("ProofNumberSearch", Option(false));
+
+    options.add(  //
+      "BookFile", Option("", [this](const Option& o) {
+          return std::optional(book.open(o));
+      }));
+
     options.add(  //
-      "SyzygyPath", Option("", [](const Option& o) {
-          Tablebases::init(o);
+      "BookBestMove", Option(true));
+
+    options.add(  //
+      "SyzygyPath", Option("", [this](const Option& o) {
+          Tablebases::init(o, &threads);
           return std::nullopt;
       }));
 
@@ -131,6 +203,30 @@ Engine::Engine(std::optional<std::string> path) :
 
     options.add("SyzygyProbeLimit", Option(7, 0, 7));
 
+    options.add(  //
+      "NodeScheduleFile", Option("", [this](const Option& o) {
+          threads.scheduleRecorder.set_file(o);
+          return std::nullopt;
+      }));
+
+    options.add(  //
+      "SyzygyPinLimit", Option(0, 0, 7, [](const Option& o) {
+          Tablebases::set_pin_limit(o);
+          return std::nullopt;
+      }));
+
+    options.add(  //
+      "SyzygyBlockCacheSize", Option(0, 0, 1024, [](const Option& o) {
+          Tablebases::set_block_cache_size(usize(int(o)));
+          return std::nullopt;
+      }));
+
+    options.add(  //
+      "SyzygyBitbases", Option("", [](const Option& o) {
+          Tablebases::set_bitbases(o);
+          return std::nullopt;
+      }));
+
     options.add(  //
       "EvalFile", Option(EvalFileDefaultName, [this](const Option& o) {
           load_network(o);
@@ -145,25 +241,80 @@ Engine::Engine(std::optional<std::string> path) :
 u64 Engine::perft(const std::string& fen, Depth depth, bool isChess960) {
     verify_network();
 
-    return Benchmark::perft(fen, depth, isChess960);
+    return Benchmark::perft(fen, depth, isChess960, threads);
 }
 
 void Engine::go(Search::LimitsType& limits) {
     assert(limits.perft == 0);
     verify_network();
 
+    widePondering = false;
+
+    // Answer book positions before any worker wakes up: the probe costs
+    // microseconds, while even a trivial search pays thread wakeup and TT
+    // traffic. Modes that must search (or must not answer yet) are excluded.
+    if (book.enabled() && !limits.ponderMode && !limits.infinite && !limits.mate
+        && limits.searchmoves.empty())
+        if (Move m = book.probe(pos, options["BookBestMove"]); m)
+        {
+            updateContext.onBestmove(UCIEngine::move(m, pos.is_chess960()), "");
+            return;
+        }
+
+    // With MultiPonder, ponder on the position before the predicted reply
+    // instead of after it: the speculative search then spreads its effort
+    // over every plausible opponent move, so a mispredicted reply still
+    // leaves a warm TT and warm histories. The real search is launched from
+    // set_ponderhit() when the prediction holds.
+    if (limits.ponderMode && options["MultiPonder"] && !lastPositionMoves.empty())
+    {
+        Position     specPos;
+        StateListPtr specStates(new StateList(1));
+        specPos.set(lastPositionFen, options["UCI_Chess960"], &specStates->back());
+
+        // Replay the setup moves except the predicted reply. They were
+        // already validated by set_position().
+        for (usize i = 0; i + 1 < lastPositionMoves.size(); ++i)
+        {
+            specStates->emplace_back();
+            specPos.do_move(UCIEngine::to_move(specPos, lastPositionMoves[i]),
+                            specStates->back());
+        }
+
+        if (!LazyLegalMoveList(specPos).empty())
+        {
+            widePonderLimits = limits;
+
+            auto specLimits = limits;
+            specLimits.searchmoves.clear();  // they name moves of the real position
+
+            widePondering = true;
+            threads.start_thinking(options, specPos, specStates, specLimits);
+            return;
+        }
+    }
+
     threads.start_thinking(options, pos, states, limits);
 }
 void Engine::stop() { threads.stop = true; }
 
-void Engine::search_clear() {
+void Engine::set_active_threads(usize n) { threads.set_active_threads(n); }
+
+usize Engine::active_threads() const { return threads.active_threads(); }
+
+usize Engine::num_threads() const { return threads.num_threads(); }
+
+void Engine::search_clear(bool fullTTClear) {
     wait_for_search_finished();
 
-    tt.clear(threads);
+    if (fullTTClear)
+        tt.clear(threads);
+    else
+        tt.soft_clear(threads);
     threads.clear();
 
     // @TODO wont work with multiple instances
-    Tablebases::init(options["SyzygyPath"]);  // Free mapped files
+    Tablebases::init(options["SyzygyPath"], &threads);  // Free mapped files
 }
 
 void Engine::set_on_update_no_moves(std::function<void(const Engine::InfoShort&)>&& f) {
@@ -179,34 +330,71 @@ void Engine::set_on_iter(std::function<void(const Engine::InfoIter&)>&& f) {
 }
 
 void Engine::set_on_bestmove(std::function<void(std::string_view, std::string_view)>&& f) {
-    updateContext.onBestmove = std::move(f);
+    updateContext.onBestmove = [this, f = std::move(f)](std::string_view bestmove,
+                                                        std::string_view ponderMove) {
+        // An aborted wide ponder reports a move for the pre-reply position;
+        // swallow it, the restarted search answers for the real one.
+        if (dropNextBestmove.exchange(false))
+            return;
+
+        f(bestmove, ponderMove);
+    };
 }
 
 void Engine::set_on_verify_network(std::function<void(std::string_view)>&& f) {
     onVerifyNetwork = std::move(f);
 }
 
-void Engine::wait_for_search_finished() { threads.main_thread()->wait_for_search_finished(); }
+void Engine::wait_for_search_finished() {
+    threads.abortIdle = true;
+    threads.main_thread()->wait_for_search_finished();
+}
 
 std::optional<PositionSetError> Engine::set_position(const std::string&              fen,
                                                      const std::vector<std::string>& moves) {
-    // Drop the old state and create a new one
-    states   = StateListPtr(new std::deque<StateInfo>(1));
-    auto err = pos.set(fen, options["UCI_Chess960"], &states->back());
-    if (err.has_value())
-        return err;
+    const bool chess960 = bool(options["UCI_Chess960"]);
+
+    // Fast path: with a supervisor driving the engine, nearly every position
+    // command extends the previous one by the moves just played. Recognize
+    // that and only play the new tail on the retained position, instead of
+    // re-parsing the FEN and replaying the whole game.
+    usize replayFrom = 0;
+    if (states != nullptr && chess960 == lastPositionChess960 && fen == lastPositionFen
+        && moves.size() >= lastPositionMoves.size()
+        && std::equal(lastPositionMoves.begin(), lastPositionMoves.end(), moves.begin()))
+        replayFrom = lastPositionMoves.size();
+    else
+    {
+        // Drop the old state and create a new one
+        states   = StateListPtr(new StateList(1));
+        auto err = pos.set(fen, chess960, &states->back());
+        if (err.has_value())
+        {
+            lastPositionFen.clear();
+            return err;
+        }
+    }
 
-    for (const auto& move : moves)
+    for (usize i = replayFrom; i < moves.size(); ++i)
     {
-        auto m = UCIEngine::to_move(pos, move);
+        auto m = UCIEngine::to_move(pos, moves[i]);
 
         if (m == Move::none())
-            return PositionSetError("Illegal move: " + move);
+        {
+            // The retained position no longer matches lastPositionMoves, so
+            // it must not seed another fast path.
+            lastPositionFen.clear();
+            return PositionSetError("Illegal move: " + moves[i]);
+        }
 
         states->emplace_back();
         pos.do_move(m, states->back());
     }
 
+    lastPositionFen      = fen;
+    lastPositionMoves    = moves;
+    lastPositionChess960 = chess960;
+
     return std::nullopt;
 }
 
@@ -226,6 +414,20 @@ void Engine::set_numa_config_from_option(const std::string& o) {
     {
         numaContext.set_numa_config(NumaConfig{});
     }
+    else if (o == "l3" || o.rfind("l3:", 0) == 0)
+    {
+        // Place and bind threads by cache domain (one logical node per L3,
+        // i.e. per CCX on chiplet parts), optionally bundling domains up to
+        // the given thread count: "l3" for plain domains, "l3:16" to bundle.
+        // Read-mostly replicated tables then get one copy per L3 domain, and
+        // workers sharing state are grouped under one cache. Replaces doing
+        // the same placement manually with taskset.
+        NumaAutoPolicy policy = L3DomainsPolicy{};
+        if (o.size() > 3)
+            policy = BundledL3Policy{str_to_size_t(o.substr(3))};
+
+        numaContext.set_numa_config(NumaConfig::from_system(policy, true, true));
+    }
     else
     {
         numaContext.set_numa_config(NumaConfig::from_string(o));
@@ -238,7 +440,8 @@ void Engine::set_numa_config_from_option(const std::string& o) {
 
 void Engine::resize_threads() {
     threads.wait_for_search_finished();
-    threads.set(numaContext.get_numa_config(), {options, threads, tt, sharedHists, network},
+    threads.set(numaContext.get_numa_config(),
+                {options, threads, tt, sharedHists, network, sharedHistRegion.get()},
                 updateContext);
 
     // Reallocate the hash with the new threadpool size
@@ -246,12 +449,251 @@ void Engine::resize_threads() {
     threads.ensure_network_replicated();
 }
 
+Engine::~Engine() {
+    wait_for_search_finished();
+    DistTT::shutdown(&tt);
+}
+
 void Engine::set_tt_size(usize mb) {
     wait_for_search_finished();
+
+    // Remote installs must not touch the table while it is reallocated
+    DistTT::InstallPause pause;
     tt.resize(mb, threads);
 }
 
-void Engine::set_ponderhit(bool b) { threads.main_manager()->ponder = b; }
+void Engine::set_ponderhit(bool b) {
+    // Promote a wide ponder: abort the speculative search of the pre-reply
+    // position and restart on the real one, which now runs against the TT
+    // and histories the speculation warmed up, whatever the opponent played.
+    if (!b && widePondering)
+    {
+        widePondering    = false;
+        dropNextBestmove = true;
+        threads.stop     = true;
+        wait_for_search_finished();
+
+        widePonderLimits.ponderMode = false;
+        widePonderLimits.startTime  = now();
+        threads.start_thinking(options, pos, states, widePonderLimits);
+        return;
+    }
+
+    threads.main_manager()->ponder = b;
+}
+
+bool Engine::save_hash(const std::string& path) {
+    wait_for_search_finished();
+    return tt.save(path);
+}
+
+bool Engine::load_hash(const std::string& path) {
+    wait_for_search_finished();
+    return tt.load(path);
+}
+
+// Search state snapshots. The layout is validated field by field on load, so
+// a snapshot taken with a different Threads setting (and thus differently
+// sized shared history tables) is rejected rather than misapplied, exactly
+// like a hash snapshot of mismatched geometry.
+
+namespace {
+
+struct SearchStateHeader {
+    static constexpr u32 SNAPSHOT_MAGIC = 0x53465253;  // "SFRS"
+
+    u32 magic;
+    u32 version;
+    Key positionKey;
+    u32 threadCount;
+    u32 groupCount;
+    u64 perWorkerBytes;
+    u32 rootMoveCount;
+};
+
+struct ManagerRecord {
+    i32    bestPreviousScore;
+    i32    bestPreviousAverageScore;
+    double previousTimeReduction;
+};
+
+struct RootEntryRecord {
+    u16 move;
+    i32 previousScore, averageScore, meanSquaredScore, uciScore;
+    i32 selDepth;
+    u8  previousScoreExact;
+    u16 pvLength;
+};
+
+// The per-thread history tables, serialized for every worker in pool order
+template<typename F>
+void for_each_worker_table(Search::Worker& w, F&& f) {
+    f(&w.mainHistory, sizeof(w.mainHistory));
+    f(&w.lowPlyHistory, sizeof(w.lowPlyHistory));
+    f(&w.captureHistory, sizeof(w.captureHistory));
+    f(&w.continuationCorrectionHistory, sizeof(w.continuationCorrectionHistory));
+    f(&w.ttMoveHistory, sizeof(w.ttMoveHistory));
+}
+
+usize worker_table_bytes(Search::Worker& w) {
+    usize total = 0;
+    for_each_worker_table(w, [&total](void*, usize bytes) { total += bytes; });
+    return total;
+}
+
+// The NUMA-node-shared history groups, each counted once
+std::vector<SharedHistories*> distinct_history_groups(ThreadPool& threads) {
+    std::vector<SharedHistories*> groups;
+    for (auto&& th : threads)
+    {
+        SharedHistories* g = &th->worker->sharedHistory;
+        if (std::find(groups.begin(), groups.end(), g) == groups.end())
+            groups.push_back(g);
+    }
+    return groups;
+}
+
+}  // namespace
+
+bool Engine::save_search_state(const std::string& path) {
+    wait_for_search_finished();
+
+    std::ofstream stream(path, std::ios_base::binary);
+    if (!stream)
+        return false;
+
+    Search::Worker& mainWorker = *threads.main_thread()->worker;
+
+    SearchStateHeader header{SearchStateHeader::SNAPSHOT_MAGIC,
+                             1,
+                             pos.key(),
+                             u32(threads.size()),
+                             u32(distinct_history_groups(threads).size()),
+                             worker_table_bytes(mainWorker),
+                             u32(mainWorker.rootMoves.size())};
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const auto*   mm = threads.main_manager();
+    ManagerRecord manager{mm->bestPreviousScore, mm->bestPreviousAverageScore,
+                          mm->previousTimeReduction};
+    stream.write(reinterpret_cast<const char*>(&manager), sizeof(manager));
+
+    for (const Search::RootMove& rm : mainWorker.rootMoves)
+    {
+        // Fold the score of the last completed search into previousScore, the
+        // slot a fresh search reads it back from.
+        const Value     prev = rm.score != -VALUE_INFINITE ? rm.score : rm.previousScore;
+        RootEntryRecord rec{rm.pv[0].raw(),      prev,
+                            rm.averageScore,     rm.meanSquaredScore,
+                            rm.uciScore,         rm.selDepth,
+                            u8(rm.previousScoreExact), u16(rm.pv.size())};
+        stream.write(reinterpret_cast<const char*>(&rec), sizeof(rec));
+        for (Move m : rm.pv)
+        {
+            u16 raw = m.raw();
+            stream.write(reinterpret_cast<const char*>(&raw), sizeof(raw));
+        }
+    }
+
+    for (auto&& th : threads)
+        for_each_worker_table(*th->worker, [&stream](void* table, usize bytes) {
+            stream.write(reinterpret_cast<const char*>(table), std::streamsize(bytes));
+        });
+
+    for (SharedHistories* g : distinct_history_groups(threads))
+    {
+        u64 sizes[3] = {g->correctionHistory.get_size() * sizeof(g->correctionHistory[0]),
+                        g->pawnHistory.get_size() * sizeof(g->pawnHistory[0]),
+                        sizeof(g->continuationHistory)};
+        stream.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+        stream.write(reinterpret_cast<const char*>(&g->correctionHistory[0]),
+                     std::streamsize(sizes[0]));
+        stream.write(reinterpret_cast<const char*>(&g->pawnHistory[0]), std::streamsize(sizes[1]));
+        stream.write(reinterpret_cast<const char*>(&g->continuationHistory), std::streamsize(sizes[2]));
+    }
+
+    return bool(stream);
+}
+
+bool Engine::load_search_state(const std::string& path) {
+    wait_for_search_finished();
+
+    std::ifstream stream(path, std::ios_base::binary);
+    if (!stream)
+        return false;
+
+    Search::Worker& mainWorker = *threads.main_thread()->worker;
+
+    SearchStateHeader header;
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!stream || header.magic != SearchStateHeader::SNAPSHOT_MAGIC || header.version != 1
+        || header.threadCount != threads.size()
+        || header.groupCount != distinct_history_groups(threads).size()
+        || header.perWorkerBytes != worker_table_bytes(mainWorker))
+        return false;
+
+    ManagerRecord manager;
+    stream.read(reinterpret_cast<char*>(&manager), sizeof(manager));
+
+    auto seed         = std::make_unique<Search::RootResumeSeed>();
+    seed->positionKey = header.positionKey;
+    seed->entries.reserve(header.rootMoveCount);
+
+    for (u32 i = 0; i < header.rootMoveCount; ++i)
+    {
+        RootEntryRecord rec;
+        stream.read(reinterpret_cast<char*>(&rec), sizeof(rec));
+        if (!stream || rec.pvLength > MAX_PLY + 1)
+            return false;
+
+        Search::RootResumeSeed::Entry e{Move(rec.move),
+                                        Value(rec.previousScore),
+                                        Value(rec.averageScore),
+                                        Value(rec.meanSquaredScore),
+                                        Value(rec.uciScore),
+                                        bool(rec.previousScoreExact),
+                                        int(rec.selDepth),
+                                        {}};
+        for (u16 j = 0; j < rec.pvLength; ++j)
+        {
+            u16 raw;
+            stream.read(reinterpret_cast<char*>(&raw), sizeof(raw));
+            e.previousPV.push_back(Move(raw));
+        }
+        seed->entries.push_back(e);
+    }
+
+    for (auto&& th : threads)
+        for_each_worker_table(*th->worker, [&stream](void* table, usize bytes) {
+            stream.read(reinterpret_cast<char*>(table), std::streamsize(bytes));
+        });
+
+    for (SharedHistories* g : distinct_history_groups(threads))
+    {
+        u64 expected[3] = {g->correctionHistory.get_size() * sizeof(g->correctionHistory[0]),
+                           g->pawnHistory.get_size() * sizeof(g->pawnHistory[0]),
+                           sizeof(g->continuationHistory)};
+        u64 sizes[3];
+        stream.read(reinterpret_cast<char*>(sizes), sizeof(sizes));
+        if (!stream || sizes[0] != expected[0] || sizes[1] != expected[1]
+            || sizes[2] != expected[2])
+            return false;
+
+        stream.read(reinterpret_cast<char*>(&g->correctionHistory[0]), std::streamsize(sizes[0]));
+        stream.read(reinterpret_cast<char*>(&g->pawnHistory[0]), std::streamsize(sizes[1]));
+        stream.read(reinterpret_cast<char*>(&g->continuationHistory), std::streamsize(sizes[2]));
+    }
+
+    if (!stream)
+        return false;
+
+    threads.main_manager()->bestPreviousScore        = Value(manager.bestPreviousScore);
+    threads.main_manager()->bestPreviousAverageScore = Value(manager.bestPreviousAverageScore);
+    threads.main_manager()->previousTimeReduction    = manager.previousTimeReduction;
+
+    threads.resumeSeed = std::move(seed);
+    return true;
+}
 
 // network related
 
@@ -311,8 +753,65 @@ void Engine::save_network(const std::pair<std::optional<std::string>, std::strin
 
 // utility functions
 
+void Engine::evaluate_fens(std::istream& is, std::ostream& os) const {
+    verify_network();
+
+    // One stack and cache instance amortized over the whole batch; positions
+    // are independent, so the stack is reset rather than pushed per position.
+    auto accumulators = std::make_unique<Eval::NNUE::AccumulatorStack>();
+    auto caches       = std::make_unique<Eval::NNUE::AccumulatorCaches>(*network);
+
+    // Group positions so the batched inference can amortize output-layer
+    // weight loads; the batch size only needs to exceed the layer-stack
+    // bucket count by enough to make the grouping effective.
+    constexpr usize BatchSize = 64;
+
+    std::ostringstream                     buffer;
+    std::array<Position, BatchSize>        positions;
+    std::array<StateInfo, BatchSize>       stateInfos;
+    std::array<const Position*, BatchSize> batch;
+    std::array<Value, BatchSize>           values;
+    std::array<bool, BatchSize>            valid;  // false for unparsable FENs and checks
+
+    bool more = true;
+    while (more)
+    {
+        usize lines = 0, count = 0;
+        for (std::string fen; lines < BatchSize && (more = bool(std::getline(is, fen)));)
+        {
+            if (fen.empty())
+                continue;
+
+            Position& p  = positions[lines];
+            valid[lines] = !p.set(fen, options["UCI_Chess960"], &stateInfos[lines]).has_value()
+                        && !p.checkers();
+            if (valid[lines])
+                batch[count++] = &p;
+            ++lines;
+        }
+
+        if (count)
+            Eval::evaluate_batch(*network, batch.data(), count, *accumulators, *caches,
+                                 values.data());
+
+        for (usize i = 0, v = 0; i < lines; ++i)
+        {
+            if (valid[i])
+            {
+                buffer << UCIEngine::to_cp(values[v], *batch[v]) << "\n";
+                ++v;
+            }
+            else
+                buffer << "none\n";
+        }
+    }
+
+    // Single buffered write, the per-line flushes would otherwise dominate
+    os << buffer.str() << std::flush;
+}
+
 void Engine::trace_eval() const {
-    StateListPtr trace_states(new std::deque<StateInfo>(1));
+    StateListPtr trace_states(new StateList(1));
     Position     p;
     p.set(pos.fen(), options["UCI_Chess960"], &trace_states->back());
 
@@ -326,7 +825,12 @@ OptionsMap&       Engine::get_options() { return options; }
 
 std::string Engine::fen() const { return pos.fen(); }
 
-void Engine::flip() { pos.flip(); }
+void Engine::flip() {
+    pos.flip();
+    // The retained position no longer matches the last position command, so
+    // it must not seed the set_position() fast path.
+    lastPositionFen.clear();
+}
 
 std::string Engine::visualize() const {
     std::stringstream ss;
@@ -336,6 +840,8 @@ std::string Engine::visualize() const {
 
 int Engine::get_hashfull(int maxAge) const { return tt.hashfull(maxAge); }
 
+u64 Engine::nodes_searched() const { return threads.nodes_searched(); }
+
 std::vector<std::pair<usize, usize>> Engine::get_bound_thread_count_by_numa_node() const {
     auto                                 counts = threads.get_bound_thread_count_by_numa_node();
     const NumaConfig&                    cfg    = numaContext.get_numa_config();
@@ -19,7 +19,9 @@
 #ifndef ENGINE_H_INCLUDED
 #define ENGINE_H_INCLUDED
 
+#include <atomic>
 #include <functional>
+#include <iosfwd>
 #include <map>
 #include <memory>
 #include <optional>
@@ -28,6 +30,7 @@
 #include <utility>
 #include <vector>
 
+#include "book.h"
 #include "misc.h"
 #include "history.h"
 #include "nnue/network.h"
@@ -55,7 +58,7 @@ class Engine {
     Engine& operator=(const Engine&) = delete;
     Engine& operator=(Engine&&)      = delete;
 
-    ~Engine() { wait_for_search_finished(); }
+    ~Engine();
 
     u64 perft(const std::string& fen, Depth depth, bool isChess960);
 
@@ -64,6 +67,13 @@ class Engine {
     // non blocking call to stop searching
     void stop();
 
+    // Elastic thread sizing: cap how many pool threads may search, parking
+    // the rest with their state intact. Safe to call mid-search; 0 activates
+    // every thread. See ThreadPool::set_active_threads.
+    void  set_active_threads(usize n);
+    usize active_threads() const;
+    usize num_threads() const;
+
     // blocking call to wait for search to finish
     void wait_for_search_finished();
     // set a new position, moves are in UCI format
@@ -76,7 +86,21 @@ class Engine {
     void resize_threads();
     void set_tt_size(usize mb);
     void set_ponderhit(bool);
-    void search_clear();
+    // By default the TT is only soft-cleared (see TranspositionTable::
+    // soft_clear); pass true for the full parallel clear, as the Clear Hash
+    // button does.
+    void search_clear(bool fullTTClear = false);
+
+    // transposition table snapshots, for warm restarts across processes
+    bool save_hash(const std::string& path);
+    bool load_hash(const std::string& path);
+
+    // Search state snapshots, complementing save_hash/load_hash: history
+    // tables, root move statistics and aspiration state, so a long analysis
+    // survives a process restart. Loading requires the same Threads setting;
+    // the root statistics apply to the next 'go' for the saved position.
+    bool save_search_state(const std::string& path);
+    bool load_search_state(const std::string& path);
 
     void set_on_update_no_moves(std::function<void(const InfoShort&)>&&);
     void set_on_update_full(std::function<void(const InfoFull&)>&&);
@@ -95,11 +119,21 @@ class Engine {
 
     void trace_eval() const;
 
+    // Statically evaluates a stream of FENs, one per line, writing one score
+    // (in centipawns, from the side to move) per line to the output. A single
+    // set of accumulator caches is reused across positions, which makes this
+    // far cheaper than one position/eval round-trip per FEN.
+    void evaluate_fens(std::istream& is, std::ostream& os) const;
+
     const OptionsMap& get_options() const;
     OptionsMap&       get_options();
 
     int get_hashfull(int maxAge = 0) const;
 
+    // Nodes searched by the whole pool since the last 'go'; the session
+    // scheduler sums these per slice into per-session totals
+    u64 nodes_searched() const;
+
     std::string                          fen() const;
     void                                 flip();
     std::string                          visualize() const;
@@ -118,13 +152,26 @@ class Engine {
     StateListPtr states;
 
     OptionsMap                                        options;
+    Book                                              book;
     ThreadPool                                        threads;
     TranspositionTable                                tt;
     LazyNumaReplicatedSystemWide<Eval::NNUE::Network> network;
 
     Search::SearchManager::UpdateContext  updateContext;
     std::function<void(std::string_view)> onVerifyNetwork;
+
+    // Wide-ponder bookkeeping (see Engine::go() and Engine::set_ponderhit())
+    // and the incremental set_position() fast path
+    std::string              lastPositionFen;
+    std::vector<std::string> lastPositionMoves;
+    bool                     lastPositionChess960 = false;
+    Search::LimitsType       widePonderLimits;
+    bool                     widePondering = false;
+    std::atomic<bool>        dropNextBestmove{false};
+
     std::map<NumaIndex, SharedHistories>  sharedHists;
+    // Allocated only when the SharedHistories option is enabled
+    SystemWideSharedRegion<SharedHistoryRegion> sharedHistRegion;
 };
 
 }  // namespace Stockfish
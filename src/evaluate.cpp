@@ -26,27 +26,21 @@
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include "nnue/network.h"
 #include "nnue/nnue_misc.h"
 #include "position.h"
+#include "profile.h"
 #include "types.h"
 #include "uci.h"
 #include "nnue/nnue_accumulator.h"
 
 namespace Stockfish {
 
-// Evaluate is the evaluator for the outer world. It returns a static evaluation
-// of the position from the point of view of the side to move.
-Value Eval::evaluate(const Eval::NNUE::Network&     network,
-                     const Position&                pos,
-                     Eval::NNUE::AccumulatorStack&  accumulators,
-                     Eval::NNUE::AccumulatorCaches& caches,
-                     int                            optimism) {
-
-    assert(!pos.checkers());
-
-    auto [psqt, positional] = network.evaluate(pos, accumulators, caches);
+// Combines the raw network outputs with optimism and material into the final
+// static evaluation. Shared between the single-position and batch paths.
+static Value blend_nnue(const Position& pos, Value psqt, Value positional, int optimism) {
 
     Value nnue = psqt + positional;
 
@@ -67,6 +61,63 @@ Value Eval::evaluate(const Eval::NNUE::Network&     network,
     return v;
 }
 
+// Evaluate is the evaluator for the outer world. It returns a static evaluation
+// of the position from the point of view of the side to move.
+// How far outside the window the PSQT-only estimate must land before the full
+// network is skipped. Generous on purpose: the PSQT half alone can be off by
+// a few pawns, and the margin is what bounds the accuracy risk of tiering.
+static constexpr Value FirstTierMargin = 900;
+
+Value Eval::evaluate(const Eval::NNUE::Network&     network,
+                     const Position&                pos,
+                     Eval::NNUE::AccumulatorStack&  accumulators,
+                     Eval::NNUE::AccumulatorCaches& caches,
+                     int                            optimism,
+                     Value                          alpha,
+                     Value                          beta) {
+
+    assert(!pos.checkers());
+
+    PROFILE_SCOPE(Eval);
+
+    // First tier: the PSQT half of the network comes straight out of the
+    // (incrementally maintained) accumulator, so reading it skips both the
+    // clipped-ReLU output transform and the layer-stack propagation. When the
+    // cheap estimate is outside the window by more than the margin, the
+    // positional term cannot change the pruning decision the caller derives
+    // from this evaluation, and the full network is not run. The accumulator
+    // update is shared, so a failed tier test costs almost nothing.
+    if (alpha > -VALUE_INFINITE || beta < VALUE_INFINITE)
+    {
+        Value psqt = network.evaluate_psqt(pos, accumulators, caches);
+        Value v    = blend_nnue(pos, psqt, VALUE_ZERO, optimism);
+
+        if (v - FirstTierMargin >= beta || v + FirstTierMargin <= alpha)
+            return v;
+    }
+
+    auto [psqt, positional] = network.evaluate(pos, accumulators, caches);
+
+    return blend_nnue(pos, psqt, positional, optimism);
+}
+
+void Eval::evaluate_batch(const Eval::NNUE::Network&     network,
+                          const Position* const*         positions,
+                          usize                          count,
+                          Eval::NNUE::AccumulatorStack&  accumulators,
+                          Eval::NNUE::AccumulatorCaches& caches,
+                          Value*                         values) {
+
+    std::vector<NNUE::NetworkOutput> outputs(count);
+    network.evaluate_batch(positions, count, accumulators, caches, outputs.data());
+
+    for (usize i = 0; i < count; ++i)
+    {
+        auto [psqt, positional] = outputs[i];
+        values[i]               = blend_nnue(*positions[i], psqt, positional, VALUE_ZERO);
+    }
+}
+
 // Like evaluate(), but instead of returning a value, it returns
 // a string (suitable for outputting to stdout) that contains the detailed
 // descriptions and values of each evaluation term. Useful for debugging.
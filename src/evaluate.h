@@ -43,11 +43,28 @@ class AccumulatorStack;
 
 std::string trace(Position& pos, const Eval::NNUE::Network& network);
 
+// When the caller provides an (alpha, beta) window, evaluation is tiered: the
+// PSQT half of the network alone gives a cheap estimate first, and if that
+// estimate is outside the window by more than a confidence margin the full
+// layer-stack propagation is skipped. Callers that need an exact evaluation
+// simply leave the window unbounded.
 Value evaluate(const NNUE::Network&           network,
                const Position&                pos,
                Eval::NNUE::AccumulatorStack&  accumulators,
                Eval::NNUE::AccumulatorCaches& caches,
-               int                            optimism);
+               int                            optimism,
+               Value                          alpha = -VALUE_INFINITE,
+               Value                          beta  = VALUE_INFINITE);
+
+// Batch counterpart of evaluate() for throughput-oriented workloads (dataset
+// scoring). Runs the batched NNUE inference and writes one score per position
+// to values[0..count), with zero optimism.
+void evaluate_batch(const NNUE::Network&           network,
+                    const Position* const*         positions,
+                    usize                          count,
+                    Eval::NNUE::AccumulatorStack&  accumulators,
+                    Eval::NNUE::AccumulatorCaches& caches,
+                    Value*                         values);
 }  // namespace Eval
 
 }  // namespace Stockfish
@@ -0,0 +1,128 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "history.h"
+
+#if defined(USE_AVX2) || defined(USE_SSSE3) || defined(USE_SSE2)
+    #include <immintrin.h>
+#endif
+
+// Bulk kernels over the raw payload of the history tables, see history.h.
+// The tables span tens of MB at large thread counts, so the ucinewgame reset
+// is bandwidth-bound: these kernels run at streaming-store speed instead of
+// one entry per iteration through the StatsEntry accessors. Non-x86 builds
+// fall back to plain loops, which the compiler vectorizes well enough.
+
+namespace Stockfish::HistoryKernels {
+
+void fill_i16(i16* dst, usize count, i16 value) {
+
+    usize i = 0;
+
+#if defined(USE_AVX2)
+    const __m256i v = _mm256_set1_epi16(value);
+    for (usize n = count - count % 16; i < n; i += 16)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+#elif defined(USE_SSE2)
+    const __m128i v = _mm_set1_epi16(value);
+    for (usize n = count - count % 8; i < n; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+#endif
+
+    for (; i < count; ++i)
+        dst[i] = value;
+}
+
+void fill_i8(i8* dst, usize count, i8 value) {
+
+    usize i = 0;
+
+#if defined(USE_AVX2)
+    const __m256i v = _mm256_set1_epi8(value);
+    for (usize n = count - count % 32; i < n; i += 32)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+#elif defined(USE_SSE2)
+    const __m128i v = _mm_set1_epi8(value);
+    for (usize n = count - count % 16; i < n; i += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+#endif
+
+    for (; i < count; ++i)
+        dst[i] = value;
+}
+
+void decay_i16(i16* dst, usize count, int keep) {
+
+    assert(0 < keep && keep < 256);
+
+    usize i = 0;
+
+    // mulhrs computes (v * k + 2^14) >> 15, so k = keep << 7 yields
+    // round-to-nearest of v * keep / 256; decay_value is the scalar twin
+#if defined(USE_AVX2)
+    const __m256i k = _mm256_set1_epi16(i16(keep << 7));
+    for (usize n = count - count % 16; i < n; i += 16)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_mulhrs_epi16(v, k));
+    }
+#elif defined(USE_SSSE3)
+    const __m128i k = _mm_set1_epi16(i16(keep << 7));
+    for (usize n = count - count % 8; i < n; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_mulhrs_epi16(v, k));
+    }
+#endif
+
+    for (; i < count; ++i)
+        dst[i] = i16(decay_value(dst[i], keep));
+}
+
+void requantize_i8(i8* dst, const i16* src, usize count, int shift) {
+
+    usize i = 0;
+
+    // The sources are bounded by their update limit D, so src >> shift fits
+    // an i8 by construction of QuantShift and the pack never saturates
+#if defined(USE_AVX2)
+    for (usize n = count - count % 32; i < n; i += 32)
+    {
+        const __m256i a =
+          _mm256_srai_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), shift);
+        const __m256i b = _mm256_srai_epi16(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16)), shift);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), 0b11011000));
+    }
+#elif defined(USE_SSE2)
+    for (usize n = count - count % 16; i < n; i += 16)
+    {
+        const __m128i a =
+          _mm_srai_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), shift);
+        const __m128i b =
+          _mm_srai_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8)), shift);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi16(a, b));
+    }
+#endif
+
+    for (; i < count; ++i)
+        dst[i] = i8(src[i] >> shift);
+}
+
+}  // namespace Stockfish::HistoryKernels
@@ -85,6 +85,65 @@ using Stats = MultiArray<StatsEntry<T, D>, Sizes...>;
 template<typename T, int D, usize... Sizes>
 using AtomicStats = MultiArray<StatsEntry<T, D, true>, Sizes...>;
 
+// Bulk SIMD kernels (history.cpp) over the raw integer payload of the
+// tables. They are only used while the tables are quiesced - every worker is
+// inside its clear job - so the relaxed atomic entries may be treated as
+// plain integers.
+namespace HistoryKernels {
+
+void fill_i16(i16* dst, usize count, i16 value);
+void fill_i8(i8* dst, usize count, i8 value);
+
+// v <- v * keep / 256 rounded to nearest, for keep in (0, 256). Repeated
+// decay drives entries to within one count of zero (the round-half-up can
+// leave a +1 residue) and preserves relative ordering throughout.
+void decay_i16(i16* dst, usize count, int keep);
+
+// dst[i] <- i8(src[i] >> shift), refreshing a quantized mirror
+void requantize_i8(i8* dst, const i16* src, usize count, int shift);
+
+// Scalar twin of the decay_i16 kernel, for lone entries
+inline int decay_value(int v, int keep) { return ((v * (keep << 7) >> 14) + 1) >> 1; }
+
+}
+
+// Blanket fill/decay over any table that is a dense array of 2-byte entries
+// (Stats, AtomicStats, CorrectionBundle aggregates). Tables with an i8
+// mirror go through their own fill()/decay() instead.
+template<typename Table>
+void stats_fill(Table& table, int value) {
+    static_assert(sizeof(Table) % sizeof(i16) == 0);
+    HistoryKernels::fill_i16(reinterpret_cast<i16*>(&table), sizeof(Table) / sizeof(i16),
+                             i16(value));
+}
+
+template<typename Table>
+void stats_decay(Table& table, int keep) {
+    static_assert(sizeof(Table) % sizeof(i16) == 0);
+    HistoryKernels::decay_i16(reinterpret_cast<i16*>(&table), sizeof(Table) / sizeof(i16), keep);
+}
+
+template<int D>
+struct PackedPieceToStats;
+
+// Per-element dispatch for the DynStats range walks below
+template<typename T>
+inline void fill_entry(T& e, int value) {
+    stats_fill(e, value);
+}
+template<typename T>
+inline void decay_entry(T& e, int keep) {
+    stats_decay(e, keep);
+}
+template<int D>
+inline void fill_entry(PackedPieceToStats<D>& e, int value) {
+    e.fill(value);
+}
+template<int D>
+inline void decay_entry(PackedPieceToStats<D>& e, int keep) {
+    e.decay(keep);
+}
+
 // DynStats is a dynamically sized array of Stats, used for thread-shared histories
 // which should scale with the total number of threads. The SizeMultiplier gives
 // the per-thread allocation count of T.
@@ -93,7 +152,13 @@ struct DynStats {
     explicit DynStats(usize s) {
         size = s * SizeMultiplier;
         data = make_unique_large_page<T[]>(size);
+        ptr  = data.get();
     }
+    // Attaches to externally owned storage (e.g. a cross-process shared memory
+    // region) instead of allocating. The storage must outlive this object.
+    DynStats(T* external, usize s) :
+        size(s * SizeMultiplier),
+        ptr(external) {}
     // Sets all values in the range to 0
     void clear_range(int value, usize threadIdx, usize numaTotal) {
         usize start = u64(threadIdx) * size / numaTotal;
@@ -101,21 +166,33 @@ struct DynStats {
         usize end = threadIdx + 1 == numaTotal ? size : u64(threadIdx + 1) * size / numaTotal;
 
         while (start < end)
-            data[start++].fill(value);
+            fill_entry(ptr[start++], value);
+    }
+    // Multiplicative counterpart of clear_range: every entry in the range
+    // keeps keep/256 of its value, preserving the learned move ordering
+    // between related games
+    void decay_range(int keep, usize threadIdx, usize numaTotal) {
+        usize start = u64(threadIdx) * size / numaTotal;
+        assert(start < size);
+        usize end = threadIdx + 1 == numaTotal ? size : u64(threadIdx + 1) * size / numaTotal;
+
+        while (start < end)
+            decay_entry(ptr[start++], keep);
     }
     usize get_size() const { return size; }
     T&    operator[](usize index) {
         assert(index < size);
-        return data.get()[index];
+        return ptr[index];
     }
     const T& operator[](usize index) const {
         assert(index < size);
-        return data.get()[index];
+        return ptr[index];
     }
 
    private:
     usize             size;
-    LargePagePtr<T[]> data;
+    LargePagePtr<T[]> data;  // empty when attached to external storage
+    T*                ptr;
 };
 
 // ButterflyHistory records how often quiet moves have been successful or unsuccessful
@@ -131,8 +208,87 @@ using LowPlyHistory = Stats<i16, 7183, LOW_PLY_HISTORY_SIZE, UINT_16_HISTORY_SIZ
 // CapturePieceToHistory is addressed by a move's [piece][to][captured piece type]
 using CapturePieceToHistory = Stats<i16, 10692, PIECE_NB, SQUARE_NB, PIECE_TYPE_NB>;
 
+// PackedPieceToStats is a [piece][to] statistics table with a cache-friendly
+// split personality: the full-precision i16 entries stay authoritative and
+// keep the exact bounded-update dynamics, while an interleaved 8-bit mirror
+// packs all 64 destination squares of a piece into a single cache line. The
+// read-heavy move scoring in movepick.cpp consults only the mirror, halving
+// the table footprint it drags through the cache hierarchy; updates refresh
+// both. The mirror precedes the full table so that the 3-byte overread of the
+// vectorized dword gathers stays inside the struct.
+template<int D>
+struct PackedPieceToStats {
+
+    // Smallest shift mapping the update range [-D, D] into the 8-bit mirror
+    static constexpr int QuantShift = []() {
+        int s = 0;
+        while ((D >> s) > int(std::numeric_limits<i8>::max()))
+            ++s;
+        return s;
+    }();
+
+    // Proxy returned for a concrete [piece][to] slot, so existing call sites
+    // keep the StatsEntry look and feel while updates refresh the mirror
+    struct EntryRef {
+        StatsEntry<i16, D, true>& full;
+        RelaxedAtomic<i8>&        mirror;
+
+        operator int() const { return i16(full); }
+
+        void operator<<(int bonus) {
+            full << bonus;
+            mirror = i8(i16(full) >> QuantShift);
+        }
+    };
+
+    struct RowRef {
+        PackedPieceToStats& table;
+        Piece               pc;
+
+        EntryRef operator[](Square to) { return {table.full[pc][to], table.mirror[pc][to]}; }
+    };
+
+    struct ConstRowRef {
+        const PackedPieceToStats& table;
+        Piece                     pc;
+
+        // Full-precision read
+        int operator[](Square to) const { return i16(table.full[pc][to]); }
+    };
+
+    RowRef      operator[](Piece pc) { return {*this, pc}; }
+    ConstRowRef operator[](Piece pc) const { return {*this, pc}; }
+
+    // Quantized read used by move scoring: one mirror row per piece, one line
+    int read(Piece pc, Square to) const { return int(i8(mirror[pc][to])) << QuantShift; }
+
+    const void* read_addr(Piece pc, Square to) const { return &mirror[pc][to]; }
+    const i8*   mirror_data() const { return reinterpret_cast<const i8*>(&mirror[0][0]); }
+
+    void fill(int v) {
+        static_assert(sizeof(full) == sizeof(i16) * PIECE_NB * SQUARE_NB
+                        && sizeof(mirror) == sizeof(i8) * PIECE_NB * SQUARE_NB,
+                      "Kernels assume a dense payload");
+        HistoryKernels::fill_i16(reinterpret_cast<i16*>(&full), PIECE_NB * SQUARE_NB, i16(v));
+        HistoryKernels::fill_i8(reinterpret_cast<i8*>(&mirror), PIECE_NB * SQUARE_NB,
+                                i8(v >> QuantShift));
+    }
+
+    // Multiplicative decay: scale the full-precision entries, then requantize
+    // the mirror from them so the two views stay consistent
+    void decay(int keep) {
+        HistoryKernels::decay_i16(reinterpret_cast<i16*>(&full), PIECE_NB * SQUARE_NB, keep);
+        HistoryKernels::requantize_i8(reinterpret_cast<i8*>(&mirror),
+                                      reinterpret_cast<const i16*>(&full), PIECE_NB * SQUARE_NB,
+                                      QuantShift);
+    }
+
+    alignas(64) MultiArray<RelaxedAtomic<i8>, PIECE_NB, SQUARE_NB> mirror;
+    AtomicStats<i16, D, PIECE_NB, SQUARE_NB> full;
+};
+
 // PieceToHistory is like ButterflyHistory but is addressed by a move's [piece][to]
-using PieceToHistory = AtomicStats<i16, 30000, PIECE_NB, SQUARE_NB>;
+using PieceToHistory = PackedPieceToStats<30000>;
 
 // ContinuationHistory is the combined history of a given pair of moves, usually
 // the current one given a previous one. The nested history table is based on
@@ -140,7 +296,7 @@ using PieceToHistory = AtomicStats<i16, 30000, PIECE_NB, SQUARE_NB>;
 using ContinuationHistory = MultiArray<PieceToHistory, PIECE_NB, SQUARE_NB>;
 
 // PawnHistory is addressed by the pawn structure and a move's [piece][to]
-using PawnHistory = DynStats<AtomicStats<i16, 8192, PIECE_NB, SQUARE_NB>, PAWN_HISTORY_BASE_SIZE>;
+using PawnHistory = DynStats<PackedPieceToStats<8192>, PAWN_HISTORY_BASE_SIZE>;
 
 // Correction histories record differences between the static evaluation of
 // positions and their search score. It is used to improve the static evaluation
@@ -192,6 +348,18 @@ using CorrectionHistory = typename Detail::CorrHistTypedef<T>::type;
 
 using TTMoveHistory = StatsEntry<i16, 8192>;
 
+// Fixed-size storage for the cross-process shared history mode, sized as for a
+// single thread (the base table sizes). It lives in a SystemWideSharedRegion,
+// so it must be value-initializable and trivially destructible; updates go
+// through the same relaxed atomics as the in-process shared histories.
+struct SharedHistoryRegion {
+    using PawnSlot       = PackedPieceToStats<8192>;
+    using CorrectionSlot = MultiArray<CorrectionBundle<i16, CORRECTION_HISTORY_LIMIT>, COLOR_NB>;
+
+    PawnSlot       pawnHistory[PAWN_HISTORY_BASE_SIZE];
+    CorrectionSlot correctionHistory[CORRHIST_BASE_SIZE];
+};
+
 // Set of histories shared between groups of threads. To avoid excessive
 // cross-node data transfer, histories are shared only between threads
 // on a given NUMA node. The passed size must be a power of two to make
@@ -205,6 +373,17 @@ struct SharedHistories {
         pawnHistSizeMinus1 = pawnHistory.get_size() - 1;
     }
 
+    // Attach the dynamically sized tables to a cross-process shared region
+    // instead of allocating them. The region holds a single slot of each table,
+    // shared by all threads (and all cooperating processes) regardless of NUMA
+    // placement; the continuation histories stay process-private.
+    explicit SharedHistories(SharedHistoryRegion* region) :
+        correctionHistory(region->correctionHistory, 1),
+        pawnHistory(region->pawnHistory, 1) {
+        sizeMinus1         = correctionHistory.get_size() - 1;
+        pawnHistSizeMinus1 = pawnHistory.get_size() - 1;
+    }
+
     usize get_size() const { return sizeMinus1 + 1; }
 
     auto& pawn_entry(const Position& pos) {
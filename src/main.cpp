@@ -18,11 +18,13 @@
 
 #include <iostream>
 #include <memory>
+#include <string_view>
 
 #include "attacks.h"
 #include "bitboard.h"
 #include "misc.h"
 #include "position.h"
+#include "server.h"
 #include "tune.h"
 #include "uci.h"
 
@@ -39,10 +41,14 @@ __attribute__((used)) // keep main alive
 int main(int argc, char* argv[]) {
     std::cout << engine_info() << std::endl;
 
-    Bitboards::init();
     Attacks::init();
     Position::init();
 
+    // Engine pool server mode: serve UCI sessions over a Unix domain socket
+    // from preforked workers that inherit the warm initialization above.
+    if (argc >= 2 && std::string_view(argv[1]) == "serve")
+        return Server::serve(argc, argv);
+
     auto uci = std::make_unique<UCIEngine>(argc, argv);
 
     Tune::init(uci->engine_options());
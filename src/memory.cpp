@@ -28,10 +28,22 @@
 #if defined(__linux__) && !defined(__ANDROID__)
     #include <errno.h>
     #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
     // IWYU pragma: no_include <bits/mman-map-flags-generic.h>
     #include <cstring>
     #include <mutex>
     #include <map>
+#elif defined(__unix__) || defined(__APPLE__)
+    #include <sys/mman.h>
+#endif
+
+// Not all mmap implementations know these flags; they are advisory here
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(MAP_NORESERVE)
+    #define MAP_NORESERVE 0
+#endif
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(MAP_ANONYMOUS)
+    #define MAP_ANONYMOUS MAP_ANON
 #endif
 
 #if defined(__APPLE__) || defined(__ANDROID__) || defined(__OpenBSD__) \
@@ -97,6 +109,37 @@ void std_aligned_free(void* ptr) {
 #endif
 }
 
+// See the description in memory.h. On Windows MEM_COMMIT only reserves
+// commit charge; physical pages still appear on first access, matching the
+// mmap path. The fallback for exotic platforms is a plain calloc, which
+// loses laziness but keeps the semantics.
+void* lazy_commit_alloc(usize size) {
+
+#if defined(_WIN32)
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif defined(__unix__) || defined(__APPLE__)
+    void* mem = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return mem == MAP_FAILED ? nullptr : mem;
+#else
+    return calloc(size, 1);
+#endif
+}
+
+void lazy_commit_free(void* mem, [[maybe_unused]] usize size) {
+
+    if (!mem)
+        return;
+
+#if defined(_WIN32)
+    VirtualFree(mem, 0, MEM_RELEASE);
+#elif defined(__unix__) || defined(__APPLE__)
+    munmap(mem, size);
+#else
+    free(mem);
+#endif
+}
+
 // aligned_large_pages_alloc() will return suitably aligned memory,
 // if possible using large pages.
 
@@ -128,12 +171,19 @@ void* aligned_large_pages_alloc_with_hint(usize allocSize, bool) {
 
 #else
 
+    #if defined(__linux__) && !defined(__ANDROID__)
+        #define HAS_MMAP_REGIONS
+
+// mmap()ed regions by start address, with their size and the page granularity
+// they must stay a multiple of. Tracked so they can be freed by address and
+// resized in place later, see aligned_large_pages_remap().
+static std::map<void*, std::pair<usize, usize>> mmap_regions;
+static std::mutex                               mmap_regions_mtx;
+    #endif
+
     #if defined(__linux__) && defined(MAP_HUGE_SHIFT) && defined(__x86_64__)
         #define HAS_HUGE_PAGES
 
-static std::map<void*, usize> huge_pages;
-static std::mutex             huge_pages_mtx;
-
 static void* try_huge_pages_alloc(usize allocSize) {
     usize size = ((allocSize + HugePageSize - 1) / HugePageSize) * HugePageSize;
     void* mem  = mmap(NULL, size, PROT_READ | PROT_WRITE,
@@ -142,12 +192,43 @@ static void* try_huge_pages_alloc(usize allocSize) {
     if (mem == MAP_FAILED)
         return nullptr;
 
-    std::lock_guard lg(huge_pages_mtx);
-    huge_pages[mem] = size;
+    std::lock_guard lg(mmap_regions_mtx);
+    mmap_regions[mem] = {size, HugePageSize};
     return mem;
 }
     #endif  // defined(__linux__) && defined(MAP_HUGE_SHIFT) && defined(__x86_64__)
 
+    #ifdef HAS_MMAP_REGIONS
+
+// Anonymous mmap with 2MB alignment, achieved by over-mapping and trimming the
+// head and tail. Unlike std_aligned_alloc() the region is tracked and can be
+// grown or shrunk in place afterwards.
+static void* aligned_mmap_alloc(usize allocSize) {
+    constexpr usize alignment = 2 * 1024 * 1024;  // matches the THP size on x86
+
+    const usize size = (allocSize + alignment - 1) & ~(alignment - 1);
+
+    char* raw = static_cast<char*>(mmap(NULL, size + alignment, PROT_READ | PROT_WRITE,
+                                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (raw == MAP_FAILED)
+        return nullptr;
+
+    char* mem = raw + (alignment - reinterpret_cast<usize>(raw) % alignment) % alignment;
+    if (mem != raw)
+        munmap(raw, usize(mem - raw));
+    if (usize tail = alignment - usize(mem - raw))
+        munmap(mem + size, tail);
+
+        #if defined(MADV_HUGEPAGE)
+    madvise(mem, size, MADV_HUGEPAGE);
+        #endif
+
+    std::lock_guard lg(mmap_regions_mtx);
+    mmap_regions[mem] = {size, alignment};
+    return mem;
+}
+    #endif  // HAS_MMAP_REGIONS
+
 void* aligned_large_pages_alloc_with_hint(usize allocSize, [[maybe_unused]] bool hugePageHint) {
     #ifdef HAS_HUGE_PAGES
     if (hugePageHint && allocSize >= HugePageSize)
@@ -179,6 +260,109 @@ void* aligned_large_pages_alloc(usize size) {
     return aligned_large_pages_alloc_with_hint(size, false);
 }
 
+// Best-effort application of a NUMA placement policy to a freshly allocated,
+// not yet touched range. Raw syscalls are used to avoid a libnuma dependency;
+// on platforms or kernels without mbind the range keeps first-touch placement,
+// which is always correct, just possibly less balanced.
+#if defined(__linux__) && !defined(__ANDROID__) && defined(__NR_mbind)
+
+static void apply_numa_policy(void* mem, usize size, AllocPolicy policy, usize node) {
+
+    if (!mem || policy == AllocPolicy::FirstTouch)
+        return;
+
+    constexpr int MpolBind        = 2;  // MPOL_BIND
+    constexpr int MpolInterleave  = 3;  // MPOL_INTERLEAVE
+    constexpr int MpolMemsAllowed = 4;  // MPOL_F_MEMS_ALLOWED
+
+    constexpr usize MaxNodes     = 1024;
+    constexpr usize BitsPerULong = 8 * sizeof(unsigned long);
+
+    unsigned long mask[MaxNodes / BitsPerULong] = {};
+
+    if (policy == AllocPolicy::Interleave)
+    {
+        // Interleave over every node this process is allowed to allocate on
+        if (syscall(__NR_get_mempolicy, nullptr, mask, MaxNodes, nullptr, MpolMemsAllowed))
+            return;
+    }
+    else if (node < MaxNodes)
+        mask[node / BitsPerULong] |= 1UL << (node % BitsPerULong);
+    else
+        return;
+
+    const int mode = policy == AllocPolicy::Interleave ? MpolInterleave : MpolBind;
+
+    size = (size + 4095) & ~usize(4095);  // mbind requires whole pages
+    syscall(__NR_mbind, mem, size, mode, mask, MaxNodes, 0);
+}
+
+#else
+
+static void apply_numa_policy(void*, usize, AllocPolicy, usize) {}
+
+#endif
+
+void* aligned_large_pages_alloc_with_policy(usize       size,
+                                            bool        hugePageHint,
+                                            AllocPolicy policy,
+                                            usize       node) {
+    void* mem = nullptr;
+
+#ifdef HAS_HUGE_PAGES
+    if (hugePageHint && size >= HugePageSize)
+        mem = try_huge_pages_alloc(size);
+#endif
+
+#ifdef HAS_MMAP_REGIONS
+    // Prefer a tracked mapping so the region stays resizable in place
+    if (!mem)
+        mem = aligned_mmap_alloc(size);
+#endif
+
+    if (!mem)
+        mem = aligned_large_pages_alloc_with_hint(size, hugePageHint);
+
+    apply_numa_policy(mem, size, policy, node);
+    return mem;
+}
+
+// Grows or shrinks a tracked mapping in place where the OS supports it, see
+// the declaration for the contract.
+void* aligned_large_pages_remap([[maybe_unused]] void* mem, [[maybe_unused]] usize newSize) {
+#ifdef HAS_MMAP_REGIONS
+    std::lock_guard lg(mmap_regions_mtx);
+
+    auto it = mmap_regions.find(mem);
+    if (it == mmap_regions.end())
+        return nullptr;  // did not come from a tracked mmap
+
+    const auto [oldSize, granularity] = it->second;
+    const usize size                  = (newSize + granularity - 1) & ~(granularity - 1);
+
+    if (size == oldSize)
+        return mem;
+
+    void* remapped = mremap(mem, oldSize, size, MREMAP_MAYMOVE);
+    if (remapped == MAP_FAILED)
+        return nullptr;
+
+    mmap_regions.erase(it);
+    mmap_regions[remapped] = {size, granularity};
+
+    #if defined(MADV_HUGEPAGE)
+    // A moved region keeps its backing, but freshly grown tail pages want
+    // transparent huge pages like the rest. Explicit 1GB pages need no hint.
+    if (granularity != HugePageSize)
+        madvise(remapped, size, MADV_HUGEPAGE);
+    #endif
+
+    return remapped;
+#else
+    return nullptr;
+#endif
+}
+
 bool has_large_pages() {
 
 #if defined(_WIN32)
@@ -233,16 +417,16 @@ void aligned_large_pages_free(void* mem) {
     if (!mem)
         return;
 
-    #ifdef HAS_HUGE_PAGES
-    std::lock_guard lg(huge_pages_mtx);
-    if (auto it = huge_pages.find(mem); it != huge_pages.end())
+    #ifdef HAS_MMAP_REGIONS
+    std::lock_guard lg(mmap_regions_mtx);
+    if (auto it = mmap_regions.find(mem); it != mmap_regions.end())
     {
-        if (munmap(mem, it->second) != 0)
+        if (munmap(mem, it->second.first) != 0)
         {
             std::cerr << "munmap failed: " << strerror(errno) << std::endl;
             exit(EXIT_FAILURE);
         }
-        huge_pages.erase(it);
+        mmap_regions.erase(it);
         return;
     }
     #endif
@@ -20,12 +20,15 @@
 #define MEMORY_H_INCLUDED
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <new>
 #include <type_traits>
 #include <utility>
 #include <cstring>
+#include <vector>
 
 #include "types.h"
 #include "misc.h"
@@ -67,11 +70,42 @@ constexpr usize HugePageSize = usize(1) << 30;
 void* std_aligned_alloc(usize alignment, usize size);
 void  std_aligned_free(void* ptr);
 
+// Demand-zero region for large, sparsely used per-thread buffers: the whole
+// range is reserved virtually up front, but physical pages are committed only
+// on first touch, by whichever thread touches them - so under the first-touch
+// NUMA policy each page lands on the node of its actual user, and untouched
+// tails cost no resident memory. Must be freed with lazy_commit_free().
+void* lazy_commit_alloc(usize size);
+void  lazy_commit_free(void* mem, usize size);
+
+// Placement policy for large allocations on NUMA systems. FirstTouch is the
+// OS default: each page lands on the node of the thread that first writes it.
+// Interleave spreads pages round-robin over all allowed nodes, Bind places the
+// whole range on a single node (given as OS node id). Policies other than
+// FirstTouch are best-effort and only implemented on Linux; elsewhere, and on
+// failure, the range simply keeps first-touch semantics.
+enum class AllocPolicy {
+    FirstTouch,
+    Interleave,
+    Bind
+};
+
 // Memory aligned by page size, min alignment: 4096 bytes
 void* aligned_large_pages_alloc_with_hint(usize size, bool hugePageHint);
 void* aligned_large_pages_alloc(usize size);
+void* aligned_large_pages_alloc_with_policy(usize       size,
+                                            bool        hugePageHint,
+                                            AllocPolicy policy,
+                                            usize       node = 0);
 void  aligned_large_pages_free(void* mem);
 
+// Resizes a region obtained from aligned_large_pages_alloc_with_policy() while
+// preserving its contents up to the smaller of the two sizes (Linux mremap).
+// Returns the new address, which may differ from the old one, or nullptr when
+// the platform or this particular allocation cannot be remapped; in that case
+// the old region is left untouched.
+void* aligned_large_pages_remap(void* mem, usize newSize);
+
 bool has_large_pages();
 
 // Frees memory which was placed there with placement new.
@@ -245,6 +279,63 @@ T* align_ptr_up(T* ptr) {
       reinterpret_cast<char*>((ptrint + (Alignment - 1)) / Alignment * Alignment));
 }
 
+// A monotonic bump allocator for short-lived, stable-address allocations,
+// such as the setup state chain rebuilt on every 'position' command. Memory
+// is handed out by bumping an offset through a list of blocks; individual
+// allocations are never freed, and reset() rewinds to the first block in O(1)
+// while keeping the blocks for reuse, so steady-state operation performs no
+// heap allocation at all.
+class MonotonicArena {
+   public:
+    explicit MonotonicArena(usize minBlockSize = 64 * 1024) :
+        blockSize(minBlockSize) {}
+
+    MonotonicArena(const MonotonicArena&)            = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* allocate(usize size, usize alignment) {
+        // Blocks come from operator new[], so anything over-aligned would
+        // need its own allocation path
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+        assert(alignment <= alignof(std::max_align_t));
+
+        usize aligned = (offset + alignment - 1) & ~(alignment - 1);
+
+        if (blocks.empty() || current >= blocks.size() || aligned + size > blocks[current].size)
+        {
+            if (!blocks.empty() && current + 1 < blocks.size()
+                && size <= blocks[current + 1].size)
+                ++current;
+            else
+            {
+                const usize newSize = std::max(blockSize, size);
+                blocks.push_back({std::make_unique<char[]>(newSize), newSize});
+                current = blocks.size() - 1;
+            }
+            aligned = 0;
+        }
+
+        offset = aligned + size;
+        return blocks[current].mem.get() + aligned;
+    }
+
+    // Invalidates all outstanding allocations
+    void reset() {
+        current = 0;
+        offset  = 0;
+    }
+
+   private:
+    struct Block {
+        std::unique_ptr<char[]> mem;
+        usize                   size;
+    };
+
+    std::vector<Block> blocks;
+    usize              current = 0, offset = 0;
+    usize              blockSize;
+};
+
 #if defined(_WIN32)
 
 template<typename FuncYesT, typename FuncNoT>
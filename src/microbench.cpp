@@ -0,0 +1,345 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "microbench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "attacks.h"
+#include "benchmark.h"
+#include "misc.h"
+#include "movegen.h"
+#include "nnue/nnue_architecture.h"
+#include "position.h"
+#include "profile.h"
+#include "types.h"
+
+#ifdef __linux__
+    #include <sched.h>
+#endif
+
+namespace Stockfish::Microbench {
+
+namespace {
+
+using namespace Eval::NNUE;
+
+constexpr int WarmupPasses  = 3;
+constexpr int DefaultPasses = 21;
+
+// Every kernel folds its results in here so the optimizer cannot drop the
+// work; the final value is printed as a checksum, which doubles as a quick
+// cross-build sanity check since all inputs are seeded deterministically.
+u64 checksum = 0;
+
+// Pin the calling thread to the core it currently runs on, so the TSC deltas
+// are not polluted by migrations. Returns the previous mask for restoring.
+#ifdef __linux__
+cpu_set_t pin_current_core(bool& pinned) {
+    cpu_set_t previous;
+    CPU_ZERO(&previous);
+    sched_getaffinity(0, sizeof(previous), &previous);
+
+    int cpu = sched_getcpu();
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu < 0 ? 0 : cpu, &set);
+    pinned = sched_setaffinity(0, sizeof(set), &set) == 0;
+
+    return previous;
+}
+#endif
+
+// Runs body WarmupPasses times to settle caches and branch predictors, then
+// `passes` measured times, and reports the median pass. opsPerPass is the
+// kernel invocation count of one pass; bytesPerOp the data actually streamed
+// per invocation (0 where the working set is table lookups and not meaningful
+// as bandwidth).
+template<typename Body>
+void run_case(std::ostream& os,
+              const char*   name,
+              u64           opsPerPass,
+              u64           bytesPerOp,
+              int           passes,
+              Body&&        body) {
+
+    for (int i = 0; i < WarmupPasses; ++i)
+        body();
+
+    std::vector<u64> cycles, nanos;
+    cycles.reserve(passes);
+    nanos.reserve(passes);
+
+    for (int i = 0; i < passes; ++i)
+    {
+        const auto t0 = std::chrono::steady_clock::now();
+        const u64  c0 = Profile::now_cycles();
+        body();
+        const u64  c1 = Profile::now_cycles();
+        const auto t1 = std::chrono::steady_clock::now();
+
+        cycles.push_back(c1 - c0);
+        nanos.push_back(
+          u64(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()));
+    }
+
+    std::sort(cycles.begin(), cycles.end());
+    std::sort(nanos.begin(), nanos.end());
+
+    const double cyclesPerOp = double(cycles[passes / 2]) / double(opsPerPass);
+    const double nsPerOp     = double(nanos[passes / 2]) / double(opsPerPass);
+
+    os << std::left << std::setw(26) << name << std::right << std::setw(10) << opsPerPass
+       << std::fixed << std::setprecision(2) << std::setw(12) << cyclesPerOp << std::setw(10)
+       << nsPerOp;
+
+    if (bytesPerOp)
+        os << std::setw(13) << double(bytesPerOp) / cyclesPerOp;
+    else
+        os << std::setw(13) << "-";
+
+    os << "\n";
+}
+
+// The bench position set, parsed out of the command list that setup_bench
+// builds, so the inputs below track whatever the bench suite currently uses.
+std::deque<Position> bench_positions(std::deque<StateInfo>& states) {
+
+    std::deque<Position> positions;
+
+    std::istringstream cfg;  // all defaults
+    bool               chess960 = false;
+
+    for (const std::string& cmd : Benchmark::setup_bench("", cfg))
+    {
+        if (cmd.rfind("setoption", 0) == 0)
+        {
+            if (cmd.find("UCI_Chess960") != std::string::npos)
+                chess960 = cmd.find("true") != std::string::npos;
+            continue;
+        }
+
+        if (cmd.rfind("position fen ", 0) != 0)
+            continue;
+
+        std::string fen = cmd.substr(13);
+        if (usize cut = fen.find(" moves "); cut != std::string::npos)
+            fen.resize(cut);  // kernels only need the base position
+
+        states.emplace_back();
+        positions.emplace_back();
+        if (positions.back().set(fen, chess960, &states.back()))
+        {
+            positions.pop_back();
+            states.pop_back();
+        }
+    }
+
+    return positions;
+}
+
+// Magic bishop + rook lookups for every square against each bench
+// occupancy. Pure table walks, so no bandwidth figure is reported.
+void bench_slider_attacks(std::ostream& os, const std::deque<Position>& positions, int passes) {
+
+    std::vector<std::pair<Square, Bitboard>> inputs;
+    for (const Position& pos : positions)
+        for (Square s = SQ_A1; s <= SQ_H8; ++s)
+            inputs.emplace_back(s, pos.pieces());
+
+    run_case(os, "slider attacks", 2 * inputs.size(), 0, passes, [&] {
+        u64 x = 0;
+        for (const auto& [s, occ] : inputs)
+            x += Attacks::attacks_bb<BISHOP>(s, occ) + Attacks::attacks_bb<ROOK>(s, occ);
+        checksum += x;
+    });
+}
+
+// Static exchange evaluation over every pseudo-legal capture in the bench
+// positions, the same calls move picking makes when scoring captures.
+void bench_see_ge(std::ostream& os, const std::deque<Position>& positions, int passes) {
+
+    std::vector<std::pair<const Position*, Move>> captures;
+    for (const Position& pos : positions)
+        for (const Move m : MoveList<CAPTURES>(pos))
+            captures.emplace_back(&pos, m);
+
+    run_case(os, "see_ge", captures.size(), 0, passes, [&] {
+        u64 x = 0;
+        for (const auto& [pos, m] : captures)
+            x += pos->see_ge(m);
+        checksum += x;
+    });
+}
+
+// One forward pass of the first fully connected layer (the network's fc_0),
+// with random weights and an input kept around 20% dense to match the
+// post-ReLU sparsity seen in middlegame positions.
+void bench_sparse_affine(std::ostream& os, int passes) {
+
+    using Layer = Layers::AffineTransformSparseInput<L1, L2 + 1>;
+
+    constexpr int PropagationsPerPass = 2048;
+
+    auto layer = std::make_unique<Layer>();
+    PRNG rng{0x2E426E694D696B65ULL};
+
+    // Feed random parameters through the layer's own deserializer, so the
+    // weights land in whatever scrambled layout the SIMD path expects
+    std::string blob(Layer::OutputDimensions * sizeof(i32)
+                       + usize(Layer::OutputDimensions) * Layer::PaddedInputDimensions,
+                     '\0');
+    for (char& c : blob)
+        c = char(rng.rand<u64>());
+    std::istringstream weightStream(blob);
+    layer->read_parameters(weightStream);
+
+    constexpr IndexType NumChunks = L1 / 4;
+
+    alignas(CacheLineSize) static u8 input[L1];
+    std::memset(input, 0, sizeof(input));
+
+    auto nnz = std::make_unique<NNZInfo<L1>>();
+#if defined(USE_AVX512)
+    nnz->count = 0;
+#else
+    std::memset(nnz->bitset, 0, sizeof(nnz->bitset));
+#endif
+
+    u64 activeChunks = 0;
+    for (IndexType c = 0; c < NumChunks; ++c)
+        if (rng.rand<u64>() % 100 < 20)
+        {
+            ++activeChunks;
+            for (IndexType j = 0; j < 4; ++j)
+                input[4 * c + j] = u8(1 + rng.rand<u64>() % 126);
+#if defined(USE_AVX512)
+            nnz->nnz[nnz->count++] = u16(c);
+#else
+            nnz->bitset[c / 8] |= u8(1 << (c % 8));
+#endif
+        }
+
+    alignas(CacheLineSize) static Layer::OutputBuffer output;
+
+    // Per propagation: one i32 of input and one weight column per live chunk
+    const u64 bytesPerOp = activeChunks * (sizeof(i32) + Layer::OutputDimensions * 4);
+
+    run_case(os, "sparse affine (fc_0)", PropagationsPerPass, bytesPerOp, passes, [&] {
+        u64 x = 0;
+        for (int i = 0; i < PropagationsPerPass; ++i)
+        {
+            layer->propagate(input, output, *nnz);
+            x += u64(u32(output[0]));
+        }
+        checksum += x;
+    });
+}
+
+// The feature transformer's incremental update inner loop: add one row of
+// weights to the accumulator and subtract another, over a full L1-wide half.
+// Written with the same simd.h macros the real loop uses so it measures the
+// identical instruction mix; one op is one such row update.
+void bench_ft_update(std::ostream& os, int passes) {
+
+    constexpr int RowUpdatesPerPass = 8192;
+
+    alignas(CacheLineSize) static i16 acc[L1], added[L1], removed[L1];
+
+    PRNG rng{0x465472616E736Fu};
+    for (usize i = 0; i < L1; ++i)
+    {
+        acc[i]     = i16(rng.rand<u64>());
+        added[i]   = i16(rng.rand<u64>());
+        removed[i] = i16(rng.rand<u64>());
+    }
+
+    const u64 bytesPerOp = 4 * L1 * sizeof(i16);  // acc read+write, two weight rows read
+
+    run_case(os, "ft row add/sub", RowUpdatesPerPass, bytesPerOp, passes, [&] {
+#ifdef VECTOR
+        constexpr usize NumVecs = L1 * sizeof(i16) / sizeof(SIMD::vec_t);
+
+        auto*       a = reinterpret_cast<SIMD::vec_t*>(acc);
+        const auto* p = reinterpret_cast<const SIMD::vec_t*>(added);
+        const auto* q = reinterpret_cast<const SIMD::vec_t*>(removed);
+
+        for (int r = 0; r < RowUpdatesPerPass; ++r)
+            for (usize i = 0; i < NumVecs; ++i)
+                vec_store(&a[i], vec_sub_16(vec_add_16(vec_load(&a[i]), vec_load(&p[i])),
+                                            vec_load(&q[i])));
+#else
+        for (int r = 0; r < RowUpdatesPerPass; ++r)
+            for (usize i = 0; i < L1; ++i)
+                acc[i] = i16(acc[i] + added[i] - removed[i]);
+#endif
+        checksum += u64(u16(acc[0]));
+    });
+}
+
+}  // namespace
+
+
+void run(std::istream& args) {
+
+    int passes = DefaultPasses;
+    if (std::string token; args >> token)
+        passes = std::clamp(std::stoi(token), 1, 1001);
+
+    bool pinned = false;
+#ifdef __linux__
+    cpu_set_t previousAffinity = pin_current_core(pinned);
+#endif
+
+    std::deque<StateInfo> states;
+    std::deque<Position>  positions = bench_positions(states);
+
+    std::ostringstream os;
+    os << "passes " << passes << (pinned ? ", pinned to current core" : ", core pinning unavailable")
+       << "\n"
+       << std::left << std::setw(26) << "kernel" << std::right << std::setw(10) << "ops/pass"
+       << std::setw(12) << "cycles/op" << std::setw(10) << "ns/op" << std::setw(13)
+       << "bytes/cycle" << "\n";
+
+    checksum = 0;
+
+    bench_slider_attacks(os, positions, passes);
+    bench_see_ge(os, positions, passes);
+    bench_sparse_affine(os, passes);
+    bench_ft_update(os, passes);
+
+    os << "checksum " << checksum;
+
+    sync_cout << os.str() << sync_endl;
+
+#ifdef __linux__
+    sched_setaffinity(0, sizeof(previousAffinity), &previousAffinity);
+#endif
+}
+
+}  // namespace Stockfish::Microbench
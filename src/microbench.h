@@ -0,0 +1,45 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MICROBENCH_H_INCLUDED
+#define MICROBENCH_H_INCLUDED
+
+#include <iosfwd>
+
+namespace Stockfish::Microbench {
+
+// Microbenchmarks for the hot low-level kernels: magic slider attacks,
+// static exchange evaluation, the sparse first fully connected NNUE layer
+// and the feature transformer accumulate loop. Unlike 'bench' these isolate
+// single kernels with warm caches and representative inputs taken from the
+// bench positions, so a codegen or data-layout change can be judged without
+// the noise of a full search.
+//
+// Usage: microbench [passes]
+//
+// The calling thread is pinned to its current core for the duration and each
+// kernel reports the median over the measured passes, which keeps run-to-run
+// variation around the 1% level on an idle machine. Counts are TSC reference
+// cycles on x86-64 (see Profile::now_cycles()), nanoseconds elsewhere. For
+// instruction counts and IPC run the command under 'perf stat' or equivalent;
+// hardware counters are deliberately not read here.
+void run(std::istream& args);
+
+}  // namespace Stockfish::Microbench
+
+#endif  // #ifndef MICROBENCH_H_INCLUDED
@@ -29,8 +29,10 @@
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <condition_variable>
 #include <mutex>
 #include <sstream>
+#include <thread>
 #include <string_view>
 
 #include "types.h"
@@ -259,6 +261,9 @@ std::string compiler_info() {
 #if defined(USE_SSE2)
     compiler += " SSE2";
 #endif
+#if defined(USE_SVE2)
+    compiler += " SVE2";
+#endif
 #if defined(USE_NEON_DOTPROD)
     compiler += " NEON_DOTPROD";
 #elif defined(USE_NEON)
@@ -434,6 +439,80 @@ std::ostream& operator<<(std::ostream& os, SyncCout sc) {
 void sync_cout_start() { std::cout << IO_LOCK; }
 void sync_cout_end() { std::cout << IO_UNLOCK; }
 
+namespace AsyncOutput {
+
+namespace {
+
+class Writer {
+   public:
+    ~Writer() {
+        if (!thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopRequested = true;
+        }
+        cv.notify_one();
+        thread.join();
+    }
+
+    void enqueue(std::string&& line) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // Spawned lazily so that processes which never produce search
+            // output (e.g. bench runs with silenced listeners) stay
+            // single-threaded here.
+            if (!thread.joinable())
+                thread = std::thread([this] { loop(); });
+
+            pending.append(line);
+            pending.push_back('\n');
+        }
+        cv.notify_one();
+    }
+
+   private:
+    void loop() {
+        std::string batch;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            cv.wait(lock, [&] { return !pending.empty() || stopRequested; });
+
+            if (pending.empty() && stopRequested)
+                return;
+
+            batch.swap(pending);
+            pending.clear();
+
+            lock.unlock();
+            sync_cout_start();
+            std::cout.write(batch.data(), std::streamsize(batch.size()));
+            std::cout.flush();
+            sync_cout_end();
+            batch.clear();
+            lock.lock();
+        }
+    }
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::thread             thread;
+    std::string             pending;
+    bool                    stopRequested = false;
+};
+
+Writer writer;
+
+}  // namespace
+
+void enqueue(std::string&& line) { writer.enqueue(std::move(line)); }
+
+}  // namespace AsyncOutput
+
 // Hash function based on public domain MurmurHash64A, by Austin Appleby.
 u64 hash_bytes(const char* data, usize size) {
     const u64 m = 0xc6a4a7935bd1e995ull;
@@ -541,6 +620,123 @@ std::string CommandLine::get_binary_directory(std::string argv0) {
     return binaryDirectory;
 }
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #include <x86intrin.h>
+    #define SF_HAS_RDTSC
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define SF_HAS_RDTSC
+#endif
+
+#ifdef _WIN32
+    #include <process.h>
+#endif
+
+namespace CoarseClock {
+
+#ifdef SF_HAS_RDTSC
+
+namespace {
+
+int current_pid() {
+    #ifdef _WIN32
+    return _getpid();
+    #else
+    return getpid();
+    #endif
+}
+
+// Latest calibration point, published under a seqlock so a reader never
+// combines the tsc of one anchor with the milliseconds of another (which
+// would be off by a whole calibration period).
+struct Anchor {
+    RelaxedAtomic<u64>    tsc;
+    RelaxedAtomic<i64>    ms;
+    RelaxedAtomic<double> msPerTick;
+};
+
+Anchor           anchor;
+std::atomic<u64> anchorSeq{0};
+std::atomic<int> calibratorPid{0};
+std::atomic<bool> calibrated{false};
+
+void calibrate_loop() {
+
+    const u64       tsc0 = __rdtsc();
+    const TimePoint ms0  = Stockfish::now();
+
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const u64       tsc1 = __rdtsc();
+        const TimePoint ms1  = Stockfish::now();
+
+        // The slope over the whole process lifetime converges to the true
+        // frequency; extrapolation from the fresh anchor stays under 100ms,
+        // so the error is a few ppm of that.
+        if (tsc1 <= tsc0 || ms1 <= ms0)
+            continue;  // TSC not usable (migration across unsynced sockets?)
+
+        const u64 s = anchorSeq.load(std::memory_order_relaxed);
+        anchorSeq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        anchor.tsc       = tsc1;
+        anchor.ms        = ms1;
+        anchor.msPerTick = double(ms1 - ms0) / double(tsc1 - tsc0);
+        anchorSeq.store(s + 2, std::memory_order_release);
+
+        calibrated.store(true, std::memory_order_relaxed);
+    }
+}
+
+}
+
+void init() {
+
+    const int pid = current_pid();
+
+    // A forked child inherits the anchor but not the calibration thread, so
+    // the guard is per process, not a simple once-flag.
+    if (calibratorPid.exchange(pid, std::memory_order_relaxed) == pid)
+        return;
+
+    calibrated.store(false, std::memory_order_relaxed);
+    std::thread(calibrate_loop).detach();
+}
+
+TimePoint now() {
+
+    if (!calibrated.load(std::memory_order_relaxed))
+        return Stockfish::now();
+
+    while (true)
+    {
+        const u64 s1 = anchorSeq.load(std::memory_order_acquire);
+        if (s1 & 1)
+            continue;
+
+        const u64    tsc       = anchor.tsc;
+        const i64    ms        = anchor.ms;
+        const double msPerTick = anchor.msPerTick;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (anchorSeq.load(std::memory_order_relaxed) == s1)
+            return ms + TimePoint(double(__rdtsc() - tsc) * msPerTick);
+    }
+}
+
+#else
+
+void init() {}
+
+TimePoint now() { return Stockfish::now(); }
+
+#endif
+
+}  // namespace CoarseClock
+
+
 std::string CommandLine::get_working_directory() {
     std::string workingDirectory = "";
     char        buff[40000];
@@ -169,6 +169,21 @@ inline TimePoint now() {
       .count();
 }
 
+// Coarse clock sharing now()'s epoch and millisecond units, but backed by the
+// TSC on x86 so that the high-frequency time polling in the search makes no
+// syscalls (on some VMs even vDSO clock reads are slow). A background thread
+// keeps the tsc-to-ms conversion anchored against the real clock; until the
+// first calibration, and on platforms without a TSC, now() here simply
+// forwards to the one above.
+namespace CoarseClock {
+
+// Idempotent per process; restarts the calibration thread after a fork()
+void init();
+
+TimePoint now();
+
+}
+
 inline std::vector<std::string_view> split(std::string_view s, std::string_view delimiter) {
     std::vector<std::string_view> res;
 
@@ -206,6 +221,19 @@ std::ostream& operator<<(std::ostream&, SyncCout);
 void sync_cout_start();
 void sync_cout_end();
 
+// Asynchronous stdout writer for high-rate search output. Lines are appended
+// to a pending batch under a short uncontended lock, and a dedicated writer
+// thread coalesces each batch into a single buffered write and one flush, so
+// search threads never block on stdout flushes. Queued lines keep their order
+// relative to each other, and the writer takes the sync_cout lock while
+// writing, so batches never interleave with direct sync_cout output mid-line.
+namespace AsyncOutput {
+
+// Queues one complete line (without the trailing newline) for output
+void enqueue(std::string&& line);
+
+}
+
 // True if and only if the binary is compiled on a little-endian machine
 static inline const u16  Le             = 1;
 static inline const bool IsLittleEndian = *reinterpret_cast<const char*>(&Le) == 1;
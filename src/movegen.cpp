@@ -18,6 +18,8 @@
 
 #include "movegen.h"
 
+#include "profile.h"
+
 #include <cassert>
 #include <initializer_list>
 
@@ -319,6 +321,124 @@ Move* generate_all(const Position& pos, Move* moveList) {
     return moveList;
 }
 
+// Piece captures restricted to the victims in valuable, except that a piece
+// standing on a discovered-check line keeps all its captures and every piece
+// keeps captures landing on one of its checking squares. Mirrors the body of
+// generate_moves() with a per-source target.
+template<Color Us, PieceType Pt>
+Move* generate_piece_captures(
+  const Position& pos, Move* moveList, Bitboard discovered, Bitboard enemies, Bitboard valuable) {
+
+    static_assert(Pt != KING && Pt != PAWN, "Unsupported piece type in generate_piece_captures()");
+
+    Bitboard bb = pos.pieces(Us, Pt);
+
+    while (bb)
+    {
+        Square   from   = pop_lsb(bb);
+        Bitboard target = (discovered & from) ? enemies
+                                              : valuable | (enemies & pos.check_squares(Pt));
+#ifdef USE_AVX512ICL
+        if constexpr (Pt != QUEEN)
+        {
+            moveList = splat_precomputed_moves<Pt>(moveList, from, pos.pieces(), target);
+            continue;
+        }
+#endif
+        Bitboard b = Attacks::attacks_bb<Pt>(from, pos.pieces()) & target;
+
+        moveList = splat_moves(moveList, from, b);
+    }
+
+    return moveList;
+}
+
+
+template<Color Us>
+Move* generate_threshold_captures(const Position& pos,
+                                  Move*           moveList,
+                                  Value           victimThreshold,
+                                  Square          recaptureSq) {
+
+    constexpr Color     Them     = ~Us;
+    constexpr Bitboard  TRank7BB = (Us == WHITE ? Rank7BB : Rank2BB);
+    constexpr Direction UpRight  = (Us == WHITE ? NORTH_EAST : SOUTH_WEST);
+    constexpr Direction UpLeft   = (Us == WHITE ? NORTH_WEST : SOUTH_EAST);
+
+    const Bitboard enemies = pos.pieces(Them);
+
+    // Victims valuable enough to beat the threshold, plus the recapture square
+    Bitboard valuable = 0;
+    for (PieceType pt : {PAWN, KNIGHT, BISHOP, ROOK, QUEEN})
+        if (PieceValue[pt] >= victimThreshold)
+            valuable |= pos.pieces(Them, pt);
+
+    if (recaptureSq != SQ_NONE)
+        valuable |= enemies & recaptureSq;
+
+    // Our pieces whose departure may uncover a check: all their captures stay
+    const Bitboard discovered = pos.blockers_for_king(Them) & pos.pieces(Us);
+
+    Bitboard pawnsOn7    = pos.pieces(Us, PAWN) & TRank7BB;
+    Bitboard pawnsNotOn7 = pos.pieces(Us, PAWN) & ~TRank7BB;
+
+    // Promotions are exempt from futility pruning, so keep them all
+    if (pawnsOn7)
+    {
+        Bitboard b1 = shift<UpRight>(pawnsOn7) & enemies;
+        Bitboard b2 = shift<UpLeft>(pawnsOn7) & enemies;
+
+        while (b1)
+            moveList = make_promotions<CAPTURES, UpRight, true>(moveList, pop_lsb(b1));
+
+        while (b2)
+            moveList = make_promotions<CAPTURES, UpLeft, true>(moveList, pop_lsb(b2));
+    }
+
+    // Non-promotion pawn captures: discovered checkers keep everything, the
+    // rest only valuable victims and direct checks
+    Bitboard discPawns  = pawnsNotOn7 & discovered;
+    Bitboard restPawns  = pawnsNotOn7 & ~discovered;
+    Bitboard pawnTarget = valuable | (enemies & pos.check_squares(PAWN));
+
+    moveList = splat_pawn_moves<UpRight>(moveList, shift<UpRight>(discPawns) & enemies);
+    moveList = splat_pawn_moves<UpLeft>(moveList, shift<UpLeft>(discPawns) & enemies);
+    moveList = splat_pawn_moves<UpRight>(moveList, shift<UpRight>(restPawns) & pawnTarget);
+    moveList = splat_pawn_moves<UpLeft>(moveList, shift<UpLeft>(restPawns) & pawnTarget);
+
+    // En passant removes two pieces from the board and can uncover two lines
+    // at once; it is far too rare to be worth classifying, so keep it
+    if (pos.ep_square() != SQ_NONE)
+    {
+        assert(rank_of(pos.ep_square()) == relative_rank(Us, RANK_6));
+
+        Bitboard b1 = pawnsNotOn7 & Attacks::attacks_bb<PAWN>(pos.ep_square(), Them);
+
+        assert(b1);
+
+        while (b1)
+            *moveList++ = Move::make<EN_PASSANT>(pop_lsb(b1), pos.ep_square());
+    }
+
+    moveList = generate_piece_captures<Us, KNIGHT>(pos, moveList, discovered, enemies, valuable);
+    moveList = generate_piece_captures<Us, BISHOP>(pos, moveList, discovered, enemies, valuable);
+    moveList = generate_piece_captures<Us, ROOK>(pos, moveList, discovered, enemies, valuable);
+    moveList = generate_piece_captures<Us, QUEEN>(pos, moveList, discovered, enemies, valuable);
+
+    // The king gives no direct checks; it only escapes the restriction when
+    // it may uncover one
+    const Square   ksq        = pos.square<KING>(Us);
+    const Bitboard kingTarget = (discovered & ksq) ? enemies : valuable;
+
+#ifdef USE_AVX512ICL
+    moveList = splat_precomputed_moves<KING>(moveList, ksq, 0ULL, kingTarget);
+#else
+    moveList = splat_moves(moveList, ksq, Attacks::attacks_bb<KING>(ksq) & kingTarget);
+#endif
+
+    return moveList;
+}
+
 }  // namespace
 
 
@@ -334,6 +454,8 @@ Move* generate(const Position& pos, Move* moveList) {
     static_assert(Type != LEGAL, "Unsupported type in generate()");
     assert((Type == EVASIONS) == bool(pos.checkers()));
 
+    PROFILE_SCOPE(MoveGen);
+
     Color us = pos.side_to_move();
 
     return us == WHITE ? generate_all<WHITE, Type>(pos, moveList)
@@ -346,8 +468,39 @@ template Move* generate<QUIETS>(const Position&, Move*);
 template Move* generate<EVASIONS>(const Position&, Move*);
 template Move* generate<NON_EVASIONS>(const Position&, Move*);
 
+// See the declaration in movegen.h. Only the dispatcher lives here: a
+// threshold no pawn capture can fail degenerates to plain generate<CAPTURES>,
+// which also keeps this path cold in the main search.
+Move* generate_captures(const Position& pos,
+                        Move*           moveList,
+                        Value           victimThreshold,
+                        Square          recaptureSq) {
+
+    assert(!pos.checkers());
+
+    if (victimThreshold <= PawnValue)
+        return generate<CAPTURES>(pos, moveList);
+
+    PROFILE_SCOPE(MoveGen);
+
+    return pos.side_to_move() == WHITE
+           ? generate_threshold_captures<WHITE>(pos, moveList, victimThreshold, recaptureSq)
+           : generate_threshold_captures<BLACK>(pos, moveList, victimThreshold, recaptureSq);
+}
+
 // generate<LEGAL> generates all the legal moves in the given position
 
+LazyLegalMoveList::LazyLegalMoveList(const Position& p) :
+    pos(p),
+    pinned(p.blockers_for_king(p.side_to_move()) & p.pieces(p.side_to_move())),
+    ksq(p.square<KING>(p.side_to_move())),
+    last(p.checkers() ? generate<EVASIONS>(p, moveList) : generate<NON_EVASIONS>(p, moveList)) {}
+
+bool LazyLegalMoveList::is_legal(Move m) const {
+    return !((pinned & m.from_sq()) || m.from_sq() == ksq || m.type_of() == EN_PASSANT)
+        || pos.legal(m);
+}
+
 template<>
 Move* generate<LEGAL>(const Position& pos, Move* moveList) {
 
@@ -51,6 +51,15 @@ inline bool operator<(const ExtMove& f, const ExtMove& s) { return f.value < s.v
 template<GenType>
 Move* generate(const Position& pos, Move* moveList);
 
+// As generate<CAPTURES>, but drops captures whose victim is worth less than
+// victimThreshold, composing the restriction into the target bitboards so the
+// futile moves are never materialized. Captures that may give check (directly
+// or by discovery), promotions, en passant and recaptures on recaptureSq are
+// always kept: the same exemptions quiescence search futility pruning grants.
+// A threshold at or below PawnValue keeps every capture. The position must
+// not be in check.
+Move* generate_captures(const Position& pos, Move* moveList, Value victimThreshold, Square recaptureSq);
+
 // The MoveList struct wraps the generate() function and returns a convenient
 // list of moves. Using MoveList is sometimes preferable to directly calling
 // the lower level generate() function.
@@ -59,6 +68,12 @@ struct MoveList {
 
     explicit MoveList(const Position& pos) :
         last(generate<T>(pos, moveList)) {}
+
+    // Threshold-aware capture list, see generate_captures()
+    MoveList(const Position& pos, Value victimThreshold, Square recaptureSq) :
+        last(generate_captures(pos, moveList, victimThreshold, recaptureSq)) {
+        static_assert(T == CAPTURES, "Victim threshold applies only to captures");
+    }
     const Move* begin() const { return moveList; }
     const Move* end() const { return last; }
     usize       size() const { return last - moveList; }
@@ -68,6 +83,60 @@ struct MoveList {
     Move moveList[MAX_MOVES], *last;
 };
 
+// LazyLegalMoveList defers legality verification to yield time. Pseudo-legal
+// moves are still generated eagerly in bulk, but Position::legal only runs
+// when a move is actually consumed, and only for the candidates that can be
+// illegal: pinned pieces, king moves and en passant (the pin and check masks
+// are the ones already cached in StateInfo). Consumers that stop early, like
+// emptiness tests or a TT move membership test, thereby skip most of the
+// legality work MoveList<LEGAL> does up front. Perft and root move setup keep
+// the eager MoveList<LEGAL>, since they consume every move anyway.
+struct LazyLegalMoveList {
+
+    explicit LazyLegalMoveList(const Position& p);
+
+    struct Iterator {
+        const LazyLegalMoveList* list;
+        const Move*              cur;
+
+        Move      operator*() const { return *cur; }
+        Iterator& operator++() {
+            cur = list->next_legal(cur + 1);
+            return *this;
+        }
+        bool operator==(const Iterator& o) const { return cur == o.cur; }
+        bool operator!=(const Iterator& o) const { return cur != o.cur; }
+    };
+
+    Iterator begin() const { return {this, next_legal(moveList)}; }
+    Iterator end() const { return {this, last}; }
+
+    bool empty() const { return next_legal(moveList) == last; }
+
+    bool contains(Move move) const {
+        return std::find(moveList, static_cast<const Move*>(last), move) != last
+            && is_legal(move);
+    }
+
+   private:
+    const Move* next_legal(const Move* cur) const {
+        while (cur != last && !is_legal(*cur))
+            ++cur;
+        return cur;
+    }
+
+    // Same candidate filter as generate<LEGAL>: all other moves are legal by
+    // construction of the pseudo-legal generators. Defined in movegen.cpp
+    // because Position is only forward-declared here.
+    bool is_legal(Move m) const;
+
+    const Position& pos;
+    Bitboard        pinned;
+    Square          ksq;
+    Move            moveList[MAX_MOVES];
+    Move*           last;
+};
+
 }  // namespace Stockfish
 
 #endif  // #ifndef MOVEGEN_H_INCLUDED
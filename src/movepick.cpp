@@ -25,6 +25,12 @@
 #include "bitboard.h"
 #include "misc.h"
 #include "position.h"
+#include "profile.h"
+#include "tt.h"
+
+#if defined(USE_AVX512ICL) || defined(USE_AVX2)
+    #include <immintrin.h>
+#endif
 
 namespace Stockfish {
 
@@ -50,13 +56,18 @@ enum Stages {
     PROBCUT_INIT,
     PROBCUT,
 
-    // generate qsearch moves
+    // generate qsearch moves (QMovePicker)
     QSEARCH_TT,
     QCAPTURE_INIT,
-    QCAPTURE
+    QCAPTURE,
+
+    // generate qsearch evasion moves (QMovePicker)
+    QEVASION_TT,
+    QEVASION_INIT,
+    QEVASION
 };
 
-#ifdef USE_AVX512ICL
+#if defined(USE_AVX512ICL)
 // Load the Move, and the ExtMove value, into all lanes of 512-bit registers
 static void splat_extmove(const ExtMove& m, __m512i& move, __m512i& value) {
     move  = _mm512_set1_epi32(m.raw());
@@ -104,6 +115,101 @@ struct MoveSorter {
         write(8, _mm512_setr_epi32(8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
     }
 };
+
+#elif defined(USE_AVX2)
+
+// Sorts up to 8 moves. AVX2 has no expand instruction, so the shift
+// permutation and the insertion blend are looked up by insertion point.
+struct MoveSorter {
+    static constexpr int MAX_ELEMENTS = 8;
+    __m256i              sortedValues, sortedMoves;
+
+    explicit MoveSorter(const ExtMove& first) {
+        sortedMoves = _mm256_set1_epi32(first.raw());
+
+        // Set the uninitialized move values to INT_MIN, so that they sort less than any other move
+        sortedValues = _mm256_blend_epi32(
+          _mm256_set1_epi32(std::numeric_limits<int>::min()), _mm256_set1_epi32(first.value), 1);
+    }
+
+    void insert(const ExtMove& m) {
+        assert(m.value != std::numeric_limits<int>::min());
+
+        static const __m256i ShiftIdx[MAX_ELEMENTS] = {
+          _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6), _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6),
+          _mm256_setr_epi32(0, 1, 1, 2, 3, 4, 5, 6), _mm256_setr_epi32(0, 1, 2, 2, 3, 4, 5, 6),
+          _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6), _mm256_setr_epi32(0, 1, 2, 3, 4, 4, 5, 6),
+          _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 5, 6), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 6)};
+        static const __m256i InsertMask[MAX_ELEMENTS] = {
+          _mm256_setr_epi32(-1, 0, 0, 0, 0, 0, 0, 0), _mm256_setr_epi32(0, -1, 0, 0, 0, 0, 0, 0),
+          _mm256_setr_epi32(0, 0, -1, 0, 0, 0, 0, 0), _mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, 0),
+          _mm256_setr_epi32(0, 0, 0, 0, -1, 0, 0, 0), _mm256_setr_epi32(0, 0, 0, 0, 0, -1, 0, 0),
+          _mm256_setr_epi32(0, 0, 0, 0, 0, 0, -1, 0), _mm256_setr_epi32(0, 0, 0, 0, 0, 0, 0, -1)};
+
+        const __m256i value = _mm256_set1_epi32(m.value);
+        const __m256i move  = _mm256_set1_epi32(m.raw());
+
+        // Lanes holding a smaller value form a suffix of the descending order;
+        // its first lane is the insertion point, and everything from there on
+        // shifts one lane up, which always fits because the caller never
+        // inserts into a full sorter.
+        const u32 smaller =
+          u32(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(value, sortedValues))));
+        assert(smaller);
+        const int b = int(lsb(smaller));
+
+        sortedValues = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(sortedValues, ShiftIdx[b]),
+                                          value, InsertMask[b]);
+        sortedMoves  = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(sortedMoves, ShiftIdx[b]),
+                                          move, InsertMask[b]);
+    }
+
+    void write_sorted(ExtMove* moves, isize count) const {
+        static_assert(sizeof(ExtMove) == 8);
+        assert(count <= MAX_ELEMENTS);
+
+        static const __m256i StoreMask[4] = {
+          _mm256_setr_epi64x(-1, 0, 0, 0), _mm256_setr_epi64x(-1, -1, 0, 0),
+          _mm256_setr_epi64x(-1, -1, -1, 0), _mm256_setr_epi64x(-1, -1, -1, -1)};
+
+        // Because values and moves are stored separately, we need to reassemble the ExtMoves
+        const __m256i lo = _mm256_unpacklo_epi32(sortedMoves, sortedValues);
+        const __m256i hi = _mm256_unpackhi_epi32(sortedMoves, sortedValues);
+
+        auto write = [&](isize offset, const __m256i extMoves) {
+            const isize storeCount = std::min(count - offset, isize(4));
+            if (storeCount > 0)
+                _mm256_maskstore_epi64(reinterpret_cast<long long*>(moves + offset),
+                                       StoreMask[storeCount - 1], extMoves);
+        };
+
+        write(0, _mm256_permute2x128_si256(lo, hi, 0x20));
+        write(4, _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+};
+#endif
+
+#ifdef USE_AVX2
+// Gather eight 16-bit history entries by element index and sign-extend them
+// to 32 bits. AVX2 has no 16-bit gather, so load the aligned dword containing
+// each entry and shift the wanted half into place; the partner entry always
+// lives in the same table row, so the load stays in bounds.
+static __m256i gather_history8(const void* base, __m256i idx) {
+    const __m256i dwords = _mm256_i32gather_epi32(static_cast<const int*>(base),
+                                                  _mm256_srli_epi32(idx, 1), 4);
+    const __m256i shift  = _mm256_slli_epi32(_mm256_and_si256(idx, _mm256_set1_epi32(1)), 4);
+    return _mm256_srai_epi32(_mm256_slli_epi32(_mm256_srlv_epi32(dwords, shift), 16), 16);
+}
+
+// Gather eight 8-bit mirror entries by element index and sign-extend them to
+// 32 bits: load the dword starting at each entry's byte address and keep the
+// low byte. The mirror is followed in-struct by the full-precision table, so
+// the 3-byte overread of the last entry stays in bounds.
+static __m256i gather_mirror8(const i8* base, __m256i idx) {
+    const __m256i dwords =
+      _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), idx, 1);
+    return _mm256_srai_epi32(_mm256_slli_epi32(dwords, 24), 24);
+}
 #endif
 
 // Sort moves in descending order up to and including a given limit.
@@ -111,7 +217,7 @@ struct MoveSorter {
 void partial_insertion_sort(ExtMove* begin, ExtMove* end, int limit) {
     ExtMove *sortedEnd = begin, *p = begin + 1;
 
-#ifdef USE_AVX512ICL
+#if defined(USE_AVX512ICL) || defined(USE_AVX2)
     if (begin == end)
         return;
 
@@ -149,7 +255,7 @@ void partial_insertion_sort(ExtMove* begin, ExtMove* end, int limit) {
 // to decide which class of moves to emit, to help sorting the (presumably)
 // good moves first, and how important move ordering is at the current node.
 
-// MovePicker constructor for the main search and for the quiescence search
+// MovePicker constructor for the main search
 MovePicker::MovePicker(const Position&              p,
                        Move                         ttm,
                        Depth                        d,
@@ -158,29 +264,41 @@ MovePicker::MovePicker(const Position&              p,
                        const CapturePieceToHistory* cph,
                        const PieceToHistory**       ch,
                        const SharedHistories*       sh,
-                       int                          pl) :
+                       int                          pl,
+                       const TranspositionTable*    tt_,
+                       NumaIndex                    ttNode_) :
     pos(p),
     mainHistory(mh),
     lowPlyHistory(lph),
     captureHistory(cph),
     continuationHistory(ch),
     sharedHistory(sh),
+    tt(tt_),
+    ttNode(ttNode_),
     ttMove(ttm),
     depth(d),
     ply(pl) {
+    assert(depth > 0);
 
     if (pos.checkers())
         stage = EVASION_TT + !(ttm && pos.pseudo_legal(ttm));
 
     else
-        stage = (depth > 0 ? MAIN_TT : QSEARCH_TT) + !(ttm && pos.pseudo_legal(ttm));
+        stage = MAIN_TT + !(ttm && pos.pseudo_legal(ttm));
 }
 
 // MovePicker constructor for ProbCut: we generate captures with Static Exchange
 // Evaluation (SEE) greater than or equal to the given threshold.
-MovePicker::MovePicker(const Position& p, Move ttm, int th, const CapturePieceToHistory* cph) :
+MovePicker::MovePicker(const Position&              p,
+                       Move                         ttm,
+                       int                          th,
+                       const CapturePieceToHistory* cph,
+                       const TranspositionTable*    tt_,
+                       NumaIndex                    ttNode_) :
     pos(p),
     captureHistory(cph),
+    tt(tt_),
+    ttNode(ttNode_),
     ttMove(ttm),
     threshold(th) {
     assert(!pos.checkers());
@@ -209,6 +327,12 @@ ExtMove* MovePicker::score(const MoveList<Type>& ml) {
         threatByLesser[KING]  = 0;
     }
 
+#ifdef USE_AVX2
+    // Gather indices for the vectorized QUIETS history accumulation below
+    [[maybe_unused]] alignas(32) i32 rawIdx[MAX_MOVES + 8];
+    [[maybe_unused]] alignas(32) i32 pcToIdx[MAX_MOVES + 8];
+#endif
+
     ExtMove* it = cur;
     for (auto move : ml)
     {
@@ -227,14 +351,23 @@ ExtMove* MovePicker::score(const MoveList<Type>& ml) {
 
         else if constexpr (Type == QUIETS)
         {
+#ifdef USE_AVX2
+            // The history terms are gathered eight moves at a time after this
+            // loop; here only the gather indices are recorded.
+            const usize n = usize(it - cur) - 1;
+            rawIdx[n]     = m.raw();
+            pcToIdx[n]    = int(pc) * SQUARE_NB + to;
+            m.value       = 0;
+#else
             // histories
             m.value = 2 * (*mainHistory)[us][m.raw()];
-            m.value += 2 * sharedHistory->pawn_entry(pos)[pc][to];
-            m.value += (*continuationHistory[0])[pc][to];
-            m.value += (*continuationHistory[1])[pc][to];
-            m.value += (*continuationHistory[2])[pc][to];
-            m.value += (*continuationHistory[3])[pc][to];
-            m.value += (*continuationHistory[5])[pc][to];
+            m.value += 2 * sharedHistory->pawn_entry(pos).read(pc, to);
+            m.value += continuationHistory[0]->read(pc, to);
+            m.value += continuationHistory[1]->read(pc, to);
+            m.value += continuationHistory[2]->read(pc, to);
+            m.value += continuationHistory[3]->read(pc, to);
+            m.value += continuationHistory[5]->read(pc, to);
+#endif
 
             // bonus for checks
             m.value += ((pos.check_squares(pt) & to) && pos.see_ge(m, -75)) * 16384;
@@ -257,6 +390,49 @@ ExtMove* MovePicker::score(const MoveList<Type>& ml) {
                 m.value = (*mainHistory)[us][m.raw()] + (*continuationHistory[0])[pc][to];
         }
     }
+
+#ifdef USE_AVX2
+    if constexpr (Type == QUIETS)
+    {
+        // Accumulate the history terms eight moves at a time: one 32-bit
+        // gather per table, with the per-move scalar terms already in place
+        // from the loop above.
+        const auto& pawnTable = sharedHistory->pawn_entry(pos);
+
+        const void* mainBase    = &(*mainHistory)[us][0];
+        const i8*   pawnBase    = pawnTable.mirror_data();
+        const i8*   contBase[5] = {
+          continuationHistory[0]->mirror_data(), continuationHistory[1]->mirror_data(),
+          continuationHistory[2]->mirror_data(), continuationHistory[3]->mirror_data(),
+          continuationHistory[5]->mirror_data()};
+
+        const isize count = it - cur;
+        for (isize n = count; n & 7; ++n)
+            rawIdx[n] = pcToIdx[n] = 0;
+
+        alignas(32) i32 out[8];
+        for (isize i = 0; i < count; i += 8)
+        {
+            const __m256i raw  = _mm256_load_si256(reinterpret_cast<const __m256i*>(rawIdx + i));
+            const __m256i pcTo = _mm256_load_si256(reinterpret_cast<const __m256i*>(pcToIdx + i));
+
+            const __m256i pawn =
+              _mm256_slli_epi32(gather_mirror8(pawnBase, pcTo), SharedHistoryRegion::PawnSlot::QuantShift);
+            __m256i v =
+              _mm256_slli_epi32(_mm256_add_epi32(gather_history8(mainBase, raw), pawn), 1);
+
+            __m256i contSum = _mm256_setzero_si256();
+            for (const i8* base : contBase)
+                contSum = _mm256_add_epi32(contSum, gather_mirror8(base, pcTo));
+            v = _mm256_add_epi32(v, _mm256_slli_epi32(contSum, PieceToHistory::QuantShift));
+
+            _mm256_store_si256(reinterpret_cast<__m256i*>(out), v);
+            for (isize j = 0; j < 8 && i + j < count; ++j)
+                cur[i + j].value += out[j];
+        }
+    }
+#endif
+
     return it;
 }
 
@@ -267,16 +443,30 @@ Move MovePicker::select(Pred filter) {
 
     for (; cur < endCur; ++cur)
         if (*cur != ttMove && filter())
+        {
+            prefetch_child(*cur);
             return *cur++;
+        }
 
     return Move::none();
 }
 
+// Start pulling in the child's TT cluster for a move we are about to emit, so
+// that the probe at the top of the child's search overlaps the caller's
+// pruning checks and the make-move work instead of stalling on DRAM.
+// Worker::do_move prefetches again right before the move is made, which
+// also covers the moves that do not come from a MovePicker.
+void MovePicker::prefetch_child(Move m) const {
+    prefetch(tt->first_entry(pos.prefetch_key(m), ttNode));
+}
+
 // This is the most important method of the MovePicker class. We emit one
 // new pseudo-legal move on every call until there are no more moves left,
 // picking the move with the highest score from a list of generated moves.
 Move MovePicker::next_move() {
 
+    PROFILE_SCOPE(MovePick);
+
     constexpr int goodQuietThreshold = -14000;
 top:
     switch (stage)
@@ -284,14 +474,13 @@ top:
 
     case MAIN_TT :
     case EVASION_TT :
-    case QSEARCH_TT :
     case PROBCUT_TT :
         ++stage;
+        prefetch_child(ttMove);
         return ttMove;
 
     case CAPTURE_INIT :
-    case PROBCUT_INIT :
-    case QCAPTURE_INIT : {
+    case PROBCUT_INIT : {
         MoveList<CAPTURES> ml(pos);
 
         cur = endBadCaptures = moves;
@@ -367,7 +556,6 @@ top:
     }
 
     case EVASION :
-    case QCAPTURE :
         return select([]() { return true; });
 
     case PROBCUT :
@@ -380,4 +568,112 @@ top:
 
 void MovePicker::skip_quiet_moves() { skipQuiets = true; }
 
+
+// QMovePicker constructor for the quiescence search
+QMovePicker::QMovePicker(const Position&              p,
+                         Move                         ttm,
+                         const ButterflyHistory*      mh,
+                         const CapturePieceToHistory* cph,
+                         const PieceToHistory*        ch,
+                         const TranspositionTable*    tt_,
+                         NumaIndex                    ttNode_,
+                         Value                        victimTh,
+                         Square                       recapSq) :
+    pos(p),
+    mainHistory(mh),
+    captureHistory(cph),
+    continuationHistory(ch),
+    tt(tt_),
+    ttNode(ttNode_),
+    ttMove(ttm),
+    victimThreshold(victimTh),
+    recaptureSq(recapSq) {
+
+    stage = (pos.checkers() ? QEVASION_TT : QSEARCH_TT) + !(ttm && pos.pseudo_legal(ttm));
+}
+
+// Emits the remaining generated moves in score order, skipping the TT move
+Move QMovePicker::select() {
+
+    for (; cur < endCur; ++cur)
+        if (*cur != ttMove)
+        {
+            prefetch_child(*cur);
+            return *cur++;
+        }
+
+    return Move::none();
+}
+
+// See MovePicker::prefetch_child()
+void QMovePicker::prefetch_child(Move m) const {
+    prefetch(tt->first_entry(pos.prefetch_key(m), ttNode));
+}
+
+Move QMovePicker::next_move() {
+
+    PROFILE_SCOPE(MovePick);
+
+    switch (stage)
+    {
+
+    case QSEARCH_TT :
+    case QEVASION_TT :
+        ++stage;
+        prefetch_child(ttMove);
+        return ttMove;
+
+    case QCAPTURE_INIT : {
+        // qsearch hands its futility bound down so captures it would prune
+        // anyway are never generated, scored or sorted in the first place
+        MoveList<CAPTURES> ml(pos, victimThreshold, recaptureSq);
+
+        cur = endCur = moves;
+        for (Move m : ml)
+        {
+            ExtMove& em = *endCur++;
+            em          = m;
+
+            const Piece capturedPiece = pos.piece_on(m.to_sq());
+            em.value = (*captureHistory)[pos.moved_piece(m)][m.to_sq()][type_of(capturedPiece)]
+                     + 7 * int(PieceValue[capturedPiece]);
+        }
+
+        partial_insertion_sort(cur, endCur, std::numeric_limits<int>::min());
+        ++stage;
+        [[fallthrough]];
+    }
+
+    case QCAPTURE :
+        return select();
+
+    case QEVASION_INIT : {
+        MoveList<EVASIONS> ml(pos);
+
+        cur = endCur = moves;
+        for (Move m : ml)
+        {
+            ExtMove& em = *endCur++;
+            em          = m;
+
+            if (pos.capture_stage(m))
+                em.value = PieceValue[pos.piece_on(m.to_sq())] + (1 << 28);
+            else
+                em.value = (*mainHistory)[pos.side_to_move()][m.raw()]
+                         + (*continuationHistory)[pos.moved_piece(m)][m.to_sq()];
+        }
+
+        partial_insertion_sort(cur, endCur, std::numeric_limits<int>::min());
+        ++stage;
+        [[fallthrough]];
+    }
+
+    case QEVASION :
+        return select();
+    }
+
+    assert(false);
+    return Move::none();  // Silence warning
+}
+
 }  // namespace Stockfish
@@ -21,11 +21,13 @@
 
 #include "history.h"
 #include "movegen.h"
+#include "numa.h"
 #include "types.h"
 
 namespace Stockfish {
 
 class Position;
+class TranspositionTable;
 
 // The MovePicker class is used to pick one pseudo-legal move at a time from the
 // current position. The most important method is next_move(), which emits one
@@ -46,8 +48,11 @@ class MovePicker {
                const CapturePieceToHistory*,
                const PieceToHistory**,
                const SharedHistories*,
-               int);
-    MovePicker(const Position&, Move, int, const CapturePieceToHistory*);
+               int,
+               const TranspositionTable*,
+               NumaIndex);
+    MovePicker(
+      const Position&, Move, int, const CapturePieceToHistory*, const TranspositionTable*, NumaIndex);
     Move next_move();
     void skip_quiet_moves();
 
@@ -56,6 +61,7 @@ class MovePicker {
     Move select(Pred);
     template<GenType T>
     ExtMove* score(const MoveList<T>&);
+    void prefetch_child(Move m) const;
 
     const Position&              pos;
     const ButterflyHistory*      mainHistory;
@@ -63,6 +69,8 @@ class MovePicker {
     const CapturePieceToHistory* captureHistory;
     const PieceToHistory**       continuationHistory;
     const SharedHistories*       sharedHistory;
+    const TranspositionTable*    tt;
+    NumaIndex                    ttNode;
     Move                         ttMove;
     ExtMove *                    cur, *endCur, *endBadCaptures, *endCaptures, *endGenerated;
     int                          stage;
@@ -73,6 +81,46 @@ class MovePicker {
     ExtMove                      moves[MAX_MOVES];
 };
 
+// QMovePicker is the quiescence search counterpart of MovePicker: the TT move,
+// then captures, or evasions when in check. Quiescence nodes never emit scored
+// quiets, so this picker knows nothing about the quiet-move history machinery;
+// capture ordering needs only the capture history and evasion ordering the
+// butterfly table plus one continuation table. That keeps construction cheap
+// and the per-node working set small enough to stay in L1 across the move loop.
+class QMovePicker {
+
+   public:
+    QMovePicker(const QMovePicker&)            = delete;
+    QMovePicker& operator=(const QMovePicker&) = delete;
+    QMovePicker(const Position&,
+                Move,
+                const ButterflyHistory*,
+                const CapturePieceToHistory*,
+                const PieceToHistory*,
+                const TranspositionTable*,
+                NumaIndex,
+                Value  = VALUE_ZERO,  // victim-value threshold,
+                Square = SQ_NONE);    // see generate_captures()
+    Move next_move();
+
+   private:
+    Move select();
+    void prefetch_child(Move m) const;
+
+    const Position&              pos;
+    const ButterflyHistory*      mainHistory;
+    const CapturePieceToHistory* captureHistory;
+    const PieceToHistory*        continuationHistory;
+    const TranspositionTable*    tt;
+    NumaIndex                    ttNode;
+    Move                         ttMove;
+    Value                        victimThreshold;
+    Square                       recaptureSq;
+    int                          stage;
+    ExtMove *                    cur, *endCur;
+    ExtMove                      moves[MAX_MOVES];
+};
+
 }  // namespace Stockfish
 
 #endif  // #ifndef MOVEPICK_H_INCLUDED
@@ -248,14 +248,45 @@ void FullThreats::append_active_indices(Color perspective, const Position& pos,
             }
         }
 
-        for (PieceType pt = KNIGHT; pt < KING; ++pt)
         {
-            Piece    attacker = make_piece(c, pt);
-            Bitboard bb       = pos.pieces(c, pt);
+            const Piece attacker = make_piece(c, KNIGHT);
+            Bitboard    bb       = pos.pieces(c, KNIGHT);
             while (bb)
             {
                 Square   from    = pop_lsb(bb);
-                Bitboard attacks = Attacks::attacks_bb(pt, from, occupied) & occupied;
+                Bitboard attacks = Attacks::attacks_bb<KNIGHT>(from, occupied) & occupied;
+                while (attacks)
+                {
+                    Square    to       = pop_lsb(attacks);
+                    Piece     attacked = pos.piece_on(to);
+                    IndexType index    = make_index(perspective, attacker, from, to, attacked, ksq);
+                    active.push_back_if_lt(index, Dimensions);
+                }
+            }
+        }
+
+        {
+            // All of this color's sliders are computed in one batched pass
+            // (see Attacks::all_slider_attacks); queens reuse the bishop and
+            // rook boards of the same pass instead of a second lookup.
+            const Bitboard                sliders = pos.pieces(c, BISHOP, ROOK, QUEEN);
+            std::pair<Bitboard, Bitboard> boards[16];
+            Attacks::all_slider_attacks(sliders, occupied, boards);
+
+            const std::pair<Bitboard, Bitboard>* board = boards;
+
+            Bitboard bb = sliders;
+            while (bb)
+            {
+                Square    from     = pop_lsb(bb);
+                PieceType pt       = type_of(pos.piece_on(from));
+                Piece     attacker = make_piece(c, pt);
+                Bitboard  attacks  = (pt == BISHOP ? board->first
+                                      : pt == ROOK ? board->second
+                                                   : board->first | board->second)
+                                  & occupied;
+                ++board;
+
                 while (attacks)
                 {
                     Square    to       = pop_lsb(attacks);
@@ -210,6 +210,11 @@ class AffineTransform {
             using vec_t = __m128i;
         #define vec_set_32 _mm_set1_epi32
         #define vec_add_dpbusd_32 SIMD::m128_add_dpbusd_epi32
+    #elif defined(USE_SVE2)
+            using vec_t = SIMD::sve_vec_i32_t;
+        #define vec_set_32 svdup_n_s32
+        #define vec_add_dpbusd_32(acc, a, b) \
+            SIMD::sve2_add_dpbusd_epi32(acc, svreinterpret_s8_s32(a), svreinterpret_s8_s32(b))
     #elif defined(USE_NEON_DOTPROD)
             using vec_t = int32x4_t;
         #define vec_set_32 vdupq_n_s32
@@ -300,6 +305,12 @@ class AffineTransform {
         #define vec_setzero() _mm_setzero_si128()
         #define vec_add_dpbusd_32 SIMD::m128_add_dpbusd_epi32
         #define vec_hadd SIMD::m128_hadd
+    #elif defined(USE_SVE2)
+            using vec_t = SIMD::sve_vec_i32_t;
+        #define vec_setzero() vec_t(svdup_n_s32(0))
+        #define vec_add_dpbusd_32(acc, a, b) \
+            SIMD::sve2_add_dpbusd_epi32(acc, svreinterpret_s8_s32(a), svreinterpret_s8_s32(b))
+        #define vec_hadd SIMD::sve2_hadd
     #elif defined(USE_NEON_DOTPROD)
             using vec_t = int32x4_t;
         #define vec_setzero() vdupq_n_s32(0)
@@ -139,6 +139,11 @@ class AffineTransformSparseInput {
         using outvec_t = __m128i;
         #define vec_set_32 _mm_set1_epi32
         #define vec_add_dpbusd_32 SIMD::m128_add_dpbusd_epi32
+    #elif defined(USE_SVE2)
+        using invec_t  = SIMD::sve_vec_i8_t;
+        using outvec_t = SIMD::sve_vec_i32_t;
+        #define vec_set_32(a) svreinterpret_s8_s32(svdup_n_s32(a))
+        #define vec_add_dpbusd_32 SIMD::sve2_add_dpbusd_epi32
     #elif defined(USE_NEON_DOTPROD)
         using invec_t  = int8x16_t;
         using outvec_t = int32x4_t;
@@ -169,6 +174,8 @@ class AffineTransformSparseInput {
         constexpr IndexType NumRegs =
     #if defined(USE_VNNI) && defined(USE_AVX512)
           3 * NumAccums;
+    #elif defined(USE_VNNI)
+          2 * NumAccums;
     #else
           NumAccums;
     #endif
@@ -226,6 +233,11 @@ class AffineTransformSparseInput {
     #else
         static_assert(InputDimensions % 256 == 0);
 
+        #if defined(USE_VNNI)
+        for (IndexType k = NumAccums; k < NumRegs; ++k)
+            acc[k] = vec_set_32(0);
+        #endif
+
         for (IndexType k = 0; k < InputDimensions / 256; ++k)
         {
             u64   bits = load_as<u64>(nnzInfo.bitset + k * 8);
@@ -248,6 +260,37 @@ class AffineTransformSparseInput {
             asm("" : "+r"(base_addr), "+r"(weights_base));  // opt barrier
         #endif
 
+        #if defined(USE_VNNI)
+            // dpbusd accumulates in place, making every register a multi-cycle
+            // loop-carried dependency. Feed two nonzero blocks per iteration
+            // into separate accumulator halves, mirroring the three-way chain
+            // split of the AVX-512 VNNI path above.
+            while (bits)
+            {
+                const isize i0   = pop_lsb(bits);
+                const auto  col0 = reinterpret_cast<const invec_t*>(
+                  &weights_base[i0 * OutputDimensions * ChunkSize]);
+                const invec_t in0 = vec_set_32(load_as<i32>(base_addr + i0 * sizeof(i32)));
+
+                if (!bits)
+                {
+                    for (IndexType l = 0; l < NumAccums; ++l)
+                        vec_add_dpbusd_32(acc[l], in0, col0[l]);
+                    break;
+                }
+
+                const isize i1   = pop_lsb(bits);
+                const auto  col1 = reinterpret_cast<const invec_t*>(
+                  &weights_base[i1 * OutputDimensions * ChunkSize]);
+                const invec_t in1 = vec_set_32(load_as<i32>(base_addr + i1 * sizeof(i32)));
+
+                for (IndexType l = 0; l < NumAccums; ++l)
+                {
+                    vec_add_dpbusd_32(acc[l], in0, col0[l]);
+                    vec_add_dpbusd_32(acc[l + NumAccums], in1, col1[l]);
+                }
+            }
+        #else
             while (bits)
             {
                 isize       i          = pop_lsb(bits);
@@ -264,7 +307,13 @@ class AffineTransformSparseInput {
                 for (IndexType l = 0; l < NumAccums; ++l)
                     vec_add_dpbusd_32(acc[l], in, col[l]);
             }
+        #endif
         }
+
+        #if defined(USE_VNNI)
+        for (IndexType k = 0; k < NumAccums; ++k)
+            acc[k] = vec_add_32(acc[k], acc[k + NumAccums]);
+        #endif
     #endif
         outvec_t* outptr = reinterpret_cast<outvec_t*>(output);
         for (IndexType k = 0; k < NumAccums; ++k)
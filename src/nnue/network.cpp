@@ -34,9 +34,17 @@
 #include "../types.h"
 #include "nnue_architecture.h"
 #include "nnue_common.h"
+#include "nnue_compress.h"
 #include "nnue_misc.h"
 #include "nnz_helper.h"
 
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 // Macro to embed the default efficiently updatable neural network (NNUE) file
 // data in the engine binary (using incbin.h, by Dale Weiler).
 // This macro invocation will declare the following three variables
@@ -45,7 +53,13 @@
 //     const unsigned int         gEmbeddedNNUESize;    // the size of the embedded file
 // Note that this does not work in Microsoft Visual Studio.
 #if !defined(UNIVERSAL_BINARY) && !defined(_MSC_VER) && !defined(NNUE_EMBEDDING_OFF)
+    #if defined(NNUE_EMBED_COMPRESSED)
+// A compressed container produced by 'compressnet', unpacked at startup
+// (see nnue_compress.h); load_internal() keys on the container magic
+INCBIN(EmbeddedNNUE, EvalFileDefaultName ".sfnc");
+    #else
 INCBIN(EmbeddedNNUE, EvalFileDefaultName);
+    #endif
 #elif defined(UNIVERSAL_BINARY_MACOS_X86_SLICE)
 // Determined at runtime, see universal/nnue_embed.cpp
 extern const unsigned char* const gEmbeddedNNUEData;
@@ -84,6 +98,19 @@ bool write_parameters(std::ostream& stream, const T& reference) {
 
 }  // namespace Detail
 
+namespace {
+
+// C++ way to prepare a buffer for a memory stream
+class MemoryBuffer: public std::basic_streambuf<char> {
+   public:
+    MemoryBuffer(char* p, usize n) {
+        setg(p, p, p + n);
+        setp(p, p + n);
+    }
+};
+
+}
+
 void Network::load(const std::string& rootDirectory, std::string evalfilePath) {
 #if defined(DEFAULT_NNUE_DIRECTORY)
     std::vector<std::string> dirs = {"<internal>", "", rootDirectory,
@@ -158,6 +185,59 @@ NetworkOutput Network::evaluate(const Position&    pos,
 }
 
 
+Value Network::evaluate_psqt(const Position&    pos,
+                             AccumulatorStack&  accumulatorStack,
+                             AccumulatorCaches& cache) const {
+
+    const int bucket = (pos.count<ALL_PIECES>() - 1) / 4;
+    return static_cast<Value>(
+      featureTransformer.transform_psqt(pos, accumulatorStack, cache, bucket) / OutputScale);
+}
+
+
+void Network::evaluate_batch(const Position* const* positions,
+                             usize                  count,
+                             AccumulatorStack&      accumulatorStack,
+                             AccumulatorCaches&     cache,
+                             NetworkOutput*         outputs) const {
+
+    // Transformed features for the whole batch, laid out side by side
+    struct alignas(CacheLineSize) FeatureBuffer {
+        TransformedFeatureType data[FeatureTransformer::BufferSize];
+    };
+
+    auto transformedFeatures = make_unique_aligned<FeatureBuffer[]>(count);
+    std::vector<NNZInfo<L1>> nnzInfo(count);
+    std::vector<i32>         psqt(count);
+    std::vector<int>         bucket(count);
+
+    ASSERT_ALIGNED(transformedFeatures.get(), CacheLineSize);
+
+    for (usize i = 0; i < count; ++i)
+    {
+        const Position& pos = *positions[i];
+
+        // Positions are independent, so restart the stack instead of pushing
+        accumulatorStack.reset();
+
+        bucket[i] = (pos.count<ALL_PIECES>() - 1) / 4;
+        psqt[i]   = featureTransformer.transform(pos, accumulatorStack, cache,
+                                                 transformedFeatures[i].data, bucket[i], nnzInfo[i]);
+    }
+
+    // Propagate bucket by bucket, keeping one layer stack's weights hot
+    // across all positions that use it
+    for (int b = 0; b < int(LayerStacks); ++b)
+        for (usize i = 0; i < count; ++i)
+            if (bucket[i] == b)
+            {
+                const auto positional = network[b].propagate(transformedFeatures[i].data, nnzInfo[i]);
+                outputs[i]            = {static_cast<Value>(psqt[i] / OutputScale),
+                                         static_cast<Value>(positional / OutputScale)};
+            }
+}
+
+
 void Network::verify(std::string                                  evalfilePath,
                      const std::function<void(std::string_view)>& f) const {
     if (evalfilePath.empty())
@@ -226,8 +306,19 @@ NnueEvalTrace Network::trace_evaluate(const Position&    pos,
 
 
 void Network::load_user_net(const std::string& dir, const std::string& evalfilePath) {
-    std::ifstream stream(dir + evalfilePath, std::ios::binary);
-    auto          description = load(stream);
+    std::optional<std::string> description;
+
+#ifndef _WIN32
+    // Preferred path: map the file and parse it in place, instead of pulling
+    // it through buffered stream reads into temporary storage
+    description = load_mapped(dir + evalfilePath);
+#endif
+
+    if (!description.has_value())
+    {
+        std::ifstream stream(dir + evalfilePath, std::ios::binary);
+        description = load(stream);
+    }
 
     if (description.has_value())
     {
@@ -237,23 +328,74 @@ void Network::load_user_net(const std::string& dir, const std::string& evalfileP
 }
 
 
-void Network::load_internal() {
-    // C++ way to prepare a buffer for a memory stream
-    class MemoryBuffer: public std::basic_streambuf<char> {
-       public:
-        MemoryBuffer(char* p, usize n) {
-            setg(p, p, p + n);
-            setp(p, p + n);
-        }
-    };
+#ifndef _WIN32
+
+// Zero-copy load of an external net: the file is mapped read-only and the
+// parse validates and consumes it straight from the mapping, so the file
+// content is never duplicated into a userspace buffer. MAP_POPULATE prefaults
+// the whole mapping with sequential readahead up front, which is much faster
+// than taking one page fault per read while the parse walks the file.
+std::optional<std::string> Network::load_mapped(const std::string& path) {
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return std::nullopt;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return std::nullopt;
+    }
+
+    const usize size  = usize(st.st_size);
+    int         flags = MAP_PRIVATE;
+    #ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+    #endif
+
+    void* data = mmap(nullptr, size, PROT_READ, flags, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        return std::nullopt;
+
+    #ifndef MAP_POPULATE
+    madvise(data, size, MADV_SEQUENTIAL);
+    #endif
 
+    MemoryBuffer buffer(static_cast<char*>(data), size);
+    std::istream stream(&buffer);
+    auto         description = load(stream);
+
+    munmap(data, size);
+    return description;
+}
+
+#endif
+
+
+void Network::load_internal() {
 #ifdef UNIVERSAL_BINARY_MACOS_X86_SLICE
     if (gEmbeddedNNUEData == nullptr)  // failed embedded load
         return;
 #endif
 
-    MemoryBuffer buffer(const_cast<char*>(reinterpret_cast<const char*>(gEmbeddedNNUEData)),
-                        usize(gEmbeddedNNUESize));
+    const char* netData = reinterpret_cast<const char*>(gEmbeddedNNUEData);
+    usize       netSize = usize(gEmbeddedNNUESize);
+
+    // A compressed embedded blob is unpacked into hugepage-backed memory
+    // first; the buffer only lives until the parameters have been parsed,
+    // since the Network object itself is the NUMA replication source
+    LargePagePtr<char[]> unpacked;
+    if (Compress::is_compressed(gEmbeddedNNUEData, netSize))
+    {
+        unpacked = Compress::decompress(gEmbeddedNNUEData, netSize, netSize);
+        if (!unpacked)
+            return;
+        netData = unpacked.get();
+    }
+
+    MemoryBuffer buffer(const_cast<char*>(netData), netSize);
 
     std::istream stream(&buffer);
     auto         description = load(stream);
@@ -67,6 +67,22 @@ class Network {
                            AccumulatorStack&  accumulatorStack,
                            AccumulatorCaches& cache) const;
 
+    // Cheap first evaluation tier: only the PSQT half of the network, read
+    // straight out of the accumulator without running the layer stacks.
+    Value evaluate_psqt(const Position&    pos,
+                        AccumulatorStack&  accumulatorStack,
+                        AccumulatorCaches& cache) const;
+
+    // Evaluates a batch of independent positions for throughput-oriented
+    // workloads. All transformed features are produced first into one
+    // contiguous buffer, then the output layers run over the batch grouped by
+    // layer-stack bucket, so each bucket's weights are loaded once per batch
+    // instead of once per position.
+    void evaluate_batch(const Position* const* positions,
+                        usize              count,
+                        AccumulatorStack&  accumulatorStack,
+                        AccumulatorCaches& cache,
+                        NetworkOutput*     outputs) const;
 
     void verify(std::string evalfilePath, const std::function<void(std::string_view)>&) const;
     NnueEvalTrace trace_evaluate(const Position&    pos,
@@ -76,6 +92,7 @@ class Network {
    private:
     void load_user_net(const std::string&, const std::string&);
     void load_internal();
+    std::optional<std::string> load_mapped(const std::string& path);
 
     void initialize();
 
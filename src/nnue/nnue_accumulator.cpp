@@ -19,9 +19,12 @@
 #include "nnue_accumulator.h"
 
 #include <cassert>
+#include <cstdlib>
+#include <iostream>
 #include <new>
 
 #include "../bitboard.h"
+#include "../memory.h"
 #include "../misc.h"
 #include "../position.h"
 #include "../types.h"
@@ -50,6 +53,23 @@ void update_accumulator_refresh_cache(Color                     perspective,
                                       AccumulatorCaches&        cache);
 }
 
+AccumulatorStack::AccumulatorStack() {
+    accumulators =
+      static_cast<AccumulatorState*>(lazy_commit_alloc(MaxSize * sizeof(AccumulatorState)));
+
+    if (!accumulators)
+    {
+        std::cerr << "Failed to allocate memory for the accumulator stack." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    reset();
+}
+
+AccumulatorStack::~AccumulatorStack() {
+    lazy_commit_free(accumulators, MaxSize * sizeof(AccumulatorState));
+}
+
 const AccumulatorState& AccumulatorStack::latest() const noexcept { return accumulators[size - 1]; }
 
 AccumulatorState& AccumulatorStack::mut_latest() noexcept { return accumulators[size - 1]; }
@@ -123,7 +143,7 @@ void AccumulatorStack::forward_update_incremental(Color                     pers
                                                   const FeatureTransformer& featureTransformer,
                                                   const usize               begin) noexcept {
 
-    assert(begin < accumulators.size());
+    assert(begin < MaxSize);
     assert(accumulators[begin].computed[perspective]);
 
     const Square ksq = pos.square<KING>(perspective);
@@ -140,7 +160,7 @@ void AccumulatorStack::backward_update_incremental(Color                     per
                                                    const FeatureTransformer& featureTransformer,
                                                    const usize               end) noexcept {
 
-    assert(end < accumulators.size());
+    assert(end < MaxSize);
     assert(end < size);
     assert(latest().computed[perspective]);
 
@@ -210,7 +230,7 @@ void apply_combined(Color                              perspective,
             auto* column = reinterpret_cast<const vec_i8_t*>(
               &threatWeights[thrRemoved[i] * Dimensions + tileOff]);
 
-    #ifdef USE_NEON
+    #if defined(USE_NEON) && !defined(USE_SVE2)
             for (IndexType k = 0; k < Tiling::NumRegs; k += 2)
             {
                 acc[k]     = vsubw_s8(acc[k], vget_low_s8(column[k / 2]));
@@ -227,7 +247,7 @@ void apply_combined(Color                              perspective,
             auto* column =
               reinterpret_cast<const vec_i8_t*>(&threatWeights[thrAdded[i] * Dimensions + tileOff]);
 
-    #ifdef USE_NEON
+    #if defined(USE_NEON) && !defined(USE_SVE2)
             for (IndexType k = 0; k < Tiling::NumRegs; k += 2)
             {
                 acc[k]     = vaddw_s8(acc[k], vget_low_s8(column[k / 2]));
@@ -470,7 +490,7 @@ void update_accumulator_refresh_cache(Color                     perspective,
     using Tiling [[maybe_unused]] = SIMDTiling<Dimensions, Dimensions, PSQTBuckets>;
 
     const Square             ksq   = pos.square<KING>(perspective);
-    auto&                    entry = cache[ksq][perspective];
+    auto&                    entry = cache.entry(ksq, perspective, pos.material_key());
     PSQFeatureSet::IndexList removed, added;
 
     const Bitboard changedBB = get_changed_pieces(entry.pieces, pos.piece_array());
@@ -540,7 +560,7 @@ void update_accumulator_refresh_cache(Color                     perspective,
             auto* column =
               reinterpret_cast<const vec_i8_t*>(&threatWeights[active[i] * Dimensions + tileOff]);
 
-    #ifdef USE_NEON
+    #if defined(USE_NEON) && !defined(USE_SVE2)
             for (IndexType k = 0; k < Tiling::NumRegs; k += 2)
             {
                 acc[k]     = vaddw_s8(acc[k], vget_low_s8(column[k / 2]));
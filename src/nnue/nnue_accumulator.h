@@ -56,6 +56,13 @@ struct alignas(CacheLineSize) Accumulator {
 // efficiently update the accumulator, instead of rebuilding it from scratch.
 // This idea, was first described by Luecx (author of Koivisto) and
 // is commonly referred to as "Finny Tables".
+//
+// The cache persists across searches (it is only cleared on ucinewgame, see
+// Worker::clear) and is set-associative: each king square holds MaterialWays
+// entries selected by the position's material key, so the nearly identical
+// material configurations revisited by consecutive searches in a game keep
+// their own entries instead of overwriting a single one, and a refresh
+// usually finds a near-match needing only a small delta.
 struct AccumulatorCaches {
     template<typename Network>
     AccumulatorCaches(const Network& network) {
@@ -77,16 +84,21 @@ struct AccumulatorCaches {
         }
     };
 
+    static constexpr usize MaterialWays = 4;
+
     template<typename Network>
     void clear(const Network& network) {
-        for (auto& entries1D : entries)
-            for (auto& entry : entries1D)
-                entry.clear(network.featureTransformer.biases);
+        for (auto& entries2D : entries)
+            for (auto& entries1D : entries2D)
+                for (auto& entry : entries1D)
+                    entry.clear(network.featureTransformer.biases);
     }
 
-    std::array<Entry, COLOR_NB>& operator[](Square sq) { return entries[sq]; }
+    Entry& entry(Square ksq, Color perspective, Key materialKey) {
+        return entries[ksq][perspective][materialKey & (MaterialWays - 1)];
+    }
 
-    std::array<std::array<Entry, COLOR_NB>, SQUARE_NB> entries;
+    std::array<std::array<std::array<Entry, MaterialWays>, COLOR_NB>, SQUARE_NB> entries;
 };
 
 
@@ -99,6 +111,12 @@ class AccumulatorStack {
    public:
     static constexpr usize MaxSize = MAX_PLY + 1;
 
+    AccumulatorStack();
+    ~AccumulatorStack();
+
+    AccumulatorStack(const AccumulatorStack&)            = delete;
+    AccumulatorStack& operator=(const AccumulatorStack&) = delete;
+
     [[nodiscard]] const AccumulatorState& latest() const noexcept;
 
     void                                  reset() noexcept;
@@ -131,8 +149,14 @@ class AccumulatorStack {
                                      const FeatureTransformer& featureTransformer,
                                      const usize               end) noexcept;
 
-    std::array<AccumulatorState, MaxSize> accumulators;
-    usize                                 size = 1;
+    // Lazily committed storage (see lazy_commit_alloc): the full MaxSize
+    // range is only reserved, and physical pages appear page by page as the
+    // search depth first reaches them - first-touched by the owning worker
+    // thread after its NUMA binding, so they land node-local - then stay
+    // resident across searches. Entries hold no constructed state: reset()
+    // and push() initialize whatever a slot needs before it is read.
+    AccumulatorState* accumulators;
+    usize             size = 1;
 };
 
 }  // namespace Stockfish::Eval::NNUE
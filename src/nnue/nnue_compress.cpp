@@ -0,0 +1,314 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "nnue_compress.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "../numa.h"
+
+namespace Stockfish::Eval::NNUE::Compress {
+
+namespace {
+
+// Byte-oriented LZ scheme in the LZ4 block mould: a token carries a literal
+// run length and a match length in its nibbles (15 meaning "extended by
+// 255-bytes"), literals follow the token, then a 16-bit little-endian match
+// offset. The last sequence of a chunk is literals only.
+
+constexpr int   MinMatch  = 4;
+constexpr usize MaxOffset = 65535;
+
+u32 read_u32(const unsigned char* p) {
+    u32 v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+u64 read_u64(const unsigned char* p) {
+    u64 v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+void put_u32(std::vector<unsigned char>& out, u32 v) {
+    for (int i = 0; i < 4; ++i)
+        out.push_back((v >> 8 * i) & 0xFF);
+}
+
+void put_length(std::vector<unsigned char>& out, usize len) {
+    while (len >= 255)
+    {
+        out.push_back(255);
+        len -= 255;
+    }
+    out.push_back((unsigned char) (len));
+}
+
+// Fully bounds-checked chunk decoder; overlapping matches copy bytewise
+bool decode_chunk(const unsigned char* src, usize srcSize, char* dstRaw, usize dstSize) {
+    const unsigned char* srcEnd = src + srcSize;
+    unsigned char*       dst    = reinterpret_cast<unsigned char*>(dstRaw);
+    unsigned char*       out    = dst;
+    unsigned char*       dstEnd = dst + dstSize;
+
+    auto read_length = [&](usize base) -> usize {
+        usize len = base;
+        if (base == 15)
+            while (true)
+            {
+                if (src == srcEnd)
+                    return usize(-1);
+                unsigned char b = *src++;
+                len += b;
+                if (b != 255)
+                    break;
+            }
+        return len;
+    };
+
+    while (src < srcEnd)
+    {
+        const unsigned char token = *src++;
+
+        usize litLen = read_length(token >> 4);
+        if (litLen == usize(-1) || litLen > usize(srcEnd - src) || litLen > usize(dstEnd - out))
+            return false;
+        std::memcpy(out, src, litLen);
+        src += litLen;
+        out += litLen;
+
+        if (src == srcEnd)  // final literal-only sequence
+            break;
+
+        if (srcEnd - src < 2)
+            return false;
+        const usize offset = src[0] | (usize(src[1]) << 8);
+        src += 2;
+
+        usize matchLen = read_length(token & 15);
+        if (matchLen == usize(-1))
+            return false;
+        matchLen += MinMatch;
+
+        if (offset == 0 || offset > usize(out - dst) || matchLen > usize(dstEnd - out))
+            return false;
+
+        const unsigned char* from = out - offset;
+        while (matchLen--)
+            *out++ = *from++;
+    }
+
+    return out == dstEnd;
+}
+
+// Greedy single-pass encoder over a 4-byte hash table. Ratio is modest next
+// to zstd, but the decoder above stays a dependency-free page of code, which
+// is the point for a blob baked into the binary.
+void encode_chunk(const unsigned char* src, usize srcSize, std::vector<unsigned char>& out) {
+    constexpr int   HashBits = 16;
+    constexpr usize Margin   = 12;  // no matches in the tail, literals only
+
+    std::vector<u32> table(usize(1) << HashBits, 0);
+
+    auto hash_of = [&](const unsigned char* p) {
+        return (read_u32(p) * 2654435761u) >> (32 - HashBits);
+    };
+
+    const unsigned char* base       = src;
+    const unsigned char* end        = src + srcSize;
+    const unsigned char* matchLimit = srcSize > Margin ? end - Margin : base;
+    const unsigned char* anchor     = src;
+
+    auto emit = [&](const unsigned char* litEnd, usize matchLen, usize offset) {
+        const usize litLen = usize(litEnd - anchor);
+
+        out.push_back((unsigned char) (std::min<usize>(litLen, 15) << 4
+                                       | std::min<usize>(matchLen, 15)));
+        if (litLen >= 15)
+            put_length(out, litLen - 15);
+        out.insert(out.end(), anchor, litEnd);
+
+        if (matchLen || offset)
+        {
+            out.push_back(offset & 0xFF);
+            out.push_back((offset >> 8) & 0xFF);
+            if (matchLen >= 15)
+                put_length(out, matchLen - 15);
+        }
+    };
+
+    while (src < matchLimit)
+    {
+        const u32            h         = u32(hash_of(src));
+        const unsigned char* candidate = base + table[h];
+        table[h]                       = u32(src - base);
+
+        if (candidate < src && usize(src - candidate) <= MaxOffset
+            && read_u32(candidate) == read_u32(src))
+        {
+            usize len = MinMatch;
+            while (src + len < matchLimit && candidate[len] == src[len])
+                ++len;
+
+            emit(src, len - MinMatch, usize(src - candidate));
+            src += len;
+            anchor = src;
+        }
+        else
+            ++src;
+    }
+
+    // Final literals; recognized by the decoder as the sequence that
+    // exhausts the chunk
+    {
+        const usize litLen = usize(end - anchor);
+        out.push_back((unsigned char) (std::min<usize>(litLen, 15) << 4));
+        if (litLen >= 15)
+            put_length(out, litLen - 15);
+        out.insert(out.end(), anchor, end);
+    }
+}
+
+constexpr usize HeaderSize = 4 + 4 + 4 + 8;
+
+}  // namespace
+
+
+bool is_compressed(const unsigned char* data, usize size) {
+    return size >= HeaderSize && read_u32(data) == Magic && read_u32(data + 4) == Version;
+}
+
+
+LargePagePtr<char[]> decompress(const unsigned char* data, usize size, usize& rawSize) {
+    rawSize = 0;
+    if (!is_compressed(data, size))
+        return nullptr;
+
+    const usize chunkCount = read_u32(data + 8);
+    const u64   totalRaw   = read_u64(data + 12);
+
+    if (size < HeaderSize + chunkCount * 8 || chunkCount == 0
+        || totalRaw > usize(chunkCount) * ChunkSize)
+        return nullptr;
+
+    // Chunk descriptors and their offsets into source and destination
+    struct Chunk {
+        usize srcOff, srcSize, dstOff, dstSize;
+    };
+    std::vector<Chunk> chunks(chunkCount);
+
+    usize srcOff = HeaderSize + chunkCount * 8, dstOff = 0;
+    for (usize i = 0; i < chunkCount; ++i)
+    {
+        const unsigned char* d = data + HeaderSize + i * 8;
+        chunks[i]              = {srcOff, read_u32(d), dstOff, read_u32(d + 4)};
+        srcOff += chunks[i].srcSize;
+        dstOff += chunks[i].dstSize;
+        if (srcOff > size || chunks[i].dstSize > ChunkSize)
+            return nullptr;
+    }
+    if (dstOff != totalRaw)
+        return nullptr;
+
+    auto out = make_unique_large_page<char[]>(totalRaw);
+
+    // Fan the chunks out over a one-shot crew of threads; this runs once at
+    // startup, before the search thread pool exists
+    std::atomic<usize> next{0};
+    std::atomic<bool>  ok{true};
+
+    auto work = [&]() {
+        for (usize i; (i = next.fetch_add(1)) < chunkCount;)
+        {
+            const Chunk& c = chunks[i];
+            bool good = c.srcSize == c.dstSize  // stored chunk
+                        ? (std::memcpy(out.get() + c.dstOff, data + c.srcOff, c.dstSize), true)
+                        : decode_chunk(data + c.srcOff, c.srcSize, out.get() + c.dstOff, c.dstSize);
+            if (!good)
+                ok = false;
+        }
+    };
+
+    const usize threadCount = std::min<usize>({chunkCount, SYSTEM_THREADS_NB, 16});
+
+    std::vector<std::thread> crew;
+    for (usize t = 1; t < threadCount; ++t)
+        crew.emplace_back(work);
+    work();
+    for (auto& th : crew)
+        th.join();
+
+    if (!ok)
+        return nullptr;
+
+    rawSize = totalRaw;
+    return out;
+}
+
+
+bool compress_file(const std::string& source, const std::string& target) {
+    std::ifstream in(source, std::ios::binary);
+    if (!in)
+        return false;
+
+    std::vector<unsigned char> raw(std::istreambuf_iterator<char>(in), {});
+    if (raw.empty())
+        return false;
+
+    const usize chunkCount = (raw.size() + ChunkSize - 1) / ChunkSize;
+
+    std::vector<unsigned char> header, payload;
+    put_u32(header, Magic);
+    put_u32(header, Version);
+    put_u32(header, u32(chunkCount));
+    for (int i = 0; i < 8; ++i)
+        header.push_back((u64(raw.size()) >> 8 * i) & 0xFF);
+
+    for (usize i = 0; i < chunkCount; ++i)
+    {
+        const usize off      = i * ChunkSize;
+        const usize rawChunk = std::min(ChunkSize, raw.size() - off);
+
+        std::vector<unsigned char> packed;
+        encode_chunk(raw.data() + off, rawChunk, packed);
+
+        // Incompressible chunks are stored; the decoder keys on equal sizes
+        const bool stored = packed.size() >= rawChunk;
+
+        put_u32(header, u32(stored ? rawChunk : packed.size()));
+        put_u32(header, u32(rawChunk));
+
+        if (stored)
+            payload.insert(payload.end(), raw.begin() + isize(off),
+                           raw.begin() + isize(off + rawChunk));
+        else
+            payload.insert(payload.end(), packed.begin(), packed.end());
+    }
+
+    std::ofstream out(target, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(header.data()), isize(header.size()));
+    out.write(reinterpret_cast<const char*>(payload.data()), isize(payload.size()));
+    return bool(out);
+}
+
+}  // namespace Stockfish::Eval::NNUE::Compress
@@ -0,0 +1,63 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NNUE_COMPRESS_H_INCLUDED
+#define NNUE_COMPRESS_H_INCLUDED
+
+#include <string>
+
+#include "../memory.h"
+#include "../misc.h"
+
+namespace Stockfish::Eval::NNUE::Compress {
+
+// Self-contained compressed container for embedded networks. The payload is
+// cut into fixed-size chunks, each compressed independently with an
+// LZ4-style byte-oriented scheme (literal runs plus 64 KiB-window matches),
+// so decompression parallelizes across chunks with no library dependency.
+//
+// Layout, all fields little endian:
+//   u32 magic "SFNC" | u32 version | u32 chunkCount | u64 rawSize
+//   chunkCount x { u32 compressedSize, u32 rawSize }
+//   chunk payloads, back to back
+//
+// Deployment: compress the default net once with the engine's
+// 'compressnet <in> [out]' command (producing <in>.sfnc by default), then
+// build with EXTRACXXFLAGS=-DNNUE_EMBED_COMPRESSED to embed the container
+// instead of the raw file. Network::load_internal() detects the magic at
+// runtime, so a binary embedding a raw net keeps working unchanged.
+
+constexpr u32 Magic   = 0x434E4653;  // "SFNC"
+constexpr u32 Version = 1;
+
+// Chunk granularity of the container; the parallelism cap at decompression
+constexpr usize ChunkSize = 4 * 1024 * 1024;
+
+bool is_compressed(const unsigned char* data, usize size);
+
+// Decompresses a container into freshly allocated hugepage-backed memory,
+// fanning the chunks out over up to SYSTEM_THREADS_NB threads. Returns an
+// empty pointer (and rawSize 0) on a malformed or truncated container.
+LargePagePtr<char[]> decompress(const unsigned char* data, usize size, usize& rawSize);
+
+// Compresses a file into a container, used by the 'compressnet' command
+bool compress_file(const std::string& source, const std::string& target);
+
+}  // namespace Stockfish::Eval::NNUE::Compress
+
+#endif  // #ifndef NNUE_COMPRESS_H_INCLUDED
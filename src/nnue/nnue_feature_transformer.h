@@ -297,7 +297,7 @@ class FeatureTransformer {
 
                     static_assert(FtMaxVal == 255);
 
-    #if defined(USE_NEON)
+    #if defined(USE_NEON) && !defined(USE_SVE2)
                     uint16x8_t mul0 = vmull_u8(vqmovun_s16(acc0a), vqmovun_s16(acc1a));
                     uint16x8_t mul1 = vmull_u8(vqmovun_s16(acc0b), vqmovun_s16(acc1b));
 
@@ -362,6 +362,24 @@ class FeatureTransformer {
         return psqt;
     }  // end of function transform()
 
+    // PSQT-only variant of transform(): brings the accumulator up to date
+    // exactly like transform() would, but skips the clipped-ReLU output
+    // transform entirely. Used by the cheap first evaluation tier.
+    i32 transform_psqt(const Position&    pos,
+                       AccumulatorStack&  accumulatorStack,
+                       AccumulatorCaches& cache,
+                       int                bucket) const {
+
+        accumulatorStack.evaluate(pos, *this, cache);
+        const auto& accumulatorState = accumulatorStack.latest();
+
+        const Color perspectives[2]  = {pos.side_to_move(), ~pos.side_to_move()};
+        const auto& psqtAccumulation = accumulatorState.psqtAccumulation;
+        return (psqtAccumulation[perspectives[0]][bucket]
+                - psqtAccumulation[perspectives[1]][bucket])
+             / 2;
+    }
+
     alignas(CacheLineSize) std::array<BiasType, HalfDimensions> biases;
     alignas(
       CacheLineSize) std::array<WeightType, HalfDimensions * PSQFeatureSet::Dimensions> weights;
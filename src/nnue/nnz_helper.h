@@ -118,7 +118,7 @@ struct NNZInfo {
         void record2(SIMD::vec_t neurons1, SIMD::vec_t neurons2) {
             using namespace SIMD;
 
-        #ifdef USE_NEON
+        #if defined(USE_NEON) && !defined(USE_SVE2)
             alignas(16) static constexpr u16 Mask8[8] = {1, 16, 2, 32, 4, 64, 8, 128};
 
             uint32x4_t n1 = vreinterpretq_u32_s16(neurons1);
@@ -31,6 +31,11 @@
 #elif defined(USE_SSE2)
     #include <emmintrin.h>
 
+#elif defined(USE_SVE2)
+    #include <arm_neon.h>
+    #include <arm_neon_sve_bridge.h>
+    #include <arm_sve.h>
+
 #elif defined(USE_NEON)
     #include <arm_neon.h>
 
@@ -191,6 +196,73 @@ inline __m128i vec_convert_8_16(u64 x) {
     #define NumRegistersSIMD (Is64Bit ? 12 : 6)
     #define MaxChunkSize 16
 
+#elif USE_SVE2
+// The SVE ACLE types are sizeless, which rules out the arrays and
+// reinterpret_casts the tiled kernels are built on. We therefore compile
+// with -msve-vector-bits=256 (the vector length of Graviton 3/4 and
+// Neoverse V1/V2) and pin the types to that width, making them ordinary
+// 256-bit vector types like the ones of the other backends.
+static_assert(__ARM_FEATURE_SVE_BITS == 256, "SVE2 kernels assume -msve-vector-bits=256");
+
+typedef svint8_t sve_vec_i8_t __attribute__((arm_sve_vector_bits(__ARM_FEATURE_SVE_BITS)));
+typedef svint16_t sve_vec_i16_t __attribute__((arm_sve_vector_bits(__ARM_FEATURE_SVE_BITS)));
+typedef svint32_t sve_vec_i32_t __attribute__((arm_sve_vector_bits(__ARM_FEATURE_SVE_BITS)));
+typedef svuint32_t sve_vec_u32_t __attribute__((arm_sve_vector_bits(__ARM_FEATURE_SVE_BITS)));
+
+// Plain NEON helper types, still used by the 128-bit kernels that do not
+// go through vec_t (e.g. the clipped ReLU layers)
+using vec_i8x8_t __attribute__((may_alias))  = int8x8_t;
+using vec_i16x8_t __attribute__((may_alias)) = int16x8_t;
+using vec_i8x16_t __attribute__((may_alias)) = int8x16_t;
+using vec_u16x8_t __attribute__((may_alias)) = uint16x8_t;
+using vec_i32x4_t __attribute__((may_alias)) = int32x4_t;
+
+using vec_t                               = sve_vec_i16_t;
+using vec_i8_t __attribute__((may_alias)) = int8x16_t;
+using vec128_t __attribute__((may_alias)) = uint16x8_t;
+using psqt_vec_t                          = sve_vec_i32_t;
+using vec_uint_t                          = sve_vec_u32_t;
+    #define vec_load(a) (*(a))
+    #define vec_store(a, b) *(a) = (b)
+    #define vec_add_16(a, b) svadd_s16_x(svptrue_b16(), a, b)
+    #define vec_sub_16(a, b) svsub_s16_x(svptrue_b16(), a, b)
+    #define vec_mulhi_16(a, b) svmulh_s16_x(svptrue_b16(), a, b)
+    #define vec_zero() vec_t(svdup_n_s16(0))
+    #define vec_set_16(a) svdup_n_s16(i16(a))
+    #define vec_max_16(a, b) svmax_s16_x(svptrue_b16(), a, b)
+    #define vec_min_16(a, b) svmin_s16_x(svptrue_b16(), a, b)
+    #define vec_slli_16(a, b) svlsl_n_s16_x(svptrue_b16(), a, b)
+    // Narrow into the even byte lanes, then deinterleave: yields the two
+    // saturated halves back to back, so no load-time permutation is needed
+    #define vec_packus_16(a, b) \
+        svreinterpret_s16_u8(svuzp1_u8(svqxtunb_s16(a), svqxtunb_s16(b)))
+    #define vec_load_psqt(a) (*(a))
+    #define vec_store_psqt(a, b) *(a) = (b)
+    #define vec_add_psqt_32(a, b) svadd_s32_x(svptrue_b32(), a, b)
+    #define vec_sub_psqt_32(a, b) svsub_s32_x(svptrue_b32(), a, b)
+    #define vec_zero_psqt() psqt_vec_t(svdup_n_s32(0))
+
+inline int sve2_vec_nnz(vec_t a) {
+    const svbool_t nz = svcmpgt_n_s32(svptrue_b32(), svreinterpret_s32_s16(a), 0);
+    const sve_vec_u32_t bit =
+      svlsl_u32_x(svptrue_b32(), svdup_n_u32(1), svindex_u32(0, 1));
+    return int(svaddv_u32(nz, bit));
+}
+    #define vec_nnz(a) sve2_vec_nnz(a)
+
+inline vec_t vec_convert_8_16(vec_i8_t a) {
+    return svunpklo_s16(svset_neonq_s8(svundef_s8(), a));
+}
+
+    #define vec128_zero vdupq_n_u16(0)
+    #define vec128_set_16(a) vdupq_n_u16(a)
+    #define vec128_load(a) vld1q_u16(reinterpret_cast<const u16*>(a))
+    #define vec128_storeu(a, b) vst1q_u16(reinterpret_cast<u16*>(a), b)
+    #define vec128_add(a, b) vaddq_u16(a, b)
+
+    #define NumRegistersSIMD 24
+    #define MaxChunkSize 32
+
 #elif USE_NEON
 using vec_i8x8_t __attribute__((may_alias))  = int8x8_t;
 using vec_i16x8_t __attribute__((may_alias)) = int16x8_t;
@@ -519,6 +591,18 @@ dotprod_m128_add_dpbusd_epi32(int32x4_t& acc, int8x16_t a, int8x16_t b) {
 }
 #endif
 
+#if defined(USE_SVE2)
+
+[[maybe_unused]] static int sve2_hadd(sve_vec_i32_t sum, int bias) {
+    return int(svaddv_s32(svptrue_b32(), sum)) + bias;
+}
+
+[[maybe_unused]] static void sve2_add_dpbusd_epi32(sve_vec_i32_t& acc, sve_vec_i8_t a, sve_vec_i8_t b) {
+    acc = svdot_s32(acc, a, b);
+}
+
+#endif
+
 #if defined(USE_NEON)
 
 [[maybe_unused]] static int neon_m128_reduce_add_epi32(int32x4_t s) {
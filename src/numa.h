@@ -522,6 +522,82 @@ using NumaAutoPolicy = std::variant<SystemNumaPolicy, L3DomainsPolicy, BundledL3
 // As a special case, when performing system-wide replication of read-only data
 // (i.e., LazyNumaReplicatedSystemWide), the system NUMA node is used, rather than
 // custom or L3-aware nodes. See that class's get_discriminator() function.
+// Hybrid (heterogeneous) core topology, e.g. Intel P/E cores. On Linux the
+// kernel exposes the per-type processor lists of hybrid parts under
+// /sys/devices/cpu_core/cpus and /sys/devices/cpu_atom/cpus; on homogeneous
+// systems (or platforms without that interface) both sets stay empty and the
+// hybrid placement policy in ThreadPool::set disengages.
+struct HybridTopology {
+    std::set<CpuIndex> performanceCpus;
+    std::set<CpuIndex> efficiencyCpus;
+
+    bool is_hybrid() const { return !performanceCpus.empty() && !efficiencyCpus.empty(); }
+
+    static HybridTopology from_system() {
+        HybridTopology topo;
+
+#if defined(__linux__) && !defined(__ANDROID__)
+        auto read_cpu_list = [](const std::string& path, std::set<CpuIndex>& out) {
+            auto str = read_file_to_string(path);
+            if (!str.has_value())
+                return;
+
+            remove_whitespace(*str);
+            for (const auto& ss : split(*str, ","))
+            {
+                if (ss.empty())
+                    continue;
+
+                auto parts = split(ss, "-");
+                if (parts.size() == 1)
+                    out.insert(CpuIndex{str_to_size_t(std::string(parts[0]))});
+                else if (parts.size() == 2)
+                {
+                    const CpuIndex cfirst = CpuIndex{str_to_size_t(std::string(parts[0]))};
+                    const CpuIndex clast  = CpuIndex{str_to_size_t(std::string(parts[1]))};
+                    for (CpuIndex c = cfirst; c <= clast; ++c)
+                        out.insert(c);
+                }
+            }
+        };
+
+        read_cpu_list("/sys/devices/cpu_core/cpus", topo.performanceCpus);
+        read_cpu_list("/sys/devices/cpu_atom/cpus", topo.efficiencyCpus);
+#endif
+
+        return topo;
+    }
+};
+
+// Restrict the current thread to the given processors. Best effort: a no-op
+// when the set is empty or the platform offers no affinity interface.
+inline void bind_current_thread_to_cpus([[maybe_unused]] const std::set<CpuIndex>& cpus) {
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (cpus.empty())
+        return;
+
+    const CpuIndex highest = *cpus.rbegin();
+
+    cpu_set_t* mask = CPU_ALLOC(highest + 1);
+    if (mask == nullptr)
+        return;
+
+    const usize masksize = CPU_ALLOC_SIZE(highest + 1);
+
+    CPU_ZERO_S(masksize, mask);
+
+    for (CpuIndex c : cpus)
+        CPU_SET_S(c, masksize, mask);
+
+    sched_setaffinity(0, masksize, mask);
+
+    CPU_FREE(mask);
+
+    // We yield this thread just to be sure it gets rescheduled.
+    sched_yield();
+#endif
+}
+
 //
 // It is guaranteed that NUMA nodes are NOT empty: every node exposed by NumaConfig
 // has at least one processor assigned.
@@ -542,7 +618,8 @@ class NumaConfig {
     // This function gets a NumaConfig based on the system's provided information.
     // The available policies are documented above.
     static NumaConfig from_system([[maybe_unused]] const NumaAutoPolicy& policy,
-                                  bool respectProcessAffinity = true) {
+                                  bool respectProcessAffinity = true,
+                                  bool preferThreadBinding    = false) {
         NumaConfig cfg = empty();
 
 #if !((defined(__linux__) && !defined(__ANDROID__)) || defined(_WIN64))
@@ -657,6 +734,8 @@ class NumaConfig {
         if (!respectProcessAffinity)
             cfg.customAffinity = true;
 
+        cfg.bindingPreferred = preferThreadBinding;
+
         return cfg;
     }
 
@@ -770,6 +849,11 @@ class NumaConfig {
         if (numThreads <= 1)
             return false;
 
+        // An explicitly requested cache-domain policy is pointless without
+        // binding: the whole point is keeping each worker inside its L3.
+        if (bindingPreferred)
+            return nodes.size() > 1;
+
         usize largestNodeSize = 0;
         for (auto&& cpus : nodes)
             if (cpus.size() > largestNodeSize)
@@ -969,6 +1053,12 @@ class NumaConfig {
 
     bool customAffinity;
 
+    // Set when the user explicitly requested a cache-domain policy (see
+    // set_numa_config_from_option); such a policy only has an effect if the
+    // threads actually stay inside their domains, so binding is preferred
+    // even when the general heuristics would not bother.
+    bool bindingPreferred = false;
+
     static NumaConfig empty() { return NumaConfig(EmptyNodeTag{}); }
 
     struct EmptyNodeTag {};
@@ -1405,12 +1495,14 @@ class LazyNumaReplicated: public NumaReplicatedBase {
     LazyNumaReplicated(const LazyNumaReplicated&) = delete;
     LazyNumaReplicated(LazyNumaReplicated&& other) noexcept :
         NumaReplicatedBase(std::move(other)),
-        instances(std::exchange(other.instances, {})) {}
+        instances(std::exchange(other.instances, {})),
+        nodeMutexes(std::exchange(other.nodeMutexes, {})) {}
 
     LazyNumaReplicated& operator=(const LazyNumaReplicated&) = delete;
     LazyNumaReplicated& operator=(LazyNumaReplicated&& other) noexcept {
         NumaReplicatedBase::operator=(*this, std::move(other));
-        instances = std::exchange(other.instances, {});
+        instances   = std::exchange(other.instances, {});
+        nodeMutexes = std::exchange(other.nodeMutexes, {});
 
         return *this;
     }
@@ -1449,7 +1541,9 @@ class LazyNumaReplicated: public NumaReplicatedBase {
 
    private:
     mutable std::vector<std::unique_ptr<T>> instances;
-    mutable std::mutex                      mutex;
+    // One mutex per node, so the lazy copies of different nodes can fault
+    // their pages in parallel (see ThreadPool::ensure_network_replicated)
+    mutable std::vector<std::unique_ptr<std::mutex>> nodeMutexes;
 
     void ensure_present(NumaIndex idx) const {
         assert(idx < instances.size());
@@ -1459,7 +1553,7 @@ class LazyNumaReplicated: public NumaReplicatedBase {
 
         assert(idx != 0);
 
-        std::unique_lock<std::mutex> lock(mutex);
+        std::unique_lock<std::mutex> lock(*nodeMutexes[idx]);
         // Check again for races.
         if (instances[idx] != nullptr)
             return;
@@ -1469,10 +1563,17 @@ class LazyNumaReplicated: public NumaReplicatedBase {
           idx, [this, idx]() { instances[idx] = std::make_unique<T>(*instances[0]); });
     }
 
+    void reset_node_mutexes(usize count) {
+        nodeMutexes.clear();
+        for (usize i = 0; i < count; ++i)
+            nodeMutexes.emplace_back(std::make_unique<std::mutex>());
+    }
+
     void prepare_replicate_from(T&& source) {
         instances.clear();
 
         const NumaConfig& cfg = get_numa_config();
+        reset_node_mutexes(cfg.num_numa_nodes());
         if (cfg.requires_memory_replication())
         {
             assert(cfg.num_numa_nodes() > 0);
@@ -1515,12 +1616,14 @@ class LazyNumaReplicatedSystemWide: public NumaReplicatedBase {
     LazyNumaReplicatedSystemWide(const LazyNumaReplicatedSystemWide&) = delete;
     LazyNumaReplicatedSystemWide(LazyNumaReplicatedSystemWide&& other) noexcept :
         NumaReplicatedBase(std::move(other)),
-        instances(std::exchange(other.instances, {})) {}
+        instances(std::exchange(other.instances, {})),
+        nodeMutexes(std::exchange(other.nodeMutexes, {})) {}
 
     LazyNumaReplicatedSystemWide& operator=(const LazyNumaReplicatedSystemWide&) = delete;
     LazyNumaReplicatedSystemWide& operator=(LazyNumaReplicatedSystemWide&& other) noexcept {
         NumaReplicatedBase::operator=(*this, std::move(other));
-        instances = std::exchange(other.instances, {});
+        instances   = std::exchange(other.instances, {});
+        nodeMutexes = std::exchange(other.nodeMutexes, {});
 
         return *this;
     }
@@ -1573,7 +1676,9 @@ class LazyNumaReplicatedSystemWide: public NumaReplicatedBase {
 
    private:
     mutable std::vector<SystemWideSharedConstant<T>> instances;
-    mutable std::mutex                               mutex;
+    // One mutex per node, so the lazy copies of different nodes can fault
+    // their pages in parallel (see ThreadPool::ensure_network_replicated)
+    mutable std::vector<std::unique_ptr<std::mutex>> nodeMutexes;
 
     usize get_discriminator(NumaIndex idx) const {
         const NumaConfig& cfg     = get_numa_config();
@@ -1593,7 +1698,7 @@ class LazyNumaReplicatedSystemWide: public NumaReplicatedBase {
 
         assert(idx != 0);
 
-        std::unique_lock<std::mutex> lock(mutex);
+        std::unique_lock<std::mutex> lock(*nodeMutexes[idx]);
         // Check again for races.
         if (instances[idx] != nullptr)
             return;
@@ -1604,10 +1709,17 @@ class LazyNumaReplicatedSystemWide: public NumaReplicatedBase {
         });
     }
 
+    void reset_node_mutexes(usize count) {
+        nodeMutexes.clear();
+        for (usize i = 0; i < count; ++i)
+            nodeMutexes.emplace_back(std::make_unique<std::mutex>());
+    }
+
     void prepare_replicate_from(std::unique_ptr<T>&& source) {
         instances.clear();
 
         const NumaConfig& cfg = get_numa_config();
+        reset_node_mutexes(cfg.num_numa_nodes());
         // We just need to make sure the first instance is there.
         // Note that we cannot move here as we need to reallocate the data
         // on the correct NUMA node.
@@ -19,19 +19,67 @@
 #ifndef PERFT_H_INCLUDED
 #define PERFT_H_INCLUDED
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
+#include "misc.h"
 #include "movegen.h"
 #include "position.h"
+#include "thread.h"
 #include "types.h"
 #include "uci.h"
 
 namespace Stockfish::Benchmark {
 
+// Lockless hash table to dedupe perft transpositions, keyed with the same
+// multiply-high scheme as TranspositionTable clusters. Entries are verified
+// with the xor trick, so torn writes between threads are detected and treated
+// as misses; position key plus remaining depth fully identifies a perft count.
+class PerftHash {
+
+   public:
+    explicit PerftHash(usize mbSize) :
+        entryCount(mbSize * 1024 * 1024 / sizeof(Entry)),
+        table(std::make_unique<Entry[]>(entryCount)) {}
+
+    bool probe(Key key, Depth depth, u64& nodes) const {
+        const Entry& e    = table[mul_hi64(key, entryCount)];
+        const u64    data = e.data.load(std::memory_order_relaxed);
+
+        if ((e.key.load(std::memory_order_relaxed) ^ data) != key || Depth(data & 0xFF) != depth)
+            return false;
+
+        nodes = data >> 8;
+        return true;
+    }
+
+    void store(Key key, Depth depth, u64 nodes) {
+        if (nodes >= u64(1) << 56)  // Cannot be encoded, keep the old entry
+            return;
+
+        Entry&    e    = table[mul_hi64(key, entryCount)];
+        const u64 data = nodes << 8 | u64(depth);
+
+        e.data.store(data, std::memory_order_relaxed);
+        e.key.store(key ^ data, std::memory_order_relaxed);
+    }
+
+   private:
+    struct Entry {
+        std::atomic<u64> key{0};
+        std::atomic<u64> data{0};  // nodes << 8 | depth
+    };
+
+    usize                    entryCount;
+    std::unique_ptr<Entry[]> table;
+};
+
 // Utility to verify move generation. All the leaf nodes up
 // to the given depth are generated and counted, and the sum is returned.
 template<bool Root>
-u64 perft(Position& pos, Depth depth) {
+u64 perft(Position& pos, Depth depth, PerftHash* hash = nullptr) {
 
     StateInfo st;
 
@@ -45,7 +93,14 @@ u64 perft(Position& pos, Depth depth) {
         else
         {
             pos.do_move(m, st);
-            cnt = leaf ? MoveList<LEGAL>(pos).size() : perft<false>(pos, depth - 1);
+            if (leaf)
+                cnt = MoveList<LEGAL>(pos).size();
+            else if (!hash || !hash->probe(pos.key(), depth - 1, cnt))
+            {
+                cnt = perft<false>(pos, depth - 1, hash);
+                if (hash)
+                    hash->store(pos.key(), depth - 1, cnt);
+            }
             nodes += cnt;
             pos.undo_move(m);
         }
@@ -55,6 +110,62 @@ u64 perft(Position& pos, Depth depth) {
     return nodes;
 }
 
+// Parallel perft: the root moves are handed out over the thread pool, each
+// worker recursing on its own Position with a plain StateInfo stack, so NNUE
+// accumulators are never touched. All workers share one transposition hash.
+// Per-move counts are printed in generation order once every worker is done,
+// matching the single-threaded output.
+inline u64 perft(const std::string& fen, Depth depth, bool isChess960, ThreadPool& threads) {
+
+    StateInfo st;
+    Position  p;
+    p.set(fen, isChess960, &st);
+
+    const usize threadCount = threads.num_threads();
+
+    // At shallow depths the split and hash overhead exceeds the work
+    if (threadCount <= 1 || depth <= 3)
+        return perft<true>(p, depth);
+
+    const MoveList<LEGAL> rootMoves(p);
+    std::vector<u64>      counts(rootMoves.size(), 0);
+    std::atomic<usize>    next{0};
+
+    PerftHash hash(depth >= 6 ? 256 : 16);
+
+    for (usize t = 0; t < threadCount; ++t)
+        threads.run_on_thread(t, [&]() {
+            Position  pos;
+            StateInfo rootSt, moveSt;
+            pos.set(fen, isChess960, &rootSt);
+
+            // Self-scheduling: threads pull the next unsearched root move, so
+            // an unlucky static split cannot leave most of the tree on one thread
+            for (usize i = next.fetch_add(1, std::memory_order_relaxed); i < rootMoves.size();
+                 i       = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                const Move m = rootMoves.begin()[i];
+
+                pos.do_move(m, moveSt);
+                counts[i] =
+                  depth == 2 ? MoveList<LEGAL>(pos).size() : perft<false>(pos, depth - 1, &hash);
+                pos.undo_move(m);
+            }
+        });
+
+    for (usize t = 0; t < threadCount; ++t)
+        threads.wait_on_thread(t);
+
+    u64 nodes = 0;
+    for (usize i = 0; i < rootMoves.size(); ++i)
+    {
+        sync_cout << UCIEngine::move(rootMoves.begin()[i], isChess960) << ": " << counts[i]
+                  << sync_endl;
+        nodes += counts[i];
+    }
+    return nodes;
+}
+
 inline u64 perft(const std::string& fen, Depth depth, bool isChess960) {
     StateInfo st;
     Position  p;
@@ -0,0 +1,418 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Depth-first proof-number search (df-pn, Nagai 2002) for "go mate N".
+//
+// Mate proofs are AND/OR trees: the attacker (OR nodes) needs one move that
+// works, the defender (AND nodes) refutes with any move that survives. Proof
+// and disproof numbers measure the cheapest frontier that would settle a node
+// either way, and df-pn repeatedly descends into the most promising child
+// until the root is proven (mate in at most N) or disproven (no such mate).
+// For deep forced mates this visits orders of magnitude fewer nodes than the
+// alpha-beta path in search.cpp, which must establish exact distances.
+//
+// Node results live in a shared store modeled on the transposition table:
+// 64-byte clusters of packed entries, racy relaxed reads and writes, and a
+// least-work replacement policy. All worker threads run the same descent
+// against this store; a small virtual-loss bump on the selected child steers
+// the other threads toward siblings, so they expand different frontiers and
+// share their results through the store, TT-style.
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+
+#include "memory.h"
+#include "misc.h"
+#include "movegen.h"
+#include "position.h"
+#include "search.h"
+#include "thread.h"
+#include "types.h"
+#include "uci.h"
+
+namespace Stockfish {
+
+namespace {
+
+// Saturation bound for proof/disproof numbers; sums of two bounded values
+// must not overflow u32.
+constexpr u32 PN_INF = 1u << 30;
+
+u32 saturating_sum(u32 a, u32 b) { return std::min(a + b, PN_INF); }
+
+// A proven node has pn == 0, dn == PN_INF; a disproven one the reverse. Both
+// zero never occurs in a written entry, which lets probes tell a genuinely
+// stored position apart from zeroed memory.
+struct PnsEntry {
+    RelaxedAtomic<u32> key32;
+    RelaxedAtomic<u32> pn;
+    RelaxedAtomic<u32> dn;
+    RelaxedAtomic<u32> work;  // expansions spent below this node, replacement priority
+};
+
+static_assert(sizeof(PnsEntry) == 16, "Unexpected PnsEntry size");
+
+struct alignas(64) PnsCluster {
+    PnsEntry entry[4];
+};
+
+static_assert(sizeof(PnsCluster) == 64, "Unexpected PnsCluster size");
+
+// Shared node store. Writes follow the transposition table philosophy:
+// threads race, a lost update costs re-expansion rather than correctness,
+// since pn/dn values are re-derived from the children on every visit.
+class PnsStore {
+   public:
+    ~PnsStore() { aligned_large_pages_free(table); }
+
+    void resize(usize mbSize) {
+        usize newClusterCount = mbSize * 1024 * 1024 / sizeof(PnsCluster);
+        if (table && newClusterCount == clusterCount)
+            return;
+
+        aligned_large_pages_free(table);
+        clusterCount = newClusterCount;
+        table = static_cast<PnsCluster*>(aligned_large_pages_alloc(clusterCount * sizeof(PnsCluster)));
+        if (!table)
+        {
+            std::cerr << "Failed to allocate " << mbSize << "MB for the proof-number store."
+                      << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    void clear() { std::memset(static_cast<void*>(table), 0, clusterCount * sizeof(PnsCluster)); }
+
+    // Read the pn/dn pair for a position; unexplored nodes default to (1, 1).
+    std::pair<u32, u32> lookup(Key key) const {
+        const PnsCluster& c   = table[mul_hi64(key, clusterCount)];
+        const u32         k32 = u32(key >> 32);
+
+        for (const PnsEntry& e : c.entry)
+            if (e.key32 == k32 && (e.pn != 0 || e.dn != 0))
+                return {e.pn, e.dn};
+
+        return {1, 1};
+    }
+
+    // Find the entry for this position, claiming the least-worked slot of the
+    // cluster when it is not present.
+    PnsEntry* probe(Key key) const {
+        PnsCluster& c   = table[mul_hi64(key, clusterCount)];
+        const u32   k32 = u32(key >> 32);
+
+        PnsEntry* replace = &c.entry[0];
+        for (PnsEntry& e : c.entry)
+        {
+            if (e.key32 == k32 && (e.pn != 0 || e.dn != 0))
+                return &e;
+            if (e.work < replace->work)
+                replace = &e;
+        }
+
+        replace->key32 = k32;
+        replace->pn    = 1;
+        replace->dn    = 1;
+        replace->work  = 0;
+        return replace;
+    }
+
+   private:
+    usize       clusterCount = 0;
+    PnsCluster* table        = nullptr;
+};
+
+// Sized and cleared by the main thread before the helpers start, read-write
+// shared by every thread for the rest of the search.
+PnsStore pnsStore;
+
+struct PnsSolver {
+    ThreadPool&               threads;
+    const Search::LimitsType& limits;
+    RelaxedAtomic<u64>&       nodes;
+    TimePoint           startTime;
+    int                 maxPly;    // deepest ply at which the mating move may land
+    Color               attacker;  // the root side to move, OR nodes
+    bool                preferLateChild;  // per-thread tie break, diversifies descents
+    u64                 sinceAbortCheck = 0;
+    bool                aborted         = false;
+
+    // The remaining mate horizon is part of a node's identity: the same
+    // position reached one ply later has one fewer ply to deliver mate, so it
+    // must not share a store entry. Mixing the remaining depth into the key
+    // also sidesteps the usual repetition (graph history) unsoundness.
+    Key node_key(const Position& pos, int ply) const {
+        return pos.key() ^ (Key(maxPly - ply) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    bool should_abort() {
+        if (aborted)
+            return true;
+        if (++sinceAbortCheck >= 1024)
+        {
+            sinceAbortCheck = 0;
+            if (threads.stop || (limits.nodes && threads.nodes_searched() >= u64(limits.nodes))
+                || (limits.movetime && now() - startTime >= limits.movetime))
+                aborted = true;
+        }
+        return aborted;
+    }
+
+    void mid(Position& pos, int ply, u32 thpn, u32 thdn);
+};
+
+// The MID ("multiple iterative deepening") routine of df-pn: expand this node
+// and descend into the most proving child until the node's proof number
+// reaches thpn or its disproof number reaches thdn.
+void PnsSolver::mid(Position& pos, int ply, u32 thpn, u32 thdn) {
+
+    const bool orNode = pos.side_to_move() == attacker;
+    PnsEntry*  entry  = pnsStore.probe(node_key(pos, ply));
+
+    if (entry->pn >= thpn || entry->dn >= thdn)
+        return;
+
+    nodes += 1;
+    entry->work += 1;
+
+    const MoveList<LEGAL> moves(pos);
+
+    // Terminal nodes: the defender with no legal reply to a check is mated;
+    // every other leaf (stalemate, the attacker mated, or the horizon reached
+    // without mate) disproves this line.
+    if (moves.size() == 0 || ply >= maxPly)
+    {
+        const bool proven = !orNode && moves.size() == 0 && pos.checkers();
+        entry->pn         = proven ? 0 : PN_INF;
+        entry->dn         = proven ? PN_INF : 0;
+        return;
+    }
+
+    while (!should_abort())
+    {
+        // Recompute this node's pn/dn from the children and pick the most
+        // proving child: at OR nodes the cheapest to prove, at AND nodes the
+        // cheapest to disprove, along with the runner-up for its threshold.
+        u32        minSelect = PN_INF, secondSelect = PN_INF, sumOther = 0;
+        u32        selectedOther = PN_INF;
+        const Move* selected     = nullptr;
+
+        for (const auto& m : moves)
+        {
+            StateInfo st;
+            pos.do_move(m, st);
+            auto [childPn, childDn] = pnsStore.lookup(node_key(pos, ply + 1));
+            pos.undo_move(m);
+
+            const u32 select = orNode ? childPn : childDn;
+            const u32 other  = orNode ? childDn : childPn;
+
+            sumOther = saturating_sum(sumOther, other);
+
+            if (select < minSelect || (select == minSelect && preferLateChild))
+            {
+                secondSelect  = minSelect;
+                minSelect     = select;
+                selectedOther = other;
+                selected      = &m;
+            }
+            else if (select < secondSelect)
+                secondSelect = select;
+        }
+
+        const u32 pn = orNode ? minSelect : sumOther;
+        const u32 dn = orNode ? sumOther : minSelect;
+
+        entry->pn = pn;
+        entry->dn = dn;
+
+        if (pn >= thpn || dn >= thdn || pn == 0 || dn == 0)
+            return;
+
+        // Child thresholds per Nagai: stay below the sibling runner-up on the
+        // selected axis, and pass down our remaining budget on the other.
+        const u32 childThSelect = std::min(orNode ? thpn : thdn, saturating_sum(secondSelect, 1));
+        const u32 budget        = orNode ? thdn : thpn;
+        const u32 childThOther =
+          budget >= PN_INF ? PN_INF : budget - (orNode ? dn : pn) + selectedOther;
+
+        // Virtual loss: nudge the stored numbers of the child we are about to
+        // work on, so concurrent threads prefer its siblings. Its thresholds
+        // are raised by the same amount, so from the child's own point of
+        // view nothing changed, and its first recomputation from the
+        // grandchildren overwrites the nudge.
+        StateInfo st;
+        pos.do_move(*selected, st);
+        PnsEntry* child = pnsStore.probe(node_key(pos, ply + 1));
+        child->pn       = saturating_sum(child->pn, 1);
+        child->dn       = saturating_sum(child->dn, 1);
+
+        mid(pos, ply + 1, saturating_sum(orNode ? childThSelect : childThOther, 1),
+            saturating_sum(orNode ? childThOther : childThSelect, 1));
+        pos.undo_move(*selected);
+    }
+}
+
+}  // namespace
+
+namespace Search {
+
+// Entry point for "go mate N" with the ProofNumberSearch option enabled.
+// Every worker lands here from start_searching(); the main thread owns setup,
+// the final report and the bestmove, mirroring the alpha-beta path.
+void Worker::pns_search() {
+
+    if (is_mainthread())
+    {
+        if (rootMoves.empty())
+        {
+            main_manager()->updates.onUpdateNoMoves(
+              {0, {rootPos.checkers() ? -VALUE_MATE : VALUE_DRAW, rootPos}});
+            main_manager()->updates.onBestmove(UCIEngine::move(Move::none()), "");
+            if (Telemetry::Slot* t = threads.telemetry.slot())
+                t->searching = 0;
+            return;
+        }
+
+        pnsStore.resize(usize(int(options["Hash"])));
+        pnsStore.clear();
+
+        threads.start_searching();
+    }
+
+    PnsSolver solver{threads,
+                     limits,
+                     nodes,
+                     now(),
+                     std::min(2 * limits.mate - 1, MAX_PLY - 4),
+                     rootPos.side_to_move(),
+                     bool(threadIdx & 1)};
+
+    const Key rootKey = solver.node_key(rootPos, 0);
+
+    // A single full-window descent normally decides the root, but store
+    // replacement can evict interior results, so re-descend until it sticks.
+    auto rootDecided = [&] {
+        auto [pn, dn] = pnsStore.lookup(rootKey);
+        return pn == 0 || dn == 0;
+    };
+
+    while (!solver.should_abort() && !rootDecided())
+    {
+        solver.sinceAbortCheck = 1023;  // re-poll limits promptly on re-entry
+        solver.mid(rootPos, 0, PN_INF, PN_INF);
+    }
+
+    if (!is_mainthread())
+        return;
+
+    const bool proven = pnsStore.lookup(rootKey).first == 0;
+
+    // With a proof in the store, walk proven children to recover a mating
+    // line. Replacement may have clipped it; the proof itself still stands.
+    std::string pv;
+    int         pvLength = 0;
+    bool        pvIsMate = false;
+    Move        best     = rootMoves[0].pv[0];
+    if (proven)
+    {
+        Position  walkPos;
+        StateInfo rootSt;
+        walkPos.set(rootPos.fen(), rootPos.is_chess960(), &rootSt);
+
+        std::deque<StateInfo> stack;
+        while (pvLength <= solver.maxPly)
+        {
+            const MoveList<LEGAL> moves(walkPos);
+            if (moves.size() == 0)
+            {
+                pvIsMate = bool(walkPos.checkers());
+                break;
+            }
+
+            const Move* chosen = nullptr;
+            for (const auto& m : moves)
+            {
+                StateInfo st;
+                walkPos.do_move(m, st);
+                const bool childProven =
+                  pnsStore.lookup(solver.node_key(walkPos, pvLength + 1)).first == 0;
+                walkPos.undo_move(m);
+                if (childProven)
+                {
+                    chosen = &m;
+                    break;
+                }
+            }
+            if (!chosen)
+                break;
+
+            if (pvLength == 0)
+                best = *chosen;
+            pv += UCIEngine::move(*chosen, walkPos.is_chess960()) + " ";
+            stack.emplace_back();
+            walkPos.do_move(*chosen, stack.back());
+            pvLength++;
+        }
+        if (!pv.empty())
+            pv.pop_back();
+    }
+
+    // Honour the UCI contract before reporting, as the alpha-beta path does.
+    while (!threads.stop && (main_manager()->ponder || limits.infinite))
+    {}  // Busy wait for a stop or a ponder reset
+
+    threads.stop = true;
+    threads.wait_for_search_finished();
+
+    // Proven: mate in at most N, exactly (pvLength + 1) / 2 when the walk
+    // reached the mate. Disproven: no mate within N; report a draw-bound
+    // score so the result is machine-readable, plus the proof verdict.
+    const Value v = proven ? VALUE_MATE - (pvIsMate ? pvLength : solver.maxPly) : VALUE_DRAW;
+
+    const u64         totalNodes = threads.nodes_searched();
+    const TimePoint   time       = std::max(TimePoint(1), now() - solver.startTime);
+    const std::string pvOut = proven ? pv : UCIEngine::move(best, rootPos.is_chess960());
+
+    InfoFull info;
+    info.depth    = solver.maxPly;
+    info.selDepth = solver.maxPly;
+    info.multiPV  = 1;
+    info.score    = {v, rootPos};
+    info.wdl      = "";
+    info.bound    = proven || !solver.aborted ? "" : "upperbound";
+    info.timeMs   = time;
+    info.nodes    = totalNodes;
+    info.nps      = totalNodes * 1000 / time;
+    info.tbHits   = 0;
+    info.pv       = pvOut;
+    info.hashfull = 0;
+
+    main_manager()->updates.onUpdateFull(info);
+    main_manager()->updates.onBestmove(UCIEngine::move(best, rootPos.is_chess960()), "");
+
+    if (Telemetry::Slot* t = threads.telemetry.slot())
+        t->searching = 0;
+}
+
+}  // namespace Search
+
+}  // namespace Stockfish
@@ -27,6 +27,7 @@
 #include <initializer_list>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string_view>
 #include <utility>
@@ -490,6 +491,7 @@ void Position::set_state() const {
     st->nonPawnKey[WHITE] = st->nonPawnKey[BLACK] = 0;
     st->pawnKey                                   = Zobrist::noPawns;
     st->nonPawnMaterial[WHITE] = st->nonPawnMaterial[BLACK] = VALUE_ZERO;
+    st->seeValid                                            = 0;
     st->checkersBB = attackers_to(square<KING>(sideToMove)) & pieces(~sideToMove);
 
     set_check_info();
@@ -822,6 +824,7 @@ void Position::do_move(Move                      m,
     // our state pointer to point to the new (ready to be updated) state.
     std::memcpy(&newSt, st, offsetof(StateInfo, key));
     newSt.previous = st;
+    newSt.seeValid = 0;
     st             = &newSt;
 
     // Increment ply counters. In particular, rule50 will be reset to zero later on
@@ -995,7 +998,7 @@ void Position::do_move(Move                      m,
 
     if (history)
     {
-        prefetch(&history->pawn_entry(*this)[pc][to]);
+        prefetch(history->pawn_entry(*this).read_addr(pc, to));
         prefetch(&history->pawn_correction_entry(*this));
         prefetch(&history->minor_piece_correction_entry(*this));
         prefetch(&history->nonpawn_correction_entry<WHITE>(*this));
@@ -1349,6 +1352,7 @@ void Position::do_null_move(StateInfo& newSt) {
     std::memcpy(&newSt, st, sizeof(StateInfo));
 
     newSt.previous = st;
+    newSt.seeValid = 0;  // SEE results are side-to-move dependent
     st             = &newSt;
 
     if (st->epSquare != SQ_NONE)
@@ -1394,6 +1398,43 @@ bool Position::see_ge(Move m, int threshold) const {
     if (m.type_of() != NORMAL)
         return VALUE_ZERO >= threshold;
 
+    // MovePicker and the pruning in search query the same move at one node,
+    // usually against different thresholds. The result is monotone in the
+    // threshold, so per node and move it is enough to remember the highest
+    // passing and lowest failing threshold seen so far; repeat queries are
+    // then mostly answered from the bounds without walking the swap sequence.
+    const int  idx   = m.raw() & (StateInfo::SeeCacheEntries - 1);
+    const bool fits  = threshold == i16(threshold);
+    const bool valid = (st->seeValid & (1 << idx)) && st->seeMove[idx] == m.raw();
+
+    if (valid && fits)
+    {
+        if (threshold <= st->seeLo[idx])
+            return true;
+        if (threshold >= st->seeHi[idx])
+            return false;
+    }
+
+    const bool res = see_ge_compute(m, threshold);
+
+    if (fits)
+    {
+        if (!valid)
+        {
+            st->seeMove[idx] = m.raw();
+            st->seeLo[idx]   = std::numeric_limits<i16>::min();
+            st->seeHi[idx]   = std::numeric_limits<i16>::max();
+            st->seeValid |= u16(1 << idx);
+        }
+
+        (res ? st->seeLo[idx] : st->seeHi[idx]) = i16(threshold);
+    }
+
+    return res;
+}
+
+bool Position::see_ge_compute(Move m, int threshold) const {
+
     Square from = m.from_sq(), to = m.to_sq();
 
     assert(piece_on(from) != NO_PIECE);
@@ -1477,8 +1518,14 @@ bool Position::see_ge(Move m, int threshold) const {
             assert(swap >= res);
             occupied ^= least_significant_square_bb(bb);
 
+#ifdef USE_DUAL_HYPERBOLA_QUINT
+            // Both x-ray directions in one batched [bishop, rook] pass
+            const auto [xray1, xray2] = dual_magic(to).both_attacks_bb(occupied);
+            attackers |= (xray1 & pieces(BISHOP, QUEEN)) | (xray2 & pieces(ROOK, QUEEN));
+#else
             attackers |= (attacks_bb<BISHOP>(to, occupied) & pieces(BISHOP, QUEEN))
                        | (attacks_bb<ROOK>(to, occupied) & pieces(ROOK, QUEEN));
+#endif
         }
 
         else  // KING
@@ -1494,7 +1541,7 @@ bool Position::see_ge(Move m, int threshold) const {
 // or by repetition. It does not detect stalemates.
 bool Position::is_draw(int ply) const {
 
-    if (st->rule50 > 99 && (!checkers() || MoveList<LEGAL>(*this).size()))
+    if (st->rule50 > 99 && (!checkers() || !LazyLegalMoveList(*this).empty()))
         return true;
 
     return is_repetition(ply);
@@ -21,7 +21,7 @@
 
 #include <array>
 #include <cassert>
-#include <deque>
+#include <cstddef>
 #include <iosfwd>
 #include <memory>
 #include <new>
@@ -31,6 +31,7 @@
 
 #include "attacks.h"
 #include "bitboard.h"
+#include "memory.h"
 #include "types.h"
 
 namespace Stockfish {
@@ -55,23 +56,65 @@ struct StateInfo {
     int    pliesFromNull;
     Square epSquare;
 
-    // Not copied when making a move (will be recomputed anyhow)
+    // Not copied when making a move (will be recomputed anyhow). Ordered by
+    // access frequency so that the fields touched on every node (hash key,
+    // checkers, undo chain, repetition info) share the cache line starting at
+    // the 64-byte boundary after the copied block, while checkSquares, which
+    // is only read by givesCheck, fills the tail of the struct.
     Key        key;
     Bitboard   checkersBB;
     StateInfo* previous;
+    Piece      capturedPiece;
+    int        repetition;
     Bitboard   blockersForKing[COLOR_NB];
     Bitboard   pinners[COLOR_NB];
     Bitboard   checkSquares[PIECE_TYPE_NB];
-    Piece      capturedPiece;
-    int        repetition;
+
+    // Per-node SEE memo (see Position::see_ge): direct-mapped by the low move
+    // bits, with validity tracked in one mask so invalidating the whole table
+    // when entering a node is a single store
+    static constexpr int SeeCacheEntries = 16;
+
+    u16 seeMove[SeeCacheEntries];
+    i16 seeLo[SeeCacheEntries], seeHi[SeeCacheEntries];
+    u16 seeValid;
 };
 
+static_assert(offsetof(StateInfo, key) == 64,
+              "Copied block is expected to fill the first cache line exactly");
+
 
 // A list to keep track of the position states along the setup moves (from the
 // start position to the position just before the search starts). Needed by
-// 'draw by repetition' detection. Use a std::deque because pointers to
-// elements are not invalidated upon list resizing.
-using StateListPtr = std::unique_ptr<std::deque<StateInfo>>;
+// 'draw by repetition' detection. Entries are bump-allocated from an arena
+// (one block allocation instead of one per setup move) and their addresses
+// stay stable, which the StateInfo::previous chain relies on.
+class StateList {
+    static_assert(std::is_trivially_destructible_v<StateInfo>);
+
+   public:
+    explicit StateList(usize n = 0) {
+        for (usize i = 0; i < n; ++i)
+            emplace_back();
+    }
+
+    StateInfo& emplace_back() {
+        void* mem = arena.allocate(sizeof(StateInfo), alignof(StateInfo));
+        tail      = new (mem) StateInfo();
+        return *tail;
+    }
+
+    StateInfo& back() {
+        assert(tail);
+        return *tail;
+    }
+
+   private:
+    MonotonicArena arena;
+    StateInfo*     tail = nullptr;
+};
+
+using StateListPtr = std::unique_ptr<StateList>;
 
 // This error should be used whenever a position is suspected to be unsupported
 // by the engine. In particular positions that may cause hard errors like segmentation fault.
@@ -197,6 +240,7 @@ class Position {
     void set_check_info() const;
 
     // Other helpers
+    bool see_ge_compute(Move m, int threshold) const;
     template<bool ComputeRay = true>
     void update_piece_threats(Piece               pc,
                               bool                putPiece,
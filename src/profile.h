@@ -0,0 +1,145 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROFILE_H_INCLUDED
+#define PROFILE_H_INCLUDED
+
+#include <string>
+
+#include "types.h"
+
+// Compile-time gated search profiler. Build with -DSEARCH_PROFILE (e.g. via
+// EXTRACXXFLAGS) to count calls and cycles per subsystem; counters are then
+// printed with the 'profile' UCI command after a bench or a search. Without
+// the define every hook expands to nothing, so shipping builds pay no cost.
+//
+// Phases nest: movegen cycles are also part of the enclosing movepick scope,
+// so compare each phase against its own baseline, not against the sum.
+
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+#endif
+
+#ifdef SEARCH_PROFILE
+    #include <atomic>
+    #include <sstream>
+#endif
+
+namespace Stockfish::Profile {
+
+enum Phase {
+    MoveGen,
+    MovePick,
+    Eval,
+    TTProbe,
+    TBProbe,
+    PHASE_NB
+};
+
+// Raw cycle counter, also used by the microbenchmark harness. On x86-64 this
+// is the TSC, which on modern parts ticks at a fixed reference rate rather
+// than the current core clock; elsewhere it falls back to nanoseconds.
+inline u64 now_cycles() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return u64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now().time_since_epoch())
+                 .count());
+#endif
+}
+
+#ifdef SEARCH_PROFILE
+
+constexpr const char* PhaseNames[PHASE_NB] = {"movegen", "movepick", "nnue eval", "tt probe",
+                                              "tb probe"};
+
+inline std::atomic<u64> cycles[PHASE_NB];
+inline std::atomic<u64> calls[PHASE_NB];
+
+// RAII cycle counter for one phase. Counters are process-wide and updated with
+// relaxed atomics; the add per call is acceptable in a profiling build and
+// avoids tracking per-thread storage across thread pool resizes.
+class Scope {
+   public:
+    explicit Scope(Phase p) :
+        phase(p),
+        start(now_cycles()) {}
+
+    ~Scope() {
+        cycles[phase].fetch_add(now_cycles() - start, std::memory_order_relaxed);
+        calls[phase].fetch_add(1, std::memory_order_relaxed);
+    }
+
+   private:
+    Phase phase;
+    u64   start;
+};
+
+inline void clear() {
+    for (int p = 0; p < PHASE_NB; ++p)
+    {
+        cycles[p].store(0, std::memory_order_relaxed);
+        calls[p].store(0, std::memory_order_relaxed);
+    }
+}
+
+inline std::string dump() {
+    std::ostringstream ss;
+    ss << "phase          calls          cycles    cycles/call";
+
+    for (int p = 0; p < PHASE_NB; ++p)
+    {
+        const u64 c = calls[p].load(std::memory_order_relaxed);
+        const u64 t = cycles[p].load(std::memory_order_relaxed);
+
+        ss << '\n' << PhaseNames[p];
+        for (usize i = std::string(PhaseNames[p]).size(); i < 10; ++i)
+            ss << ' ';
+        ss << ' ' << c << ' ' << t << ' ' << (c ? t / c : 0);
+    }
+    return ss.str();
+}
+
+    #define PROFILE_CONCAT_IMPL(x, y) x##y
+    #define PROFILE_CONCAT(x, y) PROFILE_CONCAT_IMPL(x, y)
+    #define PROFILE_SCOPE(phase) \
+        ::Stockfish::Profile::Scope PROFILE_CONCAT(profileScope_, __LINE__)( \
+          ::Stockfish::Profile::phase)
+
+#else
+
+inline void clear() {}
+
+inline std::string dump() {
+    return "Profiling support not compiled in. Rebuild with -DSEARCH_PROFILE.";
+}
+
+    #define PROFILE_SCOPE(phase)
+
+#endif
+
+}  // namespace Stockfish::Profile
+
+#endif  // #ifndef PROFILE_H_INCLUDED
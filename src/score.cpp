@@ -26,12 +26,15 @@
 
 namespace Stockfish {
 
-Score::Score(Value v, const Position& pos) {
+Score::Score(Value v, const Position& pos) :
+    Score(v, UCIEngine::win_rate_params(pos)) {}
+
+Score::Score(Value v, const WinRateParams& params) {
     assert(-VALUE_INFINITE < v && v < VALUE_INFINITE);
 
     if (!is_decisive(v))
     {
-        score = InternalUnits{UCIEngine::to_cp(v, pos)};
+        score = InternalUnits{UCIEngine::to_cp(v, params)};
     }
     else if (std::abs(v) <= VALUE_TB)
     {
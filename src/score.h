@@ -27,6 +27,7 @@
 namespace Stockfish {
 
 class Position;
+struct WinRateParams;
 
 class Score {
    public:
@@ -45,6 +46,9 @@ class Score {
 
     Score() = default;
     Score(Value v, const Position& pos);
+    // Batch variant for converting many scores of one position, avoiding a
+    // parameter lookup per conversion (see WinRateParams in uci.h)
+    Score(Value v, const WinRateParams& params);
 
     template<typename T>
     bool is() const {
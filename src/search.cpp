@@ -25,8 +25,10 @@
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <fstream>
 #include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <list>
 #include <ratio>
 #include <string>
@@ -189,6 +191,14 @@ void Search::Worker::start_searching() {
 
     accumulatorStack.reset();
 
+    // Mate solving can route to the dedicated proof-number searcher, which
+    // proves "mate in at most N" far faster than alpha-beta on deep mates
+    if (limits.mate > 0 && options["ProofNumberSearch"])
+    {
+        pns_search();
+        return;
+    }
+
     // Non-main threads go directly to iterative_deepening()
     if (!is_mainthread())
     {
@@ -205,6 +215,8 @@ void Search::Worker::start_searching() {
         main_manager()->updates.onUpdateNoMoves(
           {0, {rootPos.checkers() ? -VALUE_MATE : VALUE_DRAW, rootPos}});
         main_manager()->updates.onBestmove(UCIEngine::move(Move::none()), "");
+        if (Telemetry::Slot* t = threads.telemetry.slot())
+            t->searching = 0;
         return;
     }
 
@@ -258,6 +270,57 @@ void Search::Worker::start_searching() {
 
     auto bestmove = UCIEngine::move(bestThread->rootMoves[0].pv[0], rootPos.is_chess960());
     main_manager()->updates.onBestmove(bestmove, ponder);
+
+    // Retain the best thread's root statistics to warm-start the next search
+    // from this position or one of its children (see TreeRetention).
+    threads.treeRetention.save(rootPos, bestThread->rootMoves);
+
+    // All workers are done, so the recorded node schedule is complete
+    if (threads.scheduleRecorder.enabled())
+        threads.scheduleRecorder.flush();
+
+    // Publish the final counters, so idle engines report accurate totals
+    if (Telemetry::Slot* t = threads.telemetry.slot())
+    {
+        t->nodes     = threads.nodes_searched();
+        t->rootDepth = u32(bestThread->rootDepth);
+        t->searching = 0;
+    }
+
+    // The engine now sits idle until the opponent replies, so donate the
+    // wait to low-priority maintenance. Anything that needs the threads in
+    // the meantime raises threads.abortIdle and proceeds with at most a
+    // chunk's worth of delay.
+    idle_maintenance();
+}
+
+// Idle-time maintenance between searches. Ordered by expected payoff: the
+// accumulator warmup is microseconds and helps the very first evaluations of
+// the next search, while the deferred TT sweep can span many idle periods.
+void Search::Worker::idle_maintenance() {
+
+    // Refresh the accumulator cache entries for the children of the current
+    // position: the opponent's reply is very likely among them, so the next
+    // search starts from warm entries instead of paying from-scratch
+    // rebuilds on every new king bucket or material key. Helper threads keep
+    // their own caches, which refill quickly once they join the search.
+    StateInfo st;
+    for (const Move m : MoveList<LEGAL>(rootPos))
+    {
+        if (threads.abortIdle)
+            return;
+
+        rootPos.do_move(m, st);
+        if (!rootPos.checkers())
+        {
+            accumulatorStack.reset();
+            evaluate(rootPos);
+        }
+        rootPos.undo_move(m);
+    }
+
+    // Run the sweep the last soft_clear() deferred, if any of it is left
+    tt.idle_sweep(threads.abortIdle);
 }
 
 // Main iterative deepening loop. It calls search()
@@ -309,6 +372,8 @@ bool Search::Worker::iterative_deepening() {
     usize multiPV = usize(options["MultiPV"]);
     Skill skill(options["Skill Level"], options["UCI_LimitStrength"] ? int(options["UCI_Elo"]) : 0);
 
+    coordinateRootMoves = bool(options["RootCoordination"]) && threads.size() > 1;
+
     // When playing with strength handicap enable MultiPV search that we will
     // use behind-the-scenes to retrieve a set of possible moves.
     if (skill.enabled())
@@ -316,6 +381,78 @@ bool Search::Worker::iterative_deepening() {
 
     multiPV = std::min(multiPV, rootMoves.size());
 
+    // Warm start from the previous search (see TreeRetention). Skipped when
+    // tablebase ranking is active, since reordering would break the tbRank
+    // grouping of the MultiPV loop below.
+    if (rootMoves.front().tbRank == rootMoves.back().tbRank)
+    {
+        if (threads.treeRetention.same_root(rootPos.key()))
+        {
+            // Same root searched again: restore the previous final ordering
+            // and each move's score statistics, so every PV line opens with
+            // an aspiration window centered on its known score.
+            usize next = 0;
+            for (const auto& rrm : threads.treeRetention.moves)
+            {
+                auto it = std::find(rootMoves.begin() + next, rootMoves.end(), rrm.move);
+                if (it == rootMoves.end())
+                    continue;
+
+                std::rotate(rootMoves.begin() + next, it, it + 1);
+                rootMoves[next].averageScore     = rrm.averageScore;
+                rootMoves[next].meanSquaredScore = rrm.meanSquaredScore;
+                ++next;
+            }
+        }
+        else if (const auto* rrm = threads.treeRetention.find_child(rootPos.key());
+                 rrm && rrm->reply != Move::none())
+        {
+            // One move was played from the previous root: bring its expected
+            // reply to the front and seed the window with the negated subtree
+            // score, which from here is the opponent's point of view.
+            auto it = std::find(rootMoves.begin(), rootMoves.end(), rrm->reply);
+            if (it != rootMoves.end())
+            {
+                std::rotate(rootMoves.begin(), it, it + 1);
+                if (rrm->averageScore != -VALUE_INFINITE)
+                {
+                    rootMoves[0].averageScore     = -rrm->averageScore;
+                    rootMoves[0].meanSquaredScore = -rrm->meanSquaredScore;
+                }
+            }
+        }
+    }
+
+    // Concurrent MultiPV (see the ParallelMultiPV option). The pool is split
+    // into per-line groups: each group pins one of the top moves of the
+    // initial ordering and deepens only that line against the shared TT, so
+    // the lines progress concurrently instead of sequentially. Group 0 keeps
+    // the full move list minus the pinned moves, so a move from outside the
+    // initial top lines can still rise to the top. Completed iterations are
+    // published below and merged for reporting by SearchManager::pv, while
+    // the regular best-thread vote arbitrates the final move across groups.
+    // Every worker derives the same layout because the initial ordering is
+    // identical on all of them.
+    parallelMultiPV = bool(options["ParallelMultiPV"]) && multiPV > 1
+                   && threads.size() >= multiPV && !skill.enabled() && !limits.mate
+                   && rootMoves.front().tbRank == rootMoves.back().tbRank;
+
+    pvGroup = parallelMultiPV ? threadIdx % multiPV : 0;
+    pinnedRootMoves.clear();
+
+    if (parallelMultiPV)
+    {
+        for (usize i = 1; i < multiPV; ++i)
+            if (i != pvGroup)
+                pinnedRootMoves.push_back(rootMoves[i].pv[0]);
+
+        // Bring this group's line to the front; the root search below is then
+        // restricted to it through pvLast.
+        if (pvGroup)
+            std::rotate(rootMoves.begin(), rootMoves.begin() + pvGroup,
+                        rootMoves.begin() + pvGroup + 1);
+    }
+
     int  searchAgainCounter = 0;
     bool uciPvSent          = false;
 
@@ -331,6 +468,12 @@ bool Search::Worker::iterative_deepening() {
     {
         rootDepth++;
 
+        // Elastic sizing: helpers above the active-thread target park here
+        // until unparked or stopped, keeping their histories and NUMA binding
+        // warm for an instant restart (see ThreadPool::park_point).
+        if (!mainThread)
+            threads.park_point(threadIdx);
+
         // Age out PV variability metric and signal the start of a new iteration.
         if (mainThread)
         {
@@ -348,13 +491,15 @@ bool Search::Worker::iterative_deepening() {
         }
 
         usize pvFirst = 0;
-        pvLast        = 0;
+        pvLast        = parallelMultiPV ? (pvGroup ? 1 : rootMoves.size()) : 0;
 
         if (!threads.increaseDepth)
             searchAgainCounter++;
 
-        // MultiPV loop. We perform a full root search for each PV line
-        for (pvIdx = 0; pvIdx < multiPV; ++pvIdx)
+        // MultiPV loop. We perform a full root search for each PV line. In
+        // parallel mode each worker owns a single line, searched once per
+        // iteration; the sibling lines deepen concurrently in other groups.
+        for (pvIdx = 0; pvIdx < (parallelMultiPV ? 1 : multiPV); ++pvIdx)
         {
             if (pvIdx == pvLast)
             {
@@ -390,7 +535,10 @@ bool Search::Worker::iterative_deepening() {
                 Depth adjustedDepth =
                   std::max(1, rootDepth - failedHighCnt - 3 * (searchAgainCounter + 1) / 4);
                 rootDelta = beta - alpha;
-                bestValue = search<Root>(rootPos, ss, alpha, beta, adjustedDepth, false);
+                bestValue =
+                  tbConfig.cardinality
+                    ? search<Root, true>(rootPos, ss, alpha, beta, adjustedDepth, false)
+                    : search<Root, false>(rootPos, ss, alpha, beta, adjustedDepth, false);
 
                 // Bring the best move to the front. It is critical that sorting
                 // is done with a stable algorithm because all the values but the
@@ -409,8 +557,8 @@ bool Search::Worker::iterative_deepening() {
                 // When failing high/low give some update before a re-search. To avoid
                 // excessive output that could hang GUIs like Fritz 19, only start
                 // at nodes > 10M (rather than depth N, which can be reached quickly)
-                if (mainThread && multiPV == 1 && (bestValue <= alpha || bestValue >= beta)
-                    && nodes > NODES_LIMIT_OUTPUT)
+                if (mainThread && (multiPV == 1 || parallelMultiPV)
+                    && (bestValue <= alpha || bestValue >= beta) && nodes > NODES_LIMIT_OUTPUT)
                     main_manager()->pv(*this, threads, tt, rootDepth);
 
                 // In case of failing low/high increase aspiration window and re-search,
@@ -489,10 +637,16 @@ bool Search::Worker::iterative_deepening() {
             // Sort the PV lines searched so far and update the GUI
             std::stable_sort(rootMoves.begin() + pvFirst, rootMoves.begin() + pvIdx + 1);
 
-            if (mainThread && !threads.stop && (pvIdx + 1 == multiPV || nodes > NODES_LIMIT_OUTPUT))
+            // Make this line's freshest completed result visible to the
+            // merging main thread
+            if (parallelMultiPV && !threads.stop)
+                threads.multiPVResults.publish(pvGroup, rootDepth, rootMoves[0]);
+
+            if (mainThread && !threads.stop
+                && (pvIdx + 1 == multiPV || parallelMultiPV || nodes > NODES_LIMIT_OUTPUT))
             {
                 main_manager()->pv(*this, threads, tt, rootDepth);
-                uciPvSent = (pvIdx + 1 == multiPV);
+                uciPvSent = (pvIdx + 1 == multiPV || parallelMultiPV);
             }
 
             if (threads.stop)
@@ -548,6 +702,9 @@ bool Search::Worker::iterative_deepening() {
             && VALUE_MATE - std::abs(rootMoves[0].score) <= 2 * limits.mate)
             threads.stop = true;
 
+        if (threads.scheduleRecorder.enabled())
+            threads.scheduleRecorder.record(threadIdx, rootDepth, nodes, rootMoves[0].pv[0]);
+
         if (!mainThread)
             continue;
 
@@ -593,10 +750,26 @@ bool Search::Worker::iterative_deepening() {
 
             auto elapsedTime = elapsed();
 
+            // Effort-aware speculative stop: a single root move absorbing
+            // nearly the whole tree while its score sits still across the
+            // last four iterations is the signature of a forced reply, e.g.
+            // a recapture. The highBestMoveEffort factor above already
+            // shrinks totalTime somewhat, but the remaining confirmation
+            // iterations are worthless, so once a third of the allotment has
+            // elapsed stop outright and bank the rest of the clock.
+            bool overwhelmingEffort = nodesEffort >= 97000 && rootDepth >= 12
+                                   && rootDepth > lastBestMoveDepth + 10
+                                   && totBestMoveChanges < 0.1 && !is_decisive(bestValue)
+                                   && elapsedTime > totalTime * 0.33;
+            for (Value v : mainThread->iterValue)
+                overwhelmingEffort &= std::abs(v - bestValue) <= 8;
+
             // Stop the search if we have exceeded totalTime or maximum time,
             // or if we know that there are no better moves in the analysed line(s)
             if (elapsedTime > std::min(totalTime, double(mainThread->tm.maximum()))
-                || rootMoves[multiPV - 1].score >= mate_in(3) || rootMoves[0].score == mated_in(2))
+                || overwhelmingEffort
+                || (!parallelMultiPV && rootMoves[multiPV - 1].score >= mate_in(3))
+                || rootMoves[0].score == mated_in(2))
             {
                 // If we are allowed to ponder do not stop the search now but
                 // keep pondering until the GUI sends "ponderhit" or "stop".
@@ -636,14 +809,25 @@ void Search::Worker::do_move(
   Position& pos, const Move move, StateInfo& st, const bool givesCheck, Stack* const ss) {
     // prefetch_key does not model castling, en passant or promotion keys
     // exactly; for rare moves the prefetch lands on an unused line.
-    prefetch(tt.first_entry(pos.prefetch_key(move)));
+    prefetch(tt.first_entry(pos.prefetch_key(move), numaAccessToken.get_numa_index()));
 
     bool capture = pos.capture_stage(move);
     ++nodes;
 
+    // One predictable decrement per node; without a node limit the refill
+    // hands out effectively infinite tokens, so the branch never retires
+    if (--nodeTokens <= 0)
+        refill_node_tokens();
+
     auto [dirtyPiece, dirtyThreats] = accumulatorStack.push();
     pos.do_move(move, st, givesCheck, dirtyPiece, dirtyThreats, &tt, &sharedHistory);
 
+    // Probe-ahead for Syzygy: once a move brings the position into the
+    // tablebase window, queue the table for background mapping so the later
+    // probe (here or in a descendant node) does not block on first-touch I/O.
+    if (tbConfig.cardinality && pos.count<ALL_PIECES>() <= tbConfig.cardinality)
+        TB::prefetch_wdl(pos);
+
     if (ss != nullptr)
     {
         ss->currentMove = move;
@@ -654,6 +838,35 @@ void Search::Worker::do_move(
     }
 }
 
+// Claims the next batch of node tokens from the pool-wide bucket. Batching
+// keeps the shared cacheline traffic to one fetch_sub per grant while
+// bounding the overshoot by threads * grant nodes: once the bucket is
+// drained, whoever fails a refill raises the stop and the others only burn
+// the tokens they already hold.
+void Search::Worker::refill_node_tokens() {
+
+    if (!limits.nodes)
+    {
+        nodeTokens = std::numeric_limits<i64>::max();
+        return;
+    }
+
+    const i64 grant = std::clamp<i64>(i64(limits.nodes) / i64(16 * threads.num_threads()), 32, 4096);
+    const i64 before = threads.nodeBudget.fetch_sub(grant, std::memory_order_relaxed);
+
+    if (before <= 0)
+    {
+        // A node limit never ends a ponder search (check_time has the same
+        // guard): the bucket just stays drained while we keep pondering, and
+        // the first failed refill after "ponderhit" raises the stop.
+        if (!threads.main_manager()->ponder)
+            threads.stop = true;
+        nodeTokens = grant;  // back off a full grant before rechecking
+    }
+    else
+        nodeTokens = std::min(grant, before);
+}
+
 void Search::Worker::do_null_move(Position& pos, StateInfo& st, Stack* const ss) {
     pos.do_null_move(st);
     ss->currentMove                   = Move::null();
@@ -669,26 +882,52 @@ void Search::Worker::undo_move(Position& pos, const Move move) {
 void Search::Worker::undo_null_move(Position& pos) { pos.undo_null_move(); }
 
 
-// Reset histories, usually before a new game
+// Reset histories, usually before a new game. With a nonzero History
+// Retention every entry instead keeps a fraction of its value, so the move
+// ordering learned in one game carries over to the next related one.
 void Search::Worker::clear() {
-    mainHistory.fill(-5);
-    captureHistory.fill(-699);
+    const int keep = int(options["History Retention"]) * 256 / 100;
+
+    if (keep)
+    {
+        stats_decay(mainHistory, keep);
+        stats_decay(captureHistory, keep);
+
+        // Each thread is responsible for decaying their part of shared history
+        sharedHistory.correctionHistory.decay_range(keep, numaThreadIdx, numaTotal);
+        sharedHistory.pawnHistory.decay_range(keep, numaThreadIdx, numaTotal);
+
+        ttMoveHistory = i16(HistoryKernels::decay_value(i16(ttMoveHistory), keep));
 
-    // Each thread is responsible for clearing their part of shared history
-    sharedHistory.correctionHistory.clear_range(-6, numaThreadIdx, numaTotal);
-    sharedHistory.pawnHistory.clear_range(-1262, numaThreadIdx, numaTotal);
+        stats_decay(continuationCorrectionHistory, keep);
 
-    ttMoveHistory = 0;
+        for (bool inCheck : {false, true})
+            for (StatsType c : {NoCaptures, Captures})
+                for (auto& to : continuationHistory[inCheck][c])
+                    for (auto& h : to)
+                        h.decay(keep);
+    }
+    else
+    {
+        stats_fill(mainHistory, -5);
+        stats_fill(captureHistory, -699);
+
+        // Each thread is responsible for clearing their part of shared history
+        sharedHistory.correctionHistory.clear_range(-6, numaThreadIdx, numaTotal);
+        sharedHistory.pawnHistory.clear_range(-1262, numaThreadIdx, numaTotal);
 
-    for (auto& to : continuationCorrectionHistory)
-        for (auto& h : to)
-            h.fill(5);
+        ttMoveHistory = 0;
 
-    for (bool inCheck : {false, true})
-        for (StatsType c : {NoCaptures, Captures})
-            for (auto& to : continuationHistory[inCheck][c])
-                for (auto& h : to)
-                    h.fill(-552);
+        stats_fill(continuationCorrectionHistory, 5);
+
+        for (bool inCheck : {false, true})
+            for (StatsType c : {NoCaptures, Captures})
+                for (auto& to : continuationHistory[inCheck][c])
+                    for (auto& h : to)
+                        h.fill(-552);
+    }
+
+    tbWdlCache.clear();
 
     for (usize i = 1; i < reductions.size(); ++i)
         reductions[i] = int(2834 / 128.0 * std::log(i));
@@ -698,7 +937,7 @@ void Search::Worker::clear() {
 
 
 // Main search function for both PV and non-PV nodes
-template<NodeType nodeType>
+template<NodeType nodeType, bool tbEnabled>
 Value Search::Worker::search(
   Position& pos, Stack* ss, Value alpha, Value beta, Depth depth, bool cutNode) {
 
@@ -795,7 +1034,7 @@ Value Search::Worker::search(
     // Step 4. Transposition table lookup
     excludedMove                   = ss->excludedMove;
     posKey                         = pos.key();
-    auto [ttHit, ttData, ttWriter] = tt.probe(posKey);
+    auto [ttHit, ttData, ttWriter] = tt.probe(posKey, numaAccessToken.get_numa_index());
     // Need further processing of the saved data
     ss->ttHit    = ttHit;
     ttData.move  = rootNode ? rootMoves[pvIdx].pv[0] : ttHit ? ttData.move : Move::none();
@@ -816,7 +1055,7 @@ Value Search::Worker::search(
         // Never assume anything about values stored in TT
         unadjustedStaticEval = ttData.eval;
         if (!is_valid(unadjustedStaticEval))
-            unadjustedStaticEval = evaluate(pos);
+            unadjustedStaticEval = evaluate(pos, alpha, beta);
 
         ss->staticEval = eval = to_corrected_static_eval(unadjustedStaticEval, correctionValue);
 
@@ -827,7 +1066,7 @@ Value Search::Worker::search(
     }
     else
     {
-        unadjustedStaticEval = evaluate(pos);
+        unadjustedStaticEval = evaluate(pos, alpha, beta);
         ss->staticEval = eval = to_corrected_static_eval(unadjustedStaticEval, correctionValue);
 
         // Static evaluation is saved as it was before adjustment by correction history
@@ -877,7 +1116,8 @@ Value Search::Worker::search(
             {
                 pos.do_move(ttData.move, st);
                 Key nextPosKey                             = pos.key();
-                auto [ttHitNext, ttDataNext, ttWriterNext] = tt.probe(nextPosKey);
+                auto [ttHitNext, ttDataNext, ttWriterNext] =
+                  tt.probe(nextPosKey, numaAccessToken.get_numa_index());
                 pos.undo_move(ttData.move);
 
                 // Check that the ttValue after the tt move would also trigger a cutoff
@@ -899,7 +1139,7 @@ Value Search::Worker::search(
     }
 
     // Step 6. Tablebases probe
-    if (!rootNode && !excludedMove && tbConfig.cardinality)
+    if (tbEnabled && !rootNode && !excludedMove && tbConfig.cardinality)
     {
         int piecesCount = pos.count<ALL_PIECES>();
 
@@ -908,7 +1148,7 @@ Value Search::Worker::search(
             && pos.rule50_count() == 0 && !pos.can_castle(ANY_CASTLING))
         {
             TB::ProbeState err;
-            TB::WDLScore   wdl = TB::probe_wdl(pos, &err);
+            TB::WDLScore   wdl = TB::probe_wdl(pos, &err, &tbWdlCache);
 
             // Force check of time on the next occasion
             if (is_mainthread())
@@ -997,7 +1237,8 @@ Value Search::Worker::search(
         Depth R = 7 + depth / 3;
         do_null_move(pos, st, ss);
 
-        Value nullValue = -search<NonPV>(pos, ss + 1, -beta, -beta + 1, depth - R, false);
+        Value nullValue =
+          -search<NonPV, tbEnabled>(pos, ss + 1, -beta, -beta + 1, depth - R, false);
 
         undo_null_move(pos);
 
@@ -1013,7 +1254,7 @@ Value Search::Worker::search(
             // until ply exceeds nmpMinPly.
             nmpMinPly = ss->ply + 3 * (depth - R) / 4;
 
-            Value v = search<NonPV>(pos, ss, beta - 1, beta, depth - R, false);
+            Value v = search<NonPV, tbEnabled>(pos, ss, beta - 1, beta, depth - R, false);
 
             nmpMinPly = 0;
 
@@ -1042,7 +1283,8 @@ Value Search::Worker::search(
     {
         assert(probCutBeta < VALUE_INFINITE && probCutBeta > beta);
 
-        MovePicker mp(pos, ttData.move, probCutBeta - ss->staticEval, &captureHistory);
+        MovePicker mp(pos, ttData.move, probCutBeta - ss->staticEval, &captureHistory, &tt,
+                      numaAccessToken.get_numa_index());
         Depth      probCutDepth = depth - 4 - improving;
 
         while ((move = mp.next_move()) != Move::none())
@@ -1061,8 +1303,8 @@ Value Search::Worker::search(
 
             // If the qsearch held, perform the regular search
             if (value >= probCutBeta && probCutDepth > 0)
-                value = -search<NonPV>(pos, ss + 1, -probCutBeta, -probCutBeta + 1, probCutDepth,
-                                       !cutNode);
+                value = -search<NonPV, tbEnabled>(pos, ss + 1, -probCutBeta, -probCutBeta + 1,
+                                                  probCutDepth, !cutNode);
 
             undo_move(pos, move);
 
@@ -1092,7 +1334,7 @@ moves_loop:  // When in check, search starts here
 
 
     MovePicker mp(pos, ttData.move, depth, &mainHistory, &lowPlyHistory, &captureHistory, contHist,
-                  &sharedHistory, ss->ply);
+                  &sharedHistory, ss->ply, &tt, numaAccessToken.get_numa_index());
 
     value = bestValue;
 
@@ -1117,6 +1359,12 @@ moves_loop:  // When in check, search starts here
         if (rootNode && !std::count(rootMoves.begin() + pvIdx, rootMoves.begin() + pvLast, move))
             continue;
 
+        // In parallel MultiPV the moves pinned to sibling line groups are
+        // theirs alone (see ParallelMultiPV in iterative_deepening)
+        if (rootNode && parallelMultiPV
+            && std::count(pinnedRootMoves.begin(), pinnedRootMoves.end(), move))
+            continue;
+
         ss->moveCount = ++moveCount;
 
         if (rootNode && is_mainthread() && nodes > NODES_LIMIT_OUTPUT)
@@ -1144,6 +1392,13 @@ moves_loop:  // When in check, search starts here
         if (ss->ttPv)
             r += 1006;
 
+        // With root coordination enabled, helper threads reduce root moves that
+        // another thread is already searching. The move is still searched, so
+        // this only reorders effort, steering Lazy SMP towards distinct moves.
+        if (rootNode && coordinateRootMoves && !is_mainthread() && moveCount > 1
+            && threads.root_move_busy(move))
+            r += 600;
+
         // Step 14. Pruning at shallow depths.
         // Depth conditions are important for mate finding.
         if (!rootNode && pos.non_pawn_material(us) && !is_loss(bestValue))
@@ -1233,7 +1488,8 @@ moves_loop:  // When in check, search starts here
             Depth singularDepth = newDepth / 2;
 
             ss->excludedMove = move;
-            value = search<NonPV>(pos, ss, singularBeta - 1, singularBeta, singularDepth, cutNode);
+            value = search<NonPV, tbEnabled>(pos, ss, singularBeta - 1, singularBeta,
+                                             singularDepth, cutNode);
             ss->excludedMove = Move::none();
 
             if (value < singularBeta)
@@ -1281,6 +1537,12 @@ moves_loop:  // When in check, search starts here
 
         u64 nodeCount = rootNode ? u64(nodes) : 0;
 
+        // Claim the root move for the duration of its subtree search, so that
+        // peers running with root coordination can see it is being worked on.
+        const bool claimed = rootNode && coordinateRootMoves;
+        if (claimed)
+            threads.claim_root_move(move);
+
         // Step 16. Make the move
         do_move(pos, move, st, givesCheck, ss);
 
@@ -1338,7 +1600,7 @@ moves_loop:  // When in check, search starts here
             Depth d = std::max(1, std::min(newDepth - r / 1024, newDepth + 2)) + PvNode;
 
             ss->reduction = newDepth - d;
-            value         = -search<NonPV>(pos, ss + 1, -(alpha + 1), -alpha, d, true);
+            value         = -search<NonPV, tbEnabled>(pos, ss + 1, -(alpha + 1), -alpha, d, true);
             ss->reduction = 0;
 
             // Do a full-depth search when reduced LMR search fails high
@@ -1353,7 +1615,9 @@ moves_loop:  // When in check, search starts here
                 newDepth += doDeeperSearch - doShallowerSearch;
 
                 if (newDepth > d)
-                    value = -search<NonPV>(pos, ss + 1, -(alpha + 1), -alpha, newDepth, !cutNode);
+                    value =
+                      -search<NonPV, tbEnabled>(pos, ss + 1, -(alpha + 1), -alpha, newDepth,
+                                                !cutNode);
 
                 // Post LMR continuation history updates
                 update_continuation_histories(ss, movedPiece, move.to_sq(), 1415);
@@ -1368,8 +1632,9 @@ moves_loop:  // When in check, search starts here
                 r += 1085;
 
             // Note that if expected reduction is high, we reduce search depth here
-            value = -search<NonPV>(pos, ss + 1, -(alpha + 1), -alpha,
-                                   newDepth - (r > 5039) - (r > 5223 && newDepth > 2), !cutNode);
+            value = -search<NonPV, tbEnabled>(
+              pos, ss + 1, -(alpha + 1), -alpha,
+              newDepth - (r > 5039) - (r > 5223 && newDepth > 2), !cutNode);
         }
 
         // For PV nodes only, do a full PV search on the first move or after a fail high,
@@ -1386,12 +1651,15 @@ moves_loop:  // When in check, search starts here
                     || ttData.depth > 1))
                 newDepth = std::max(newDepth, 1);
 
-            value = -search<PV>(pos, ss + 1, -beta, -alpha, newDepth, false);
+            value = -search<PV, tbEnabled>(pos, ss + 1, -beta, -alpha, newDepth, false);
         }
 
         // Step 19. Undo move
         undo_move(pos, move);
 
+        if (claimed)
+            threads.release_root_move(move);
+
         assert(value > -VALUE_INFINITE && value < VALUE_INFINITE);
 
         // Step 20. Check for a new best move
@@ -1642,7 +1910,7 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
 
     // Step 3. Transposition table lookup
     posKey                         = pos.key();
-    auto [ttHit, ttData, ttWriter] = tt.probe(posKey);
+    auto [ttHit, ttData, ttWriter] = tt.probe(posKey, numaAccessToken.get_numa_index());
     // Need further processing of the saved data
     ss->ttHit    = ttHit;
     ttData.move  = ttHit ? ttData.move : Move::none();
@@ -1669,7 +1937,7 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
             unadjustedStaticEval = ttData.eval;
 
             if (!is_valid(unadjustedStaticEval))
-                unadjustedStaticEval = evaluate(pos);
+                unadjustedStaticEval = evaluate(pos, alpha, beta);
 
             ss->staticEval = bestValue =
               to_corrected_static_eval(unadjustedStaticEval, correctionValue);
@@ -1681,7 +1949,7 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
         }
         else
         {
-            unadjustedStaticEval = evaluate(pos);
+            unadjustedStaticEval = evaluate(pos, alpha, beta);
             ss->staticEval       = bestValue =
               to_corrected_static_eval(unadjustedStaticEval, correctionValue);
         }
@@ -1704,15 +1972,23 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
         futilityBase = ss->staticEval + 335;
     }
 
-    const PieceToHistory* contHist[] = {(ss - 1)->continuationHistory};
-
     Square prevSq = ((ss - 1)->currentMove).is_ok() ? ((ss - 1)->currentMove).to_sq() : SQ_NONE;
 
-    // Initialize a MovePicker object for the current position, and prepare to search
-    // the moves. We presently use two stages of move generator in quiescence search:
-    // captures, or evasions only when in check.
-    MovePicker mp(pos, ttData.move, DEPTH_QS, &mainHistory, &lowPlyHistory, &captureHistory,
-                  contHist, &sharedHistory, ss->ply);
+    // A capture is futile when even winning its victim outright cannot lift the
+    // static eval above alpha. Hand that bound to the capture generator so such
+    // moves are never materialized at all; the exemptions it grants (possible
+    // checks, promotions, recaptures on prevSq) mirror the pruning conditions
+    // below. Only the fail-soft bestValue bump of the pruned moves is forgone.
+    Value victimThreshold = !is_loss(bestValue) && !is_loss(futilityBase)
+                            ? alpha - futilityBase + 1
+                            : VALUE_ZERO;
+
+    // Initialize a QMovePicker object for the current position, and prepare to
+    // search the moves. We presently use two stages of move generator in
+    // quiescence search: captures, or evasions only when in check.
+    QMovePicker mp(pos, ttData.move, &mainHistory, &captureHistory,
+                   (ss - 1)->continuationHistory, &tt, numaAccessToken.get_numa_index(),
+                   victimThreshold, prevSq);
 
     // Step 5. Loop through all pseudo-legal moves until no moves remain or a beta
     // cutoff occurs.
@@ -1809,7 +2085,7 @@ Value Search::Worker::qsearch(Position& pos, Stack* ss, Value alpha, Value beta)
         Color us = pos.side_to_move();
         if (!(pawn_single_push_bb(us, pos.pieces(us, PAWN)) & ~pos.pieces())
             && !pos.non_pawn_material(us) && type_of(pos.captured_piece()) >= KNIGHT
-            && !MoveList<LEGAL>(pos).size())
+            && LazyLegalMoveList(pos).empty())
             bestValue = VALUE_DRAW;
     }
 
@@ -1840,9 +2116,101 @@ TimePoint Search::Worker::elapsed() const {
     return main_manager()->tm.elapsed([this]() { return threads.nodes_searched(); });
 }
 
-Value Search::Worker::evaluate(const Position& pos) {
+Value Search::Worker::evaluate(const Position& pos, Value alpha, Value beta) {
     return Eval::evaluate(network[numaAccessToken], pos, accumulatorStack, refreshTable,
-                          optimism[pos.side_to_move()]);
+                          optimism[pos.side_to_move()], alpha, beta);
+}
+
+void Search::NodeScheduleRecorder::set_file(const std::string& fname) {
+    std::lock_guard<std::mutex> lk(mutex);
+    file = fname == "<empty>" ? "" : fname;
+    entries.clear();
+}
+
+void Search::NodeScheduleRecorder::start_search(const std::string& fen, bool isChess960) {
+    std::lock_guard<std::mutex> lk(mutex);
+    rootFen  = fen;
+    chess960 = isChess960;
+    entries.clear();
+}
+
+void Search::NodeScheduleRecorder::record(usize threadId, Depth depth, u64 nodes, Move bestMove) {
+    std::lock_guard<std::mutex> lk(mutex);
+    entries.push_back({threadId, depth, nodes, bestMove});
+}
+
+void Search::NodeScheduleRecorder::flush() {
+    std::lock_guard<std::mutex> lk(mutex);
+
+    if (file.empty() || entries.empty())
+        return;
+
+    std::ofstream f(file, std::ios_base::app);
+    f << "search " << rootFen << "\n";
+    for (const Entry& e : entries)
+        f << e.threadId << " " << e.depth << " " << e.nodes << " "
+          << UCIEngine::move(e.bestMove, chess960) << "\n";
+
+    entries.clear();
+}
+
+void Search::TreeRetention::save(Position& rootPos, const RootMoves& rootMoves) {
+    rootKey = rootPos.key();
+    moves.clear();
+    moves.reserve(rootMoves.size());
+
+    StateInfo st;
+    for (const RootMove& rm : rootMoves)
+    {
+        RetainedRootMove rrm;
+        rrm.move             = rm.pv[0];
+        rrm.reply            = rm.pv.size() > 1 ? rm.pv[1] : Move::none();
+        rrm.averageScore     = rm.averageScore;
+        rrm.meanSquaredScore = rm.meanSquaredScore;
+
+        rootPos.do_move(rm.pv[0], st);
+        rrm.keyAfter = rootPos.key();
+        rootPos.undo_move(rm.pv[0]);
+
+        moves.push_back(rrm);
+    }
+
+    valid = true;
+}
+
+void Search::TreeRetention::clear() {
+    valid = false;
+    moves.clear();
+}
+
+const Search::TreeRetention::RetainedRootMove* Search::TreeRetention::find_child(Key key) const {
+    if (valid)
+        for (const RetainedRootMove& rrm : moves)
+            if (rrm.keyAfter == key)
+                return &rrm;
+    return nullptr;
+}
+
+void Search::MultiPVResults::reset(usize lineCount) {
+    std::lock_guard lk(mutex);
+    lines.assign(lineCount, Line{});
+}
+
+void Search::MultiPVResults::publish(usize line, Depth depth, const RootMove& rm) {
+    std::lock_guard lk(mutex);
+
+    // Group members free-run at different depths, so keep only the deepest
+    // completed iteration (fresher results win ties after a re-search)
+    if (line < lines.size() && depth >= lines[line].depth)
+    {
+        lines[line].depth = depth;
+        lines[line].rm    = rm;
+    }
+}
+
+std::vector<Search::MultiPVResults::Line> Search::MultiPVResults::snapshot() const {
+    std::lock_guard lk(mutex);
+    return lines;
 }
 
 namespace {
@@ -1971,7 +2339,7 @@ void update_continuation_histories(Stack* ss, Piece pc, Square to, int bonus) {
 
         if (((ss - i)->currentMove).is_ok())
         {
-            auto& historyEntry = (*(ss - i)->continuationHistory)[pc][to];
+            auto historyEntry = (*(ss - i)->continuationHistory)[pc][to];
             if (historyEntry > 0)
                 positiveCount++;
 
@@ -2036,18 +2404,45 @@ void SearchManager::check_time(Search::Worker& worker) {
     if (--callsCnt > 0)
         return;
 
-    // When using nodes, ensure checking rate is not lower than 0.1% of nodes
-    callsCnt = worker.limits.nodes ? std::min(512, int(worker.limits.nodes / 1024)) : 512;
-
     static TimePoint lastInfoTime = now();
 
-    TimePoint elapsed = tm.elapsed([&worker]() { return worker.threads.nodes_searched(); });
+    // One cross-thread sum per poll; everything below reuses it
+    const u64 totalNodes = worker.threads.nodes_searched();
+
+    TimePoint elapsed = tm.elapsed([totalNodes]() { return totalNodes; });
+
+    // Adapt the polling interval to the observed node rate, so the cost of
+    // clock reads scales with NPS: aim for about one check per millisecond,
+    // with the old fixed 512 as the floor.
+    if (elapsed > lastPollElapsed)
+        pollInterval = std::clamp(int(pollInterval / (elapsed - lastPollElapsed)), 512, 16384);
+    else if (elapsed == lastPollElapsed)  // several checks within one millisecond
+        pollInterval = std::min(2 * pollInterval, 16384);
+    lastPollElapsed = elapsed;
+
+    // When using nodes, ensure checking rate is not lower than 0.1% of nodes
+    callsCnt =
+      worker.limits.nodes ? std::min(pollInterval, int(worker.limits.nodes / 1024)) : pollInterval;
     TimePoint tick    = worker.limits.startTime + elapsed;
 
+    // Only called from the main thread, so rootDepth and selDepth are ours
+    if (Telemetry::Slot* t = worker.threads.telemetry.slot())
+    {
+        t->nodes     = totalNodes;
+        t->elapsedMs = u64(elapsed);
+        t->nps       = elapsed > 0 ? 1000 * totalNodes / u64(elapsed) : 0;
+        t->rootDepth    = u32(worker.rootDepth);
+        t->selDepth     = u32(worker.selDepth);
+    }
+
     if (tick - lastInfoTime >= 1000)
     {
         lastInfoTime = tick;
         dbg_print();
+
+        // Sampling 1000 clusters is too slow for every tick, but fine here
+        if (Telemetry::Slot* t = worker.threads.telemetry.slot())
+            t->hashfull = u32(worker.tt.hashfull());
     }
 
     // We should not stop pondering until told so by the GUI
@@ -2056,7 +2451,7 @@ void SearchManager::check_time(Search::Worker& worker) {
 
     if ((worker.limits.use_time_management() && (elapsed > tm.maximum() || stopOnPonderhit))
         || (worker.limits.movetime && elapsed >= worker.limits.movetime)
-        || (worker.limits.nodes && worker.threads.nodes_searched() >= worker.limits.nodes))
+        || (worker.limits.nodes && totalNodes >= worker.limits.nodes))
         worker.threads.stop = true;
 }
 
@@ -2207,47 +2602,70 @@ void SearchManager::pv(Search::Worker&           worker,
     usize      multiPV   = std::min(usize(worker.options["MultiPV"]), rootMoves.size());
     u64        tbHits    = threads.tb_hits() + (worker.tbConfig.rootInTB ? rootMoves.size() : 0);
 
+    // Every line is converted with the root position's parameters, so fetch
+    // them (and the option) once instead of per line.
+    const WinRateParams wrp     = UCIEngine::win_rate_params(pos);
+    const bool          showWDL = worker.options["UCI_ShowWDL"];
+
+    // In a concurrent MultiPV search the sibling lines are deepened by other
+    // line groups, so merge their freshest published results with this
+    // worker's own line. Each merged line reports the depth its group has
+    // actually completed.
+    std::vector<MultiPVResults::Line> merged;
+    if (worker.parallelMultiPV)
+    {
+        merged.push_back({depth, rootMoves[0]});
+        for (auto& line : threads.multiPVResults.snapshot())
+            if (line.depth && !(line.rm == merged[0].rm.pv[0]))
+                merged.push_back(std::move(line));
+
+        std::stable_sort(merged.begin(), merged.end(),
+                         [](const auto& a, const auto& b) { return a.rm < b.rm; });
+        multiPV = std::min(multiPV, merged.size());
+    }
+
     for (usize i = 0; i < multiPV; ++i)
     {
-        bool usePreviousScore = rootMoves[i].score == -VALUE_INFINITE;
+        RootMove&   rm        = worker.parallelMultiPV ? merged[i].rm : rootMoves[i];
+        const Depth lineDepth = worker.parallelMultiPV ? merged[i].depth : depth;
+
+        bool usePreviousScore = rm.score == -VALUE_INFINITE;
 
-        if (depth == 1 && usePreviousScore && i > 0)
+        if (lineDepth == 1 && usePreviousScore && i > 0)
             continue;
 
-        Depth d = usePreviousScore ? std::max(1, depth - 1) : depth;
-        Value v = usePreviousScore ? rootMoves[i].previousScore : rootMoves[i].uciScore;
+        Depth d = usePreviousScore ? std::max(1, lineDepth - 1) : lineDepth;
+        Value v = usePreviousScore ? rm.previousScore : rm.uciScore;
 
         if (v == -VALUE_INFINITE)
             v = VALUE_ZERO;
 
         bool isTBScore = worker.tbConfig.rootInTB && !is_mate_or_mated(v);
-        v              = isTBScore ? rootMoves[i].tbScore : v;
+        v              = isTBScore ? rm.tbScore : v;
 
         // Potentially correct and extend the PV, and in exceptional cases v.
         // Previous PVs have already been extended. Bound flags indicate an unreliable PV.
         if (is_decisive(v) && !is_mate_or_mated(v) && !usePreviousScore
-            && (!rootMoves[i].score_is_bound() || isTBScore))
-            syzygy_extend_pv(worker.options, worker.limits, pos, rootMoves[i], v);
+            && (!rm.score_is_bound() || isTBScore))
+            syzygy_extend_pv(worker.options, worker.limits, pos, rm, v);
 
         std::string pv;
-        for (Move m : usePreviousScore ? rootMoves[i].previousPV : rootMoves[i].pv)
+        for (Move m : usePreviousScore ? rm.previousPV : rm.pv)
             pv += UCIEngine::move(m, pos.is_chess960()) + " ";
 
         // Remove last whitespace
         if (!pv.empty())
             pv.pop_back();
 
-        auto wdl   = worker.options["UCI_ShowWDL"] ? UCIEngine::wdl(v, pos) : "";
-        auto bound = rootMoves[i].scoreLowerbound
-                     ? "lowerbound"
-                     : (rootMoves[i].scoreUpperbound ? "upperbound" : "");
+        auto wdl   = showWDL ? UCIEngine::wdl(v, wrp) : "";
+        auto bound = rm.scoreLowerbound ? "lowerbound" : (rm.scoreUpperbound ? "upperbound" : "");
 
         InfoFull info;
 
         info.depth    = d;
-        info.selDepth = rootMoves[i].selDepth;
+        info.selDepth = rm.selDepth;
         info.multiPV  = i + 1;
-        info.score    = {v, pos};
+        info.score    = {v, wrp};
         info.wdl      = wdl;
 
         // TB and previous scores are exact, even though their bound flags may say otherwise.
@@ -2280,7 +2698,7 @@ bool RootMove::extract_ponder_from_tt(const TranspositionTable& tt, Position& po
     if (!pos.is_draw(1))
     {
         auto [ttHit, ttData, ttWriter] = tt.probe(pos.key());
-        if (ttHit && MoveList<LEGAL>(pos).contains(ttData.move))
+        if (ttHit && LazyLegalMoveList(pos).contains(ttData.move))
             pv.push_back(ttData.move);
     }
 
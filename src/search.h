@@ -26,6 +26,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -51,6 +52,7 @@ enum NodeType {
     Root
 };
 
+class Engine;
 class TranspositionTable;
 class ThreadPool;
 class OptionsMap;
@@ -100,25 +102,31 @@ struct PVMoves {
 
 // Stack struct keeps track of the information we need to remember from nodes
 // shallower and deeper in the tree during the search. Each search thread has
-// its own array of Stack objects, indexed by the current ply.
-struct Stack {
-    PVMoves*                    pv;
+// its own array of Stack objects, indexed by the current ply. The struct is
+// padded to cache-line size so that each ply occupies exactly one line and
+// the frequent (ss-1)/(ss+1) accesses never straddle a boundary.
+struct alignas(64) Stack {
     PieceToHistory*             continuationHistory;
     CorrectionHistory<PieceTo>* continuationCorrectionHistory;
-    int                         ply;
+    PVMoves*                    pv;
     Move                        currentMove;
     Move                        excludedMove;
     Value                       staticEval;
     int                         statScore;
+    int                         ply;
     int                         moveCount;
+    int                         cutoffCnt;
+    int                         reduction;
     bool                        inCheck;
     bool                        ttPv;
     bool                        ttHit;
     bool                        followPV;
-    int                         cutoffCnt;
-    int                         reduction;
 };
 
+#ifdef IS_64BIT
+static_assert(sizeof(Stack) == 64, "One search ply is expected to fit a single cache line");
+#endif
+
 
 // RootMove struct is used for moves at the root of the tree. For each root move
 // we store a score and a PV (really a refutation in the case of moves which
@@ -156,6 +164,23 @@ struct RootMove {
 using RootMoves = std::vector<RootMove>;
 
 
+// Root statistics captured by Engine::save_search_state() and re-applied to
+// the freshly generated root moves on the next 'go' for the same position,
+// so a resumed analysis re-enters its aspiration windows and move ordering
+// instead of starting over. One-shot: the first start_thinking() consumes it.
+struct RootResumeSeed {
+    struct Entry {
+        Move    move;
+        Value   previousScore, averageScore, meanSquaredScore, uciScore;
+        bool    previousScoreExact;
+        int     selDepth;
+        PVMoves previousPV;
+    };
+    Key                positionKey;
+    std::vector<Entry> entries;
+};
+
+
 // LimitsType struct stores information sent by the caller about the analysis required.
 struct LimitsType {
 
@@ -184,18 +209,110 @@ struct SharedState {
                 ThreadPool&                                              threadPool,
                 TranspositionTable&                                      transpositionTable,
                 std::map<NumaIndex, SharedHistories>&                    sharedHists,
-                const LazyNumaReplicatedSystemWide<Eval::NNUE::Network>& net) :
+                const LazyNumaReplicatedSystemWide<Eval::NNUE::Network>& net,
+                SharedHistoryRegion*                                     crossProcHist = nullptr) :
         options(optionsMap),
         threads(threadPool),
         tt(transpositionTable),
         sharedHistories(sharedHists),
-        network(net) {}
+        network(net),
+        crossProcessHistory(crossProcHist) {}
 
     const OptionsMap&                                        options;
     ThreadPool&                                              threads;
     TranspositionTable&                                      tt;
     std::map<NumaIndex, SharedHistories>&                    sharedHistories;
     const LazyNumaReplicatedSystemWide<Eval::NNUE::Network>& network;
+    // Non-null when the dynamically sized histories live in a cross-process
+    // shared memory region instead of per-NUMA-node allocations
+    SharedHistoryRegion* crossProcessHistory;
+};
+
+// Records, per worker and per finished root iteration, the depth, cumulative
+// node count and currently best root move, and appends them to a compact text
+// schedule file. The schedule makes nondeterministic multithreaded runs
+// inspectable offline: the 'replaysched' UCI command (see uci.cpp) re-executes
+// the main thread's iteration sequence single-threaded from a clean TT, which
+// is deterministic run to run, and reports replayed vs recorded node counts.
+// Enabled through the NodeScheduleFile option; disabled recording costs one
+// predictable branch per iteration.
+class NodeScheduleRecorder {
+   public:
+    // An empty (or "<empty>") file name disables recording
+    void set_file(const std::string& fname);
+    bool enabled() const { return !file.empty(); }
+
+    void start_search(const std::string& fen, bool chess960);
+    void record(usize threadId, Depth depth, u64 nodes, Move bestMove);
+    // Appends this search's entries to the file. Called once per search by
+    // the main thread, after the workers have finished.
+    void flush();
+
+   private:
+    struct Entry {
+        usize threadId;
+        Depth depth;
+        u64   nodes;
+        Move  bestMove;
+    };
+
+    std::mutex         mutex;
+    std::string        file, rootFen;
+    bool               chess960 = false;
+    std::vector<Entry> entries;
+};
+
+// Root statistics retained from the previous search, so that consecutive 'go'
+// calls do not start entirely from scratch: in analysis sessions nearly every
+// new root either equals the old one or follows it by a single played move.
+// When the new root matches, the retained scores seed the first aspiration
+// windows (the averageScore/meanSquaredScore logic in iterative_deepening) and
+// the retained ordering, or the expected reply from the played move's PV,
+// seeds the initial root move order. Written by the main thread after each
+// search and read by every worker at the start of the next one; never touched
+// while a search runs.
+struct TreeRetention {
+
+    struct RetainedRootMove {
+        Move  move;    // root move of the previous search
+        Move  reply;   // expected reply, i.e. the second move of its PV
+        Key   keyAfter;// position key after playing 'move' from the old root
+        Value averageScore;
+        Value meanSquaredScore;
+    };
+
+    void save(Position& rootPos, const RootMoves& rootMoves);
+    void clear();
+
+    bool same_root(Key key) const { return valid && key == rootKey; }
+    // The retained entry whose move leads from the old root to 'key', or nullptr
+    const RetainedRootMove* find_child(Key key) const;
+
+    bool                          valid   = false;
+    Key                           rootKey = 0;
+    std::vector<RetainedRootMove> moves;
+};
+
+// Per-line results of a concurrent MultiPV search (see the ParallelMultiPV
+// logic in iterative_deepening). Each line group publishes its pinned line
+// after every completed iteration; the main thread merges the freshest
+// results when reporting, and the regular best-thread vote arbitrates the
+// final move across the groups. A mutex is fine here because groups publish
+// once per iteration, not per node.
+struct MultiPVResults {
+
+    struct Line {
+        Depth    depth = 0;  // 0 until the group completes its first iteration
+        RootMove rm{Move::none()};
+    };
+
+    void              reset(usize lineCount);
+    void              publish(usize line, Depth depth, const RootMove& rm);
+    std::vector<Line> snapshot() const;
+
+   private:
+    mutable std::mutex mutex;
+    std::vector<Line>  lines;
 };
 
 class Worker;
@@ -290,6 +407,8 @@ class SearchManager: public ISearchManager {
     Stockfish::TimeManagement tm;
     double                    originalTimeAdjust;
     int                       callsCnt;
+    int                       pollInterval    = 512;  // nodes between time checks, adaptive
+    TimePoint                 lastPollElapsed = 0;
     std::atomic_bool          ponder;
 
     std::array<Value, 4> iterValue;
@@ -344,6 +463,18 @@ class Worker {
    private:
     bool iterative_deepening();
 
+    // Depth-first proof-number search used for "go mate N" when the
+    // ProofNumberSearch option is enabled; implemented in pns.cpp.
+    void pns_search();
+
+    // Low-priority maintenance run by the main thread on the idle cycles
+    // between its bestmove and the next command; see ThreadPool::abortIdle.
+    void idle_maintenance();
+
+    // Claims the next batch of node tokens from the pool-wide bucket,
+    // raising the stop once the bucket is exhausted; see nodeTokens.
+    void refill_node_tokens();
+
     void do_move(Position& pos, const Move move, StateInfo& st, Stack* const ss);
     void
     do_move(Position& pos, const Move move, StateInfo& st, const bool givesCheck, Stack* const ss);
@@ -351,8 +482,11 @@ class Worker {
     void undo_move(Position& pos, const Move move);
     void undo_null_move(Position& pos);
 
-    // This is the main search function, for both PV and non-PV nodes
-    template<NodeType nodeType>
+    // This is the main search function, for both PV and non-PV nodes. The
+    // tbEnabled parameter folds the Syzygy probing code away at compile time:
+    // the variant without tablebases is selected once per search when no
+    // tables are configured, so the common case pays no dead branches.
+    template<NodeType nodeType, bool tbEnabled>
     Value search(Position& pos, Stack* ss, Value alpha, Value beta, Depth depth, bool cutNode);
 
     // Quiescence search function, which is called by the main search
@@ -369,13 +503,25 @@ class Worker {
 
     TimePoint elapsed() const;
 
-    Value evaluate(const Position&);
+    Value evaluate(const Position&, Value alpha = -VALUE_INFINITE, Value beta = VALUE_INFINITE);
 
     LimitsType limits;
 
     usize              pvIdx, pvLast;
     RelaxedAtomic<u64> nodes, tbHits, bestMoveChanges;
+
+    // Node-limit tokens held by this worker; decremented per node and
+    // refilled in batches from ThreadPool::nodeBudget, so enforcing
+    // limits.nodes costs one shared fetch_sub per batch instead of a
+    // cross-thread sum per poll. See refill_node_tokens().
+    i64 nodeTokens = 0;
     int                selDepth, nmpMinPly;
+    bool               coordinateRootMoves;
+
+    // Concurrent MultiPV state (see ParallelMultiPV in iterative_deepening)
+    bool              parallelMultiPV = false;
+    usize             pvGroup         = 0;
+    std::vector<Move> pinnedRootMoves;
 
     Value optimism[COLOR_NB];
 
@@ -398,6 +544,9 @@ class Worker {
 
     Tablebases::Config tbConfig;
 
+    // Thread-local cache of recent WDL probe results
+    Tablebases::WDLCache tbWdlCache;
+
     const OptionsMap&                                        options;
     ThreadPool&                                              threads;
     TranspositionTable&                                      tt;
@@ -407,6 +556,7 @@ class Worker {
     Eval::NNUE::AccumulatorStack  accumulatorStack;
     Eval::NNUE::AccumulatorCaches refreshTable;
 
+    friend class Stockfish::Engine;
     friend class Stockfish::ThreadPool;
     friend class SearchManager;
 };
@@ -0,0 +1,291 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "selfplay.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#include "engine.h"
+#include "movegen.h"
+#include "position.h"
+#include "search.h"
+#include "uci.h"
+
+namespace Stockfish::Selfplay {
+
+namespace {
+
+// Outcome of a single game, from White's point of view.
+enum GameOutcome {
+    WHITE_WINS,
+    BLACK_WINS,
+    DRAWN
+};
+
+struct GameResult {
+    GameOutcome outcome;
+    const char* reason;
+    int         plies;
+};
+
+// Plays out one game between the two engines, both of which must already
+// have their bestmove listener wired to 'bestmove'. The harness keeps its
+// own Position purely for move validation and adjudication; the engines are
+// always fed the opening FEN plus the full move list, exactly as a GUI
+// would, so their usual game-history handling (repetitions, rule50) works
+// unchanged.
+GameResult play_game(Engine&            white,
+                     Engine&            black,
+                     const std::string& fen,
+                     const Config&      config,
+                     std::string&       bestmove) {
+
+    Position     pos;
+    StateListPtr states(new StateList(1));
+    pos.set(fen, false, &states->back());
+
+    std::vector<std::string> moves;
+    TimePoint                clock[COLOR_NB] = {config.baseTime, config.baseTime};
+    const bool               useClock = !config.depth && !config.movetime && config.baseTime;
+
+    while (true)
+    {
+        const Color stm = pos.side_to_move();
+
+        if (MoveList<LEGAL>(pos).size() == 0)
+            return {pos.checkers() ? (stm == WHITE ? BLACK_WINS : WHITE_WINS) : DRAWN,
+                    pos.checkers() ? "checkmate" : "stalemate", int(moves.size())};
+
+        // The ply argument makes any repetition of an earlier position count
+        // as a draw, which for adjudication is the usual shortcut: neither
+        // engine will make progress from a position it was happy to repeat.
+        if (pos.is_draw(int(moves.size())) || pos.count<ALL_PIECES>() == 2)
+            return {DRAWN, "draw", int(moves.size())};
+
+        if (int(moves.size()) >= config.maxPlies)
+            return {DRAWN, "maxplies", int(moves.size())};
+
+        Engine& engine = stm == WHITE ? white : black;
+        engine.set_position(fen, moves);
+
+        if (config.onThink)
+            config.onThink(engine);
+
+        Search::LimitsType limits;
+        limits.startTime = now();
+
+        if (config.depth)
+            limits.depth = config.depth;
+        else if (config.movetime)
+            limits.movetime = config.movetime;
+        else
+        {
+            limits.time[WHITE] = clock[WHITE];
+            limits.time[BLACK] = clock[BLACK];
+            limits.inc[WHITE] = limits.inc[BLACK] = config.increment;
+        }
+
+        bestmove.clear();
+        engine.go(limits);
+        engine.wait_for_search_finished();
+
+        if (useClock)
+        {
+            clock[stm] -= now() - limits.startTime;
+            if (clock[stm] < 0)
+                return {stm == WHITE ? BLACK_WINS : WHITE_WINS, "timeforfeit", int(moves.size())};
+            clock[stm] += config.increment;
+        }
+
+        Move m = UCIEngine::to_move(pos, bestmove);
+        if (m == Move::none())
+            return {stm == WHITE ? BLACK_WINS : WHITE_WINS, "illegalmove", int(moves.size())};
+
+        states->emplace_back();
+        pos.do_move(m, states->back());
+        moves.push_back(bestmove);
+    }
+}
+
+}  // namespace
+
+
+Config parse(std::istream& args) {
+
+    Config      config;
+    std::string token;
+
+    while (args >> token)
+    {
+        const auto  pos   = token.find('=');
+        std::string name  = token.substr(0, pos);
+        std::string value = pos == std::string::npos ? "" : token.substr(pos + 1);
+
+        if (name == "games")
+            config.games = std::stoi(value);
+        else if (name == "depth")
+            config.depth = std::stoi(value);
+        else if (name == "movetime")
+            config.movetime = std::stoll(value);
+        else if (name == "maxplies")
+            config.maxPlies = std::stoi(value);
+        else if (name == "fenfile")
+            config.fenFile = value;
+        else if (name == "tc")
+        {
+            const auto plus  = value.find('+');
+            config.baseTime  = TimePoint(1000 * std::stod(value.substr(0, plus)));
+            config.increment = plus == std::string::npos
+                               ? TimePoint(0)
+                               : TimePoint(1000 * std::stod(value.substr(plus + 1)));
+        }
+    }
+
+    // Without an explicit limit a fixed-depth match is the cheapest sane
+    // default, and stays reproducible across machines.
+    if (!config.depth && !config.movetime && !config.baseTime)
+        config.depth = 10;
+
+    return config;
+}
+
+
+std::vector<std::string> openings(const Config& config) {
+
+    std::vector<std::string> fens;
+
+    if (!config.fenFile.empty())
+    {
+        std::ifstream file(config.fenFile);
+        std::string   line;
+        while (std::getline(file, line))
+            if (!is_whitespace(line))
+                fens.push_back(line);
+    }
+    if (fens.empty())
+        fens.emplace_back(StartFEN);
+
+    return fens;
+}
+
+
+double play_pair(Engine& first, Engine& second, const std::string& fen, const Config& config) {
+
+    std::string bestmove;
+
+    for (Engine* e : {&first, &second})
+    {
+        e->set_on_iter([](const auto&) {});
+        e->set_on_update_no_moves([](const auto&) {});
+        e->set_on_update_full([](const auto&) {});
+        e->set_on_verify_network([](const auto&) {});
+        e->set_on_bestmove(
+          [&](std::string_view bm, std::string_view) { bestmove = std::string(bm); });
+    }
+
+    double score = 0.0;
+
+    for (int game = 0; game < 2; ++game)
+    {
+        const bool firstIsWhite = game == 0;
+
+        first.search_clear();
+        second.search_clear();
+
+        GameResult result = play_game(firstIsWhite ? first : second,
+                                      firstIsWhite ? second : first, fen, config, bestmove);
+
+        score += result.outcome == DRAWN                        ? 0.5
+               : (result.outcome == WHITE_WINS) == firstIsWhite ? 1.0
+                                                                : 0.0;
+    }
+
+    return score;
+}
+
+
+void run(Engine& first, Engine& second, const Config& config) {
+
+    std::string bestmove;
+
+    for (Engine* e : {&first, &second})
+    {
+        e->set_on_iter([](const auto&) {});
+        e->set_on_update_no_moves([](const auto&) {});
+        e->set_on_update_full([](const auto&) {});
+        e->set_on_verify_network([](const auto&) {});
+        e->set_on_bestmove(
+          [&](std::string_view bm, std::string_view) { bestmove = std::string(bm); });
+    }
+
+    const std::vector<std::string> fens = openings(config);
+
+    int firstWins = 0, draws = 0, firstLosses = 0;
+
+    for (int game = 0; game < config.games; ++game)
+    {
+        // Two games per opening, colors swapped, so an unbalanced opening
+        // does not bias the match.
+        const std::string& fen          = fens[usize(game / 2) % fens.size()];
+        const bool         firstIsWhite = game % 2 == 0;
+
+        first.search_clear();
+        second.search_clear();
+
+        GameResult result = play_game(firstIsWhite ? first : second,
+                                      firstIsWhite ? second : first, fen, config, bestmove);
+
+        if (result.outcome == DRAWN)
+            draws++;
+        else if ((result.outcome == WHITE_WINS) == firstIsWhite)
+            firstWins++;
+        else
+            firstLosses++;
+
+        sync_cout << "selfplay game=" << game + 1                                      //
+                  << " white=" << (firstIsWhite ? "first" : "second")                  //
+                  << " result="                                                        //
+                  << (result.outcome == WHITE_WINS  ? "1-0"
+                      : result.outcome == BLACK_WINS ? "0-1"
+                                                     : "1/2-1/2")                      //
+                  << " plies=" << result.plies                                         //
+                  << " reason=" << result.reason << sync_endl;
+    }
+
+    const int    games = firstWins + draws + firstLosses;
+    const double score = games ? (firstWins + 0.5 * draws) / games : 0.5;
+
+    std::ostringstream elo;
+    if (score <= 0.0 || score >= 1.0)
+        elo << (score >= 1.0 ? "+inf" : "-inf");
+    else
+        elo << int(std::round(-400.0 * std::log10(1.0 / score - 1.0)));
+
+    sync_cout << "selfplay-result games=" << games      //
+              << " first_wins=" << firstWins            //
+              << " draws=" << draws                     //
+              << " first_losses=" << firstLosses        //
+              << " score=" << score                     //
+              << " elo=" << elo.str() << sync_endl;
+}
+
+}  // namespace Stockfish::Selfplay
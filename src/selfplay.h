@@ -0,0 +1,81 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SELFPLAY_H_INCLUDED
+#define SELFPLAY_H_INCLUDED
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "misc.h"
+#include "types.h"
+
+namespace Stockfish {
+
+class Engine;
+
+namespace Selfplay {
+
+// Match configuration parsed from the 'selfplay' command:
+//
+//   selfplay [games=2] [depth=0] [movetime=0] [tc=base+inc] [maxplies=600]
+//            [fenfile=<file>]
+//
+// Exactly one of depth, movetime or tc selects the per-move limit (depth
+// wins, then movetime, then tc). tc is a per-game time control in seconds,
+// e.g. tc=10+0.1; the clocks are managed here and handed to the engines'
+// normal time management. Openings come from fenfile (one FEN per line,
+// cycled, two games per opening with colors swapped) or the start position.
+struct Config {
+    int         games    = 2;
+    int         depth    = 0;
+    TimePoint   movetime = 0;
+    TimePoint   baseTime = 0, increment = 0;
+    int         maxPlies = 600;
+    std::string fenFile;
+
+    // Invoked just before an engine starts thinking on a move. The SPSA
+    // harness uses it to swap that engine's parameter set into the shared
+    // tunables; leave empty for a plain match.
+    std::function<void(Engine&)> onThink;
+};
+
+Config parse(std::istream& args);
+
+// Opening FENs for a match: the fenfile contents (one FEN per line) or, if
+// none was given or the file is empty, just the start position.
+std::vector<std::string> openings(const Config& config);
+
+// Plays one pair of games (colors swapped) from the given opening and
+// returns the first engine's score in game points, 0 to 2 in half-point
+// steps. Wires its own listeners; both engines must be idle.
+double play_pair(Engine& first, Engine& second, const std::string& fen, const Config& config);
+
+// Plays the configured match between the two engines, printing one
+// machine-readable result line per game and a final summary with the score
+// and an Elo estimate from the first engine's point of view. Blocking; both
+// engines must be idle and the caller owns their listener configuration.
+void run(Engine& first, Engine& second, const Config& config);
+
+}  // namespace Selfplay
+
+}  // namespace Stockfish
+
+#endif  // #ifndef SELFPLAY_H_INCLUDED
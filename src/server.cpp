@@ -0,0 +1,173 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "server.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "misc.h"
+#include "tune.h"
+#include "uci.h"
+
+#ifndef _WIN32
+    #include <cerrno>
+    #include <csignal>
+    #include <cstring>
+    #include <vector>
+
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+namespace Stockfish::Server {
+
+#ifndef _WIN32
+
+namespace {
+
+volatile sig_atomic_t stopRequested = 0;
+
+void handle_term(int) { stopRequested = 1; }
+
+// Worker body, reached only in the forked child. Constructs the engine
+// before blocking in accept(), so from the client's point of view session
+// acquisition is just the kernel handing out the connection. The connection
+// is then spliced over stdin/stdout and the ordinary UCI loop runs until the
+// client quits or disconnects; the worker exits afterwards and the parent
+// forks a warm replacement, so every session starts from pristine state.
+[[noreturn]] void worker_session(int listenFd, char* argv[]) {
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+
+    UCIEngine uci(1, argv);
+    Tune::init(uci.engine_options());
+
+    const int conn = accept(listenFd, nullptr, nullptr);
+    if (conn < 0)
+        std::_Exit(EXIT_FAILURE);
+
+    dup2(conn, STDIN_FILENO);
+    dup2(conn, STDOUT_FILENO);
+    close(conn);
+    close(listenFd);
+
+    std::cout << engine_info() << std::endl;
+    uci.loop();
+    std::cout.flush();
+
+    std::_Exit(EXIT_SUCCESS);
+}
+
+}  // namespace
+
+int serve(int argc, char* argv[]) {
+
+    std::string path    = "stockfish.sock";
+    int         workers = 4;
+
+    if (argc >= 3)
+        path = argv[2];
+    for (int i = 3; i < argc; ++i)
+        if (std::string arg = argv[i]; arg.rfind("workers=", 0) == 0)
+            workers = std::max(1, std::atoi(arg.c_str() + 8));
+
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path))
+    {
+        std::cerr << "Socket path too long: " << path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    unlink(path.c_str());
+
+    const int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    addr.sun_family    = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0
+        || listen(listenFd, SOMAXCONN) < 0)
+    {
+        std::cerr << "Failed to listen on " << path << ": " << std::strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    sync_cout << "info string serving UCI sessions on " << path << " with " << workers
+              << " preforked workers" << sync_endl;
+
+    // A worker writing to a client that already disconnected must not take
+    // the pool down.
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, handle_term);
+    std::signal(SIGTERM, handle_term);
+
+    auto spawn = [&]() {
+        const pid_t pid = fork();
+        if (pid == 0)
+            worker_session(listenFd, argv);
+        return pid;
+    };
+
+    std::vector<pid_t> pids;
+    for (int i = 0; i < workers; ++i)
+        pids.push_back(spawn());
+
+    // Keep the pool at full strength: whenever a worker finishes its session
+    // (or dies), fork a fresh one off the warm parent image.
+    while (!stopRequested)
+    {
+        const pid_t done = waitpid(-1, nullptr, 0);
+        if (done < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        for (pid_t& pid : pids)
+            if (pid == done)
+                pid = spawn();
+    }
+
+    for (pid_t pid : pids)
+        if (pid > 0)
+            kill(pid, SIGTERM);
+    while (waitpid(-1, nullptr, 0) > 0)
+    {}
+
+    close(listenFd);
+    unlink(path.c_str());
+
+    return EXIT_SUCCESS;
+}
+
+#else
+
+int serve(int, char*[]) {
+    std::cerr << "Server mode requires Unix domain sockets and is not available on Windows."
+              << std::endl;
+    return EXIT_FAILURE;
+}
+
+#endif
+
+}  // namespace Stockfish::Server
@@ -0,0 +1,36 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SERVER_H_INCLUDED
+#define SERVER_H_INCLUDED
+
+namespace Stockfish::Server {
+
+// Engine pool server mode, entered through "stockfish serve <socket-path>
+// [workers=N]". The parent process performs all one-time initialization
+// (attack tables, the embedded network mapping) and then preforks N workers
+// that inherit the warm pages copy-on-write. Each worker constructs its
+// engine up front and blocks in accept() on a shared Unix domain socket, so
+// a connecting client is served a ready engine immediately instead of paying
+// full process startup; a worker serves one UCI session over its connection
+// and exits, and the parent forks a fresh replacement. POSIX only.
+int serve(int argc, char* argv[]);
+
+}  // namespace Stockfish::Server
+
+#endif  // #ifndef SERVER_H_INCLUDED
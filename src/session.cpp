@@ -0,0 +1,319 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "session.h"
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include "engine.h"
+#include "misc.h"
+#include "uci.h"
+
+namespace Stockfish {
+
+namespace {
+
+// One scheduling quantum; a session of priority p runs p quanta per slice.
+// Long enough that restarting iterative deepening from the shared TT is
+// cheap relative to the slice, short enough that twenty sessions still all
+// make visible progress every few seconds.
+constexpr TimePoint QuantumMs = 200;
+
+constexpr int MaxPriority = 64;
+
+}  // namespace
+
+
+SessionManager::SessionManager(Engine& e) :
+    engine(e) {
+
+    // The manager owns the update listeners for its whole lifetime; results
+    // are attributed to whichever session is on the pool right now. The
+    // caller restores its own listeners after discarding the manager.
+    engine.set_on_update_full([this](const Engine::InfoFull& i) {
+        std::lock_guard lk(mutex);
+        if (active)
+        {
+            active->lastDepth    = i.depth;
+            active->lastSelDepth = i.selDepth;
+            active->lastScore    = UCIEngine::format_score(i.score);
+            active->lastPv       = std::string(i.pv);
+        }
+    });
+
+    engine.set_on_update_no_moves([this](const Engine::InfoShort&) {
+        std::lock_guard lk(mutex);
+        if (active)
+            active->bestmove = "(none)";
+    });
+
+    engine.set_on_bestmove([this](std::string_view bm, std::string_view pn) {
+        std::lock_guard lk(mutex);
+        if (active)
+        {
+            active->bestmove = std::string(bm);
+            active->ponder   = std::string(pn);
+        }
+    });
+
+    engine.set_on_iter([](const Engine::InfoIter&) {});
+}
+
+
+SessionManager::~SessionManager() {
+    {
+        std::lock_guard lk(mutex);
+        quit = true;
+    }
+    cv.notify_all();
+    engine.stop();
+
+    if (scheduler.joinable())
+        scheduler.join();
+}
+
+
+SessionManager::Session* SessionManager::find(int id) {
+    for (auto& s : sessions)
+        if (s->id == id)
+            return s.get();
+    return nullptr;
+}
+
+
+// Next runnable session after the round-robin cursor. Priority enters
+// through the slice length, not the pick order, so low-priority sessions
+// are never starved outright.
+SessionManager::Session* SessionManager::pick_next() {
+    for (usize i = 0; i < sessions.size(); ++i)
+    {
+        Session* s = sessions[(cursor + i) % sessions.size()].get();
+        if (s->state == State::Runnable)
+        {
+            cursor = (cursor + i + 1) % sessions.size();
+            return s;
+        }
+    }
+    return nullptr;
+}
+
+
+bool SessionManager::finished(const Session& s) const {
+    return (s.limits.depth && s.lastDepth >= s.limits.depth)
+        || (s.limits.nodes && s.nodes >= s.limits.nodes)
+        || (s.limits.movetime && s.spentMs >= s.limits.movetime);
+}
+
+
+void SessionManager::start_scheduler() {
+    if (!scheduler.joinable())
+        scheduler = std::thread([this] { scheduler_loop(); });
+}
+
+
+void SessionManager::scheduler_loop() {
+
+    std::unique_lock lk(mutex);
+
+    while (!quit)
+    {
+        Session* s = pick_next();
+        if (!s)
+        {
+            cv.wait(lk, [this] {
+                return quit
+                    || std::any_of(sessions.begin(), sessions.end(),
+                                   [](const auto& e) { return e->state == State::Runnable; });
+            });
+            continue;
+        }
+
+        active = s;
+
+        const std::string              fen   = s->fen;
+        const std::vector<std::string> moves = s->moves;
+
+        // Bound this slice by the weighted quantum on top of whatever the
+        // session's own limits have left over
+        Search::LimitsType slice = s->limits;
+        slice.infinite           = 0;
+        slice.startTime          = now();
+        TimePoint quantum        = QuantumMs * s->priority;
+        slice.movetime =
+          s->limits.movetime ? std::min(quantum, s->limits.movetime - s->spentMs) : quantum;
+        if (s->limits.nodes)
+            slice.nodes = s->limits.nodes - s->nodes;
+
+        lk.unlock();
+
+        bool positionOk = !engine.set_position(fen, moves).has_value();
+        if (positionOk)
+        {
+            const TimePoint t0 = now();
+            engine.go(slice);
+            engine.wait_for_search_finished();
+
+            const TimePoint spent       = now() - t0;
+            const u64       sliceNodes  = engine.nodes_searched();
+
+            lk.lock();
+            s->nodes += sliceNodes;
+            s->spentMs += spent;
+        }
+        else
+        {
+            lk.lock();
+            sync_cout << "session " << s->id << " has an invalid position" << sync_endl;
+            s->state = State::Idle;
+        }
+
+        if (s->state == State::Runnable && finished(*s))
+            s->state = State::Stopping;
+
+        if (s->state == State::Stopping)
+        {
+            s->state = State::Idle;
+            sync_cout << "session " << s->id << " bestmove "
+                      << (s->bestmove.empty() ? "(none)" : s->bestmove)
+                      << (s->ponder.empty() ? "" : " ponder " + s->ponder) << sync_endl;
+        }
+        else if (s->state == State::Runnable && s->lastDepth)
+            sync_cout << "session " << s->id << " info depth " << s->lastDepth << " seldepth "
+                      << s->lastSelDepth << " score " << s->lastScore << " nodes " << s->nodes
+                      << " time " << s->spentMs << " pv " << s->lastPv << sync_endl;
+
+        active = nullptr;
+    }
+}
+
+
+bool SessionManager::command(std::istream& args) {
+
+    std::string sub;
+    args >> sub;
+
+    std::lock_guard lk(mutex);
+
+    if (sub == "new")
+    {
+        auto s = std::make_unique<Session>();
+        s->id  = nextId++;
+        s->fen = StartFEN;
+
+        if (std::string token; args >> token && token == "priority")
+            if (int p; args >> p)
+                s->priority = std::clamp(p, 1, MaxPriority);
+
+        sync_cout << "session " << s->id << " created priority " << s->priority << sync_endl;
+        sessions.push_back(std::move(s));
+        return true;
+    }
+
+    if (sub == "list")
+    {
+        for (const auto& s : sessions)
+            sync_cout << "session " << s->id << " priority " << s->priority << " state "
+                      << (s->state == State::Idle ? "idle" : "running") << " depth "
+                      << s->lastDepth << " nodes " << s->nodes << " time " << s->spentMs
+                      << sync_endl;
+        return true;
+    }
+
+    if (sub == "clear")
+        return false;  // caller tears the manager down
+
+    if (sub == "stop")
+    {
+        int  id     = 0;
+        bool one    = bool(args >> id);
+        bool anyRun = false;
+
+        for (auto& s : sessions)
+            if ((!one || s->id == id) && s->state == State::Runnable)
+            {
+                s->state = State::Stopping;
+                anyRun   = true;
+            }
+
+        if (anyRun)
+            engine.stop();  // cut the current slice short as well
+        return true;
+    }
+
+    // Remaining subcommands address one session
+    int      id = 0;
+    Session* s  = (args >> id) ? find(id) : nullptr;
+    if (!s)
+    {
+        sync_cout << "No such session; see session.h for usage" << sync_endl;
+        return true;
+    }
+
+    if (sub == "priority")
+    {
+        if (int p; args >> p)
+            s->priority = std::clamp(p, 1, MaxPriority);
+    }
+    else if (sub == "position")
+    {
+        std::string token, fen;
+        args >> token;
+
+        if (token == "startpos")
+        {
+            fen = StartFEN;
+            args >> token;  // consume 'moves' if present
+        }
+        else if (token == "fen")
+            while (args >> token && token != "moves")
+                fen += token + " ";
+
+        s->fen = fen;
+        s->moves.clear();
+        while (args >> token)
+            s->moves.push_back(token);
+    }
+    else if (sub == "go")
+    {
+        if (s->state != State::Idle)
+        {
+            sync_cout << "session " << id << " is already running" << sync_endl;
+            return true;
+        }
+
+        s->limits = UCIEngine::parse_limits(args);
+        s->nodes = s->spentMs = 0;
+        s->lastDepth = s->lastSelDepth = 0;
+        s->lastScore.clear();
+        s->lastPv.clear();
+        s->bestmove.clear();
+        s->ponder.clear();
+
+        s->state = State::Runnable;
+        start_scheduler();
+        cv.notify_all();
+    }
+    else
+        sync_cout << "Unknown session subcommand '" << sub << "'" << sync_endl;
+
+    return true;
+}
+
+}  // namespace Stockfish
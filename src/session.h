@@ -0,0 +1,118 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SESSION_H_INCLUDED
+#define SESSION_H_INCLUDED
+
+#include <condition_variable>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "search.h"
+#include "types.h"
+
+namespace Stockfish {
+
+class Engine;
+
+// Time-slices several independent analyses over one Engine: one thread pool,
+// one transposition table, one network replica set, instead of one full
+// engine process per analysis. Each session keeps its own position, limits
+// and accumulated statistics; a scheduler thread runs the runnable sessions
+// round-robin, giving each a quantum proportional to its priority. The
+// shared TT means sessions revisiting each other's positions (or their own,
+// after being preempted) restart almost for free.
+//
+// Driven by the 'session' command:
+//
+//   session new [priority <1..64>]            create, prints the new id
+//   session priority <id> <1..64>             reweight a session
+//   session position <id> startpos | fen <fen> [moves <m>...]
+//   session go <id> [depth|nodes|movetime|infinite ...]
+//   session stop [<id>]                       stop one or all sessions
+//   session list                              one status line per session
+//   session clear                             stop everything and tear down
+//
+// While any session exists the manager owns the engine's search and update
+// listeners: results are printed as 'session <id> info ...' lines after each
+// slice and 'session <id> bestmove ...' on completion, and the plain
+// position/go commands must not be used until 'session clear'.
+class SessionManager {
+   public:
+    explicit SessionManager(Engine& e);
+    ~SessionManager();
+
+    SessionManager(const SessionManager&)            = delete;
+    SessionManager& operator=(const SessionManager&) = delete;
+
+    // Handles one 'session' command line; returns false when the command
+    // was 'clear' and the caller should discard the manager (and restore
+    // its own update listeners).
+    bool command(std::istream& args);
+
+   private:
+    enum class State {
+        Idle,      // created or finished, waiting for 'go'
+        Runnable,  // in the scheduler's rotation
+        Stopping   // 'session stop' seen, report and park after this slice
+    };
+
+    struct Session {
+        int   id;
+        int   priority = 1;
+        State state    = State::Idle;
+
+        std::string              fen;
+        std::vector<std::string> moves;
+        Search::LimitsType       limits;
+
+        // Accumulated over all slices of the current 'go'
+        u64       nodes   = 0;
+        TimePoint spentMs = 0;
+
+        // Latest results, written by the engine's update listeners
+        int         lastDepth = 0, lastSelDepth = 0;
+        std::string lastScore, lastPv, bestmove, ponder;
+    };
+
+    void     scheduler_loop();
+    Session* find(int id);
+    Session* pick_next();
+    bool     finished(const Session& s) const;
+    void     start_scheduler();
+
+    Engine& engine;
+
+    std::mutex              mutex;
+    std::condition_variable cv;
+    std::thread             scheduler;
+    bool                    quit = false;
+
+    std::vector<std::unique_ptr<Session>> sessions;
+    Session*                              active = nullptr;
+    int                                   nextId = 1;
+    usize                                 cursor = 0;  // round-robin position
+};
+
+}  // namespace Stockfish
+
+#endif  // #ifndef SESSION_H_INCLUDED
@@ -20,6 +20,7 @@
 #define SHM_H_INCLUDED
 
 #include <algorithm>
+#include <cassert>
 #include <cinttypes>
 #include <cstddef>
 #include <cstdint>
@@ -208,7 +209,14 @@ class SharedMemoryBackend {
     SharedMemoryBackend(const std::string& shm_name, const T& value) :
         status(Status::NotInitialized) {
 
-        initialize(shm_name, value);
+        initialize(shm_name, &value);
+    }
+
+    // Value-initializes the stored object instead of copying an initial value
+    explicit SharedMemoryBackend(const std::string& shm_name) :
+        status(Status::NotInitialized) {
+
+        initialize(shm_name, nullptr);
     }
 
     bool is_valid() const { return status == Status::Success; }
@@ -277,7 +285,7 @@ class SharedMemoryBackend {
     }
 
    private:
-    void initialize(const std::string& shm_name, const T& value) {
+    void initialize(const std::string& shm_name, const T* value) {
         const usize total_size = sizeof(T) + sizeof(IS_INITIALIZED_VALUE);
 
         // Try allocating with large pages first.
@@ -356,7 +364,20 @@ class SharedMemoryBackend {
         if (*is_initialized != IS_INITIALIZED_VALUE)
         {
             // First time initialization, message for debug purposes
-            new (object) T{value};
+            if constexpr (std::is_copy_constructible_v<T>)
+            {
+                if (value != nullptr)
+                    new (object) T{*value};
+                else
+                    new (object) T{};
+            }
+            else
+            {
+                // Non-copyable objects (e.g. atomics) only support the
+                // value-initializing constructor.
+                assert(value == nullptr);
+                new (object) T{};
+            }
             *is_initialized = IS_INITIALIZED_VALUE;
         }
 
@@ -417,6 +438,10 @@ class SharedMemoryBackend {
     SharedMemoryBackend(const std::string& shm_name, const T& value) :
         shm1(shm::create_shared<T>(shm_name, value)) {}
 
+    // Value-initializes the stored object instead of copying an initial value
+    explicit SharedMemoryBackend(const std::string& shm_name) :
+        shm1(shm::create_shared_default<T>(shm_name)) {}
+
     void* get() const {
         const T* ptr = &shm1->get();
         return reinterpret_cast<void*>(const_cast<T*>(ptr));
@@ -459,6 +484,8 @@ class SharedMemoryBackend {
     SharedMemoryBackend([[maybe_unused]] const std::string& shm_name,
                         [[maybe_unused]] const T&           value) {}
 
+    explicit SharedMemoryBackend([[maybe_unused]] const std::string& shm_name) {}
+
     void* get() const { return nullptr; }
 
     bool is_valid() const { return false; }
@@ -479,6 +506,10 @@ struct SharedMemoryBackendFallback {
     SharedMemoryBackendFallback(const std::string&, const T& value) :
         fallback_object(make_unique_large_page<T>(value)) {}
 
+    // Value-initializing variant, for non-copyable contents
+    explicit SharedMemoryBackendFallback(const std::string&) :
+        fallback_object(make_unique_large_page<T>()) {}
+
     void* get() const { return fallback_object.get(); }
 
     SharedMemoryBackendFallback(const SharedMemoryBackendFallback&)            = delete;
@@ -629,6 +660,81 @@ struct SystemWideSharedConstant {
 };
 
 
+// A named, mutable region shared by cooperating engine processes on one host.
+// Unlike SystemWideSharedConstant, all attached processes concurrently update
+// the contents, so T must be built from lock-free atomics with relaxed, racy
+// updates (as in the TT). The region is value-initialized by whichever process
+// attaches first, and the name is qualified by the executable path so that
+// builds with different layouts never share a region. Falls back to a local
+// allocation when shared memory is unavailable.
+template<typename T>
+struct SystemWideSharedRegion {
+    static_assert(std::is_trivially_destructible_v<T>);
+
+    SystemWideSharedRegion() = default;
+
+    explicit SystemWideSharedRegion(const std::string& id) {
+        usize id_hash         = hash_string(id);
+        usize executable_hash = hash_string(getExecutablePathHash());
+
+        char buf[1024];
+        std::snprintf(buf, sizeof(buf), "Local\\sf_region_%zu$%zu", id_hash, executable_hash);
+        std::string shm_name = buf;
+
+#if defined(__linux__) && !defined(__ANDROID__)
+        // POSIX shared memory names must start with a slash
+        char hash_buf[32];
+        std::snprintf(hash_buf, sizeof(hash_buf), "%016" PRIx64, hash_string(shm_name));
+        shm_name = std::string("/sf_") + hash_buf;
+#endif
+
+        SharedMemoryBackend<T> shm_backend(shm_name);
+
+        if (shm_backend.is_valid())
+            backend = std::move(shm_backend);
+        else
+            backend = SharedMemoryBackendFallback<T>(shm_name);
+    }
+
+    SystemWideSharedRegion(const SystemWideSharedRegion&)            = delete;
+    SystemWideSharedRegion& operator=(const SystemWideSharedRegion&) = delete;
+
+    SystemWideSharedRegion(SystemWideSharedRegion&& other) noexcept :
+        backend(std::move(other.backend)) {}
+
+    SystemWideSharedRegion& operator=(SystemWideSharedRegion&& other) noexcept {
+        backend = std::move(other.backend);
+        return *this;
+    }
+
+    // nullptr when default-constructed or when allocation failed entirely
+    T* get() const {
+        return std::launder(reinterpret_cast<T*>(std::visit(
+          [](const auto& end) -> void* {
+              if constexpr (std::is_same_v<std::decay_t<decltype(end)>, std::monostate>)
+                  return nullptr;
+              else
+                  return end.get();
+          },
+          backend)));
+    }
+
+    SystemWideSharedConstantAllocationStatus get_status() const {
+        return std::visit(
+          [](const auto& end) -> SystemWideSharedConstantAllocationStatus {
+              if constexpr (std::is_same_v<std::decay_t<decltype(end)>, std::monostate>)
+                  return SystemWideSharedConstantAllocationStatus::NoAllocation;
+              else
+                  return end.get_status();
+          },
+          backend);
+    }
+
+   private:
+    std::variant<std::monostate, SharedMemoryBackend<T>, SharedMemoryBackendFallback<T>> backend;
+};
+
+
 }  // namespace Stockfish
 
 #endif  // #ifndef SHM_H_INCLUDED
@@ -145,7 +145,11 @@ inline std::once_flag CleanupHooks::register_once_;
 
 template<typename T>
 class SharedMemory: public detail::SharedMemoryBase {
-    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+    // The region may outlive any single attached process, so no destructor can
+    // ever run for the stored object. This also admits objects built from
+    // lock-free atomics (which are not trivially copyable); such objects must
+    // use the value-initializing open_default() path.
+    static_assert(std::is_trivially_destructible_v<T>, "T must be trivially destructible");
     static_assert(!std::is_pointer_v<T>, "T cannot be a pointer type");
 
    private:
@@ -223,6 +227,25 @@ class SharedMemory: public detail::SharedMemoryBase {
     }
 
     [[nodiscard]] bool open(const T& initial_value) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+        if (!open_impl([&](T* ptr) { new (ptr) T{initial_value}; }))
+            return false;
+
+        protect_payload_read_only();
+        return true;
+    }
+
+    // As open(), but value-initializes the region instead of copying an initial
+    // value. Intended for large mutable regions (e.g. shared history tables)
+    // where materializing a process-local copy first would be wasteful, and for
+    // types containing atomics, which are not trivially copyable.
+    [[nodiscard]] bool open_default() noexcept {
+        return open_impl([](T* ptr) { new (ptr) T{}; });
+    }
+
+   private:
+    template<typename Init>
+    [[nodiscard]] bool open_impl(Init&& init_value) noexcept {
         detail::CleanupHooks::ensure_registered();
 
         bool retried_stale = false;
@@ -252,8 +275,8 @@ class SharedMemory: public detail::SharedMemoryBase {
             }
 
             bool invalid_header = false;
-            bool success =
-              created_new ? setup_new_region(initial_value) : setup_existing_region(invalid_header);
+            bool success        = created_new ? setup_new_region(init_value)
+                                              : setup_existing_region(invalid_header);
 
             if (!success)
             {
@@ -312,6 +335,7 @@ class SharedMemory: public detail::SharedMemoryBase {
         }
     }
 
+   public:
     void close(bool skip_unmap = false) noexcept override {
         if (fd_ == -1 && mapped_ptr_ == nullptr)
             return;
@@ -389,6 +413,54 @@ class SharedMemory: public detail::SharedMemoryBase {
         sentinel_path_.clear();
     }
 
+    // Map the shared file at a 2 MiB aligned address. The kernel only backs a
+    // shmem mapping with huge folios (after the MADV_HUGEPAGE below) when the
+    // mapping itself is aligned to the huge page size, so reserve an oversized
+    // region, place the file mapping at the aligned offset inside it and trim
+    // the slack. If the reservation fails, fall back to a plain mmap and the
+    // madvise stays a best-effort hint as before.
+    [[nodiscard]] static void* map_shared_region(usize size, int fd) noexcept {
+        constexpr usize alignment = 2 * 1024 * 1024;
+
+        if (size >= alignment)
+        {
+            void* reservation = mmap(nullptr, size + alignment, PROT_NONE,
+                                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (reservation != MAP_FAILED)
+            {
+                char*       raw  = static_cast<char*>(reservation);
+                const usize head = (alignment - reinterpret_cast<usize>(raw) % alignment)
+                                 % alignment;
+
+                void* mapped =
+                  mmap(raw + head, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+                if (mapped != MAP_FAILED)
+                {
+                    if (head)
+                        munmap(raw, head);
+                    munmap(raw + head + size, alignment - head);
+                    return mapped;
+                }
+                munmap(reservation, size + alignment);
+            }
+        }
+
+        return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+
+    // Drops write access to the payload pages once the region holds constant,
+    // fully initialized data, so that a stray write in any attached process
+    // faults instead of silently corrupting the contents for every process on
+    // the host. The header (mutex, refcount) follows the payload and may share
+    // its last page, so only whole payload pages are protected. Best effort:
+    // a failed mprotect just leaves the mapping writable, as before.
+    void protect_payload_read_only() noexcept {
+        const usize pageSize = static_cast<usize>(sysconf(_SC_PAGESIZE));
+        const usize length   = sizeof(T) & ~(pageSize - 1);
+        if (length)
+            mprotect(mapped_ptr_, length, PROT_READ);
+    }
+
     void unmap_region() noexcept {
         if (mapped_ptr_)
         {
@@ -578,11 +650,12 @@ class SharedMemory: public detail::SharedMemoryBase {
         return found;
     }
 
-    [[nodiscard]] bool setup_new_region(const T& initial_value) noexcept {
+    template<typename Init>
+    [[nodiscard]] bool setup_new_region(Init&& init_value) noexcept {
         if (ftruncate(fd_, static_cast<off_t>(total_size_)) == -1)
             return false;
 
-        mapped_ptr_ = mmap(nullptr, total_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        mapped_ptr_ = map_shared_region(total_size_, fd_);
         if (mapped_ptr_ == MAP_FAILED)
         {
             mapped_ptr_ = nullptr;
@@ -616,7 +689,7 @@ class SharedMemory: public detail::SharedMemoryBase {
           reinterpret_cast<detail::ShmHeader*>(static_cast<char*>(mapped_ptr_) + sizeof(T));
 
         new (header_ptr_) detail::ShmHeader{};
-        new (data_ptr_) T{initial_value};
+        init_value(data_ptr_);
 
         if (!initialize_shared_mutex())
             return false;
@@ -637,7 +710,7 @@ class SharedMemory: public detail::SharedMemoryBase {
             return false;
         }
 
-        mapped_ptr_ = mmap(nullptr, total_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        mapped_ptr_ = map_shared_region(total_size_, fd_);
         if (mapped_ptr_ == MAP_FAILED)
         {
             mapped_ptr_ = nullptr;
@@ -673,6 +746,14 @@ template<typename T>
     return std::nullopt;
 }
 
+template<typename T>
+[[nodiscard]] std::optional<SharedMemory<T>> create_shared_default(const std::string& name) noexcept {
+    SharedMemory<T> shm(name);
+    if (shm.open_default())
+        return shm;
+    return std::nullopt;
+}
+
 }  // namespace Stockfish::shm
 
 #endif  // #ifndef SHM_LINUX_H_INCLUDED
@@ -0,0 +1,163 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "spsa.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+#include "misc.h"
+#include "tune.h"
+#include "ucioption.h"
+
+namespace Stockfish::Spsa {
+
+Config parse(std::istream& args) {
+
+    // Both parsers ignore tokens they do not know, so the same argument
+    // string can carry the SPSA schedule and the selfplay game limits.
+    std::string        line;
+    std::getline(args, line);
+
+    std::istringstream own(line);
+    std::string        token;
+
+    Config config;
+
+    while (own >> token)
+    {
+        const auto  pos   = token.find('=');
+        std::string name  = token.substr(0, pos);
+        std::string value = pos == std::string::npos ? "" : token.substr(pos + 1);
+
+        if (name == "iterations")
+            config.iterations = std::stoi(value);
+        else if (name == "pairs")
+            config.pairs = std::stoi(value);
+        else if (name == "rate")
+            config.rate = std::stod(value);
+    }
+
+    std::istringstream match(line);
+    config.match = Selfplay::parse(match);
+
+    return config;
+}
+
+
+void run(Engine& first, Engine& second, const Config& config) {
+
+    const std::vector<Tune::Parameter> params = Tune::parameters();
+
+    if (params.empty())
+    {
+        sync_cout << "info string No TUNE() parameters registered, nothing to tune" << sync_endl;
+        return;
+    }
+
+    const usize n = params.size();
+
+    // Continuous parameter estimates and per-parameter end perturbations,
+    // the latter matching the c_end = (max - min) / 20 that make_option()
+    // prints for fishtest.
+    std::vector<double> theta(n), cend(n);
+    for (usize i = 0; i < n; ++i)
+    {
+        theta[i] = *params[i].value;
+        cend[i]  = std::max(0.5, (params[i].range.second - params[i].range.first) / 20.0);
+    }
+
+    const std::vector<std::string> fens = Selfplay::openings(config.match);
+    PRNG                           rng{u64(now())};
+
+    std::vector<int> flip(n), plus(n), minus(n);
+
+    // The TUNE() variables are process globals shared by both engines, and
+    // games run one move at a time, so swapping the right parameter set in
+    // just before each engine thinks is exact, not an approximation.
+    Selfplay::Config match = config.match;
+    match.onThink          = [&](Engine& e) {
+        const std::vector<int>& v = &e == &first ? plus : minus;
+        for (usize i = 0; i < n; ++i)
+            *params[i].value = v[i];
+        Tune::run_post_updates();
+    };
+
+    sync_cout << "spsa tuning " << n << " parameters, " << config.iterations << " iterations of "
+              << config.pairs << " game pair(s)" << sync_endl;
+
+    usize opening = 0;
+
+    for (int k = 1; k <= config.iterations; ++k)
+    {
+        for (usize i = 0; i < n; ++i)
+        {
+            // c_k decays towards c_end over the session; the step size
+            // a_k = rate * c_k^2 decays with it, as in the fishtest SPSA.
+            const double ck = cend[i] * std::pow(double(config.iterations) / k, 0.101);
+
+            flip[i]  = rng.rand<u64>() & 1 ? 1 : -1;
+            plus[i]  = std::clamp(int(std::round(theta[i] + ck * flip[i])),
+                                  params[i].range.first, params[i].range.second);
+            minus[i] = std::clamp(int(std::round(theta[i] - ck * flip[i])),
+                                  params[i].range.first, params[i].range.second);
+        }
+
+        // Mean result per pair from the '+' side's point of view, in [-1, 1]
+        double result = 0.0;
+        for (int p = 0; p < config.pairs; ++p)
+            result += play_pair(first, second, fens[opening++ % fens.size()], match) - 1.0;
+        result /= config.pairs;
+
+        std::ostringstream values;
+        for (usize i = 0; i < n; ++i)
+        {
+            const double ck = cend[i] * std::pow(double(config.iterations) / k, 0.101);
+
+            theta[i] = std::clamp(theta[i] + config.rate * ck * result * flip[i],
+                                  double(params[i].range.first), double(params[i].range.second));
+            values << " " << params[i].name << "=" << theta[i];
+        }
+
+        sync_cout << "spsa iter=" << k << " result=" << result << values.str() << sync_endl;
+    }
+
+    // Publish the tuned values through the first engine's UCI options, which
+    // also writes them back into the globals via the usual on_tune path.
+    for (usize i = 0; i < n; ++i)
+    {
+        const int v = int(std::round(theta[i]));
+
+        if (first.get_options().count(params[i].name))
+        {
+            std::istringstream ss("name " + params[i].name + " value " + std::to_string(v));
+            first.get_options().setoption(ss);
+        }
+        else
+            *params[i].value = v;
+
+        sync_cout << "spsa-result " << params[i].name << "=" << v << sync_endl;
+    }
+    Tune::run_post_updates();
+}
+
+}  // namespace Stockfish::Spsa
@@ -0,0 +1,63 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPSA_H_INCLUDED
+#define SPSA_H_INCLUDED
+
+#include <iosfwd>
+
+#include "selfplay.h"
+
+namespace Stockfish {
+
+class Engine;
+
+namespace Spsa {
+
+// Tuning session configuration parsed from the 'spsa' command:
+//
+//   spsa [iterations=20] [pairs=1] [rate=0.002] + any selfplay game limits
+//        (depth=, movetime=, tc=, maxplies=, fenfile=)
+//
+// Each iteration perturbs every registered TUNE() parameter by +-c_k along
+// a random Rademacher direction, plays 'pairs' color-swapped game pairs
+// between the perturbed parameter sets and moves the estimate along the
+// measured gradient. rate is the fishtest R_end learning rate; per-parameter
+// c_end is (max - min) / 20, the same constants make_option() prints.
+struct Config {
+    int              iterations = 20;
+    int              pairs      = 1;
+    double           rate       = 0.002;
+    Selfplay::Config match;
+};
+
+Config parse(std::istream& args);
+
+// Runs the tuning session between the two engines. The TUNE() variables are
+// process globals shared by both engines, so the perturbed sets are swapped
+// in per move via Selfplay::Config::onThink; games within a pair therefore
+// run sequentially. On return the tuned values are written back to the
+// globals and to the first engine's UCI options. Blocking; both engines
+// must be idle and the caller owns their listener configuration.
+void run(Engine& first, Engine& second, const Config& config);
+
+}  // namespace Spsa
+
+}  // namespace Stockfish
+
+#endif  // #ifndef SPSA_H_INCLUDED
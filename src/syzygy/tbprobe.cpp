@@ -21,33 +21,43 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <deque>
 #include <fstream>
 #include <initializer_list>
+#include <list>
 #include <iostream>
 #include <mutex>
 #include <optional>
 #include <sstream>
 #include <string_view>
 #include <sys/stat.h>
+#include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <array>
 
 #include "../attacks.h"
 #include "../bitboard.h"
+#include "../memory.h"
 #include "../misc.h"
 #include "../movegen.h"
+#include "../numa.h"
 #include "../position.h"
+#include "../profile.h"
 #include "../search.h"
+#include "../thread.h"
 #include "../types.h"
 #include "../ucioption.h"
 
 #ifndef _WIN32
+    #include <dirent.h>
     #include <fcntl.h>
     #include <sys/mman.h>
     #include <unistd.h>
@@ -66,13 +76,21 @@ namespace Stockfish::Tablebases {
 
 int MaxCardinality;
 
-void init(const std::string&) {}
+void init(const std::string&, ThreadPool*) {}
 
-WDLScore probe_wdl(Position&, ProbeState* result) {
+void set_pin_limit(int) {}
+
+void set_block_cache_size(usize) {}
+
+void set_bitbases(const std::string&) {}
+
+WDLScore probe_wdl(Position&, ProbeState* result, WDLCache*) {
     *result = FAIL;
     return WDLDraw;
 }
 
+void prefetch_wdl(const Position&) {}
+
 int probe_dtz(Position&, ProbeState* result) {
     *result = FAIL;
     return 0;
@@ -352,6 +370,95 @@ class TBFile: public std::ifstream {
 
 std::string TBFile::Paths;
 
+// Index of the file names present in the Paths directories, rebuilt once per
+// init() with a single directory listing per path. The material enumeration in
+// init() asks about a few thousand candidate tables, and probing each one with
+// open() costs a filesystem round trip apiece - painful when the tables sit on
+// a network share - whereas listing a directory streams all its names at once.
+// If some directory cannot be listed, the index marks itself incomplete and
+// lookups fall back to a per-file open.
+class TBFileIndex {
+
+    std::unordered_set<std::string> names;
+    bool                            complete = false;
+
+    // Lists a single directory into 'out', returning false on failure
+    static bool list_dir(const std::string& dir, std::unordered_set<std::string>& out) {
+
+    #ifndef _WIN32
+        DIR* d = opendir(dir.c_str());
+        if (!d)
+            return false;
+        while (struct dirent* e = readdir(d))
+            out.insert(e->d_name);
+        closedir(d);
+    #else
+        WIN32_FIND_DATAA fd;
+        HANDLE           h = FindFirstFileA((dir + "\\*").c_str(), &fd);
+        if (h == INVALID_HANDLE_VALUE)
+            return false;
+        do
+            out.insert(fd.cFileName);
+        while (FindNextFileA(h, &fd));
+        FindClose(h);
+    #endif
+        return true;
+    }
+
+   public:
+    // Rebuilds the index from the directories in TBFile::Paths. The
+    // directories are independent, so given a thread pool each one is listed
+    // on its own thread and the round trips to distinct mounts overlap.
+    void scan(ThreadPool* threads) {
+
+    #ifndef _WIN32
+        constexpr char SepChar = ':';
+    #else
+        constexpr char SepChar = ';';
+    #endif
+        names.clear();
+        complete = true;
+
+        std::vector<std::string> dirs;
+        std::stringstream        ss(TBFile::Paths);
+        std::string              path;
+
+        while (std::getline(ss, path, SepChar))
+            dirs.push_back(path);
+
+        std::vector<std::unordered_set<std::string>> perDir(dirs.size());
+        std::vector<char>                            listed(dirs.size(), false);
+
+        if (threads && threads->num_threads() > 1 && dirs.size() > 1)
+        {
+            const usize threadCount = threads->num_threads();
+
+            for (usize i = 0; i < dirs.size(); ++i)
+                threads->run_on_thread(i % threadCount, [&dirs, &perDir, &listed, i]() {
+                    listed[i] = list_dir(dirs[i], perDir[i]);
+                });
+
+            for (usize i = 0; i < std::min(dirs.size(), threadCount); ++i)
+                threads->wait_on_thread(i);
+        }
+        else
+            for (usize i = 0; i < dirs.size(); ++i)
+                listed[i] = list_dir(dirs[i], perDir[i]);
+
+        for (usize i = 0; i < dirs.size(); ++i)
+        {
+            complete = complete && listed[i];
+            names.insert(perDir[i].begin(), perDir[i].end());
+        }
+    }
+
+    bool contains(const std::string& f) const {
+        return names.count(f) || (!complete && TBFile(f).is_open());
+    }
+};
+
+TBFileIndex TBFileIndex;
+
 // struct PairsData contains low-level indexing information to access TB data.
 // There are 8, 4, or 2 PairsData records for each TBTable, according to the type
 // of table and if positions have pawns or not. It is populated at first access.
@@ -389,6 +496,7 @@ struct TBTable {
     static constexpr int Sides = Type == WDL ? 2 : 1;
 
     std::atomic_bool ready;
+    std::atomic_bool prefetched;  // Set once the table has been handed to the prefetcher
     void*            baseAddress;
     u8*              map;
     u64              mapping;
@@ -404,6 +512,7 @@ struct TBTable {
 
     TBTable() :
         ready(false),
+        prefetched(false),
         baseAddress(nullptr) {}
     explicit TBTable(const std::string& code);
     explicit TBTable(const TBTable<WDL>& wdl);
@@ -566,19 +675,12 @@ void TBTables::add(const std::vector<PieceType>& pieces) {
         code += PieceToChar[pt];
     code.insert(code.find('K', 1), "v");
 
-    TBFile file_dtz(code + ".rtbz");  // KRK -> KRvK
-    if (file_dtz.is_open())
-    {
-        file_dtz.close();
+    if (TBFileIndex.contains(code + ".rtbz"))  // KRK -> KRvK
         foundDTZFiles++;
-    }
-
-    TBFile file(code + ".rtbw");  // KRK -> KRvK
 
-    if (!file.is_open())  // Only WDL file is checked
+    if (!TBFileIndex.contains(code + ".rtbw"))  // Only WDL file is checked
         return;
 
-    file.close();
     foundWDLFiles++;
 
     MaxCardinality = std::max(int(pieces.size()), MaxCardinality);
@@ -591,6 +693,180 @@ void TBTables::add(const std::vector<PieceType>& pieces) {
     insert(wdlTable.back().key2, &wdlTable.back(), &dtzTable.back());
 }
 
+// Tables with at most this many pieces are locked into RAM when mapped, so
+// co-tenant memory pressure cannot evict their pages and stall a probe on a
+// major page fault mid-search. 0 disables pinning.
+std::atomic<int> PinLimit{0};
+
+// Best effort: failure (e.g. an exhausted RLIMIT_MEMLOCK) is not fatal, the
+// table simply stays under normal page-cache policy.
+void pin_mapping(void* baseAddress, [[maybe_unused]] u64 mapping) {
+
+#ifndef _WIN32
+    mlock(baseAddress, mapping);
+#else
+    // On Windows 'mapping' is the file-mapping handle, so query the view size
+    MEMORY_BASIC_INFORMATION mbi;
+    if (VirtualQuery(baseAddress, &mbi, sizeof(mbi)))
+        VirtualLock(baseAddress, mbi.RegionSize);
+#endif
+}
+
+// Appends all the values a Huffman symbol expands to, walking the btree
+// pairs iteratively. The expansion order matches the offset order used by
+// decompress_pairs(): child symbols are adjacent, left side first.
+void expand_symbol(const PairsData* d, Sym sym, std::vector<u16>& out) {
+
+    Sym stack[256];
+    int sp      = 0;
+    stack[sp++] = sym;
+
+    while (sp)
+    {
+        Sym s = stack[--sp];
+
+        if (!d->symlen[s])
+        {
+            out.push_back(d->btree[s].get<LR::Left>());
+            continue;
+        }
+
+        assert(sp + 2 <= 256);
+        stack[sp++] = d->btree[s].get<LR::Right>();  // Popped after the left side
+        stack[sp++] = d->btree[s].get<LR::Left>();
+    }
+}
+
+// LRU cache of fully decoded data blocks, keyed by (PairsData, block index).
+// Probes of a hot endgame class keep landing in the same handful of blocks;
+// serving them from decoded memory skips both the page fault on the mmapped
+// data and the Huffman walk. Sized by the SyzygyBlockCacheSize option and
+// disabled (the default) at zero cost for the normal probe path.
+class BlockLRUCache {
+
+    struct BlockKey {
+        const PairsData* d;
+        u32              block;
+
+        bool operator==(const BlockKey& o) const { return d == o.d && block == o.block; }
+    };
+
+    struct BlockKeyHash {
+        usize operator()(const BlockKey& k) const {
+            usize h = usize(uintptr_t(k.d));
+            hash_combine(h, k.block);
+            return h;
+        }
+    };
+
+    using LRUList = std::list<std::pair<BlockKey, std::vector<u16>>>;
+
+   public:
+    // Looks up the value at 'offset' of the given block, decoding and caching
+    // the whole block on a miss. Returns false when the cache is disabled.
+    bool probe(const PairsData* d, u32 block, int offset, int& value) {
+
+        if (!maxBytes.load(std::memory_order_relaxed))
+            return false;
+
+        std::lock_guard<std::mutex> lk(mutex);
+
+        BlockKey key{d, block};
+        auto     it = index.find(key);
+
+        if (it == index.end())
+        {
+            lru.emplace_front(key, decode_block(d, block));
+            index[key] = lru.begin();
+            usedBytes += entry_bytes(lru.front().second);
+            evict();
+            it = index.find(key);
+        }
+        else
+            lru.splice(lru.begin(), lru, it->second);
+
+        const auto& values = it->second->second;
+        value              = offset < int(values.size()) ? values[offset] : 0;
+        return offset < int(values.size());
+    }
+
+    void resize(usize mb) {
+        std::lock_guard<std::mutex> lk(mutex);
+        maxBytes.store(mb << 20, std::memory_order_relaxed);
+        evict();
+    }
+
+    // Called on init(), before the tables (and so the keyed PairsData) die
+    void clear() {
+        std::lock_guard<std::mutex> lk(mutex);
+        lru.clear();
+        index.clear();
+        usedBytes = 0;
+    }
+
+   private:
+    // Decodes every value of a block, mirroring the symbol walk in
+    // decompress_pairs(). Blocks hold whole symbols, so the expansion ends
+    // exactly at blockLength[block] + 1 values.
+    static std::vector<u16> decode_block(const PairsData* d, u32 block) {
+
+        const int        count = d->blockLength[block] + 1;
+        std::vector<u16> out;
+        out.reserve(count);
+
+        u32* ptr       = (u32*) (d->data + (u64(block) * d->sizeofBlock));
+        u64  buf64     = number<u64, BigEndian>(ptr);
+        int  buf64Size = 64;
+        ptr += 2;
+
+        while (int(out.size()) < count)
+        {
+            int len = 0;
+
+            while (buf64 < d->base64[len])
+                ++len;
+
+            Sym sym = Sym((buf64 - d->base64[len]) >> (64 - len - d->minSymLen));
+            sym += number<Sym, LittleEndian>(&d->lowestSym[len]);
+
+            expand_symbol(d, sym, out);
+
+            len += d->minSymLen;
+            buf64 <<= len;
+            buf64Size -= len;
+
+            if (buf64Size <= 32)
+            {  // Refill the buffer
+                buf64Size += 32;
+                buf64 |= u64(number<u32, BigEndian>(ptr++)) << (64 - buf64Size);
+            }
+        }
+
+        return out;
+    }
+
+    static usize entry_bytes(const std::vector<u16>& values) {
+        return values.size() * sizeof(u16) + sizeof(LRUList::value_type);
+    }
+
+    void evict() {
+        while (usedBytes > maxBytes.load(std::memory_order_relaxed) && lru.size() > 1)
+        {
+            usedBytes -= entry_bytes(lru.back().second);
+            index.erase(lru.back().first);
+            lru.pop_back();
+        }
+    }
+
+    std::mutex                                            mutex;
+    LRUList                                               lru;
+    std::unordered_map<BlockKey, LRUList::iterator, BlockKeyHash> index;
+    usize                                                 usedBytes = 0;
+    std::atomic<usize>                                    maxBytes{0};
+};
+
+BlockLRUCache BlockCache;
+
 // TB tables are compressed with canonical Huffman code. The compressed data is divided into
 // blocks of size d->sizeofBlock, and each block stores a variable number of symbols.
 // Each symbol represents either a WDL or a (remapped) DTZ value, or a pair of other symbols
@@ -651,6 +927,12 @@ int decompress_pairs(PairsData* d, u64 idx) {
     while (offset > d->blockLength[block])
         offset -= d->blockLength[block++] + 1;
 
+    // Serve the value from the decoded-block cache when it is enabled; a miss
+    // decodes and caches the whole block, so later probes of the same block
+    // are plain array reads.
+    if (int value = 0; BlockCache.probe(d, block, offset, value))
+        return value;
+
     // Finally, we find the start address of our block of canonical Huffman symbols
     u32* ptr = (u32*) (d->data + (u64(block) * d->sizeofBlock));
 
@@ -1267,16 +1549,28 @@ void set(T& e, u8* data) {
         }
 }
 
-// If the TB file corresponding to the given position is already memory-mapped
-// then return its base address, otherwise, try to memory map and init it. Called
-// at every probe, memory map, and init only at first access. Function is thread
-// safe and can be called concurrently.
+// Builds the table file name, like "KPPvKR.rtbw", for the position's material
 template<TBType Type>
-void* mapped(TBTable<Type>& e, const Position& pos) {
+std::string table_fname(const TBTable<Type>& e, const Position& pos) {
+
+    // Pieces strings in decreasing order for each color, like ("KPP","KR")
+    std::string w, b;
+    for (PieceType pt = KING; pt >= PAWN; --pt)
+    {
+        w += std::string(popcount(pos.pieces(WHITE, pt)), PieceToChar[pt]);
+        b += std::string(popcount(pos.pieces(BLACK, pt)), PieceToChar[pt]);
+    }
+
+    return (e.key == pos.material_key() ? w + 'v' + b : b + 'v' + w)
+         + (Type == WDL ? ".rtbw" : ".rtbz");
+}
+
+// Memory maps the given file and populates the table's indexing data. Thread
+// safe and can be called concurrently, e.g. by a probe and the prefetcher.
+template<TBType Type>
+void* map_table(TBTable<Type>& e, const std::string& fname) {
 
     static std::mutex mutex;
-    // Because TB is the only usage of materialKey, check it here in debug mode
-    assert(pos.material_key_is_ok());
 
     // Use 'acquire' to avoid a thread reading 'ready' == true while
     // another is still working. (compiler reordering may cause this).
@@ -1288,26 +1582,127 @@ void* mapped(TBTable<Type>& e, const Position& pos) {
     if (e.ready.load(std::memory_order_relaxed))  // Recheck under lock
         return e.baseAddress;
 
-    // Pieces strings in decreasing order for each color, like ("KPP","KR")
-    std::string fname, w, b;
-    for (PieceType pt = KING; pt >= PAWN; --pt)
-    {
-        w += std::string(popcount(pos.pieces(WHITE, pt)), PieceToChar[pt]);
-        b += std::string(popcount(pos.pieces(BLACK, pt)), PieceToChar[pt]);
-    }
-
-    fname =
-      (e.key == pos.material_key() ? w + 'v' + b : b + 'v' + w) + (Type == WDL ? ".rtbw" : ".rtbz");
-
     u8* data = TBFile(fname).map(&e.baseAddress, &e.mapping, Type);
 
     if (data)
+    {
         set(e, data);
 
+        if (e.pieceCount <= PinLimit.load(std::memory_order_relaxed))
+            pin_mapping(e.baseAddress, e.mapping);
+    }
+
     e.ready.store(true, std::memory_order_release);
     return e.baseAddress;
 }
 
+// If the TB file corresponding to the given position is already memory-mapped
+// then return its base address, otherwise, try to memory map and init it. Called
+// at every probe, memory map, and init only at first access. Function is thread
+// safe and can be called concurrently.
+template<TBType Type>
+void* mapped(TBTable<Type>& e, const Position& pos) {
+
+    // Because TB is the only usage of materialKey, check it here in debug mode
+    assert(pos.material_key_is_ok());
+
+    if (e.ready.load(std::memory_order_acquire))
+        return e.baseAddress;
+
+    return map_table(e, table_fname(e, pos));
+}
+
+// Background thread that memory maps tablebase files and touches their indexing
+// pages ahead of the first synchronous probe. On slow storage (e.g. an NFS-hosted
+// 7-man set) a cold probe can stall a search thread for milliseconds, so search
+// threads hand over a table as soon as they enter its material window instead.
+// Each table is prefetched at most once per init().
+class TBPrefetcher {
+
+   public:
+    ~TBPrefetcher() { stop(); }
+
+    void enqueue(TBTable<WDL>* entry, std::string fname) {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            if (stopRequested)
+                return;
+            queue.emplace_back(entry, std::move(fname));
+            if (!worker.joinable())
+                worker = std::thread([this] { loop(); });
+        }
+        cv.notify_one();
+    }
+
+    // Stops the worker and drops pending requests. Called before the tables are
+    // destroyed or re-initialized, so no stale table pointers survive.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lk(mutex);
+            stopRequested = true;
+            queue.clear();
+        }
+        cv.notify_one();
+        if (worker.joinable())
+            worker.join();
+        worker        = std::thread();
+        stopRequested = false;
+    }
+
+   private:
+    void loop() {
+        std::unique_lock<std::mutex> lk(mutex);
+        while (true)
+        {
+            cv.wait(lk, [this] { return stopRequested || !queue.empty(); });
+            if (stopRequested)
+                return;
+
+            auto [entry, fname] = std::move(queue.front());
+            queue.pop_front();
+
+            lk.unlock();
+            touch(*entry, fname);
+            lk.lock();
+        }
+    }
+
+    // Maps the file and reads one byte per page of the indexing structures,
+    // which every later probe dereferences before reaching the data blocks
+    static void touch(TBTable<WDL>& e, const std::string& fname) {
+
+        if (!map_table(e, fname) || !e.get(0, 0)->data)
+            return;
+
+        constexpr usize PageSize = 4096;
+
+        for (int i = 0; i < TBTable<WDL>::Sides; ++i)
+            for (File f = FILE_A; f <= (e.hasPawns ? FILE_D : FILE_A); ++f)
+            {
+                const PairsData* d = e.get(i, f);
+                touch_range((const u8*) d->sparseIndex,
+                            d->sparseIndexSize * sizeof(SparseEntry), PageSize);
+                touch_range((const u8*) d->blockLength, d->blockLengthSize * sizeof(u16),
+                            PageSize);
+            }
+    }
+
+    static void touch_range(const u8* base, usize size, usize step) {
+        volatile u8 sink = 0;
+        for (usize i = 0; i < size; i += step)
+            sink = base[i];
+        (void) sink;
+    }
+
+    std::mutex                                        mutex;
+    std::condition_variable                           cv;
+    std::deque<std::pair<TBTable<WDL>*, std::string>> queue;
+    std::thread                                       worker;
+    bool                                              stopRequested = false;
+};
+
+TBPrefetcher Prefetcher;
+
 template<TBType Type, typename Ret = typename TBTable<Type>::Ret>
 Ret probe_table(const Position& pos, ProbeState* result, WDLScore wdl = WDLDraw) {
 
@@ -1335,9 +1730,20 @@ Ret probe_table(const Position& pos, ProbeState* result, WDLScore wdl = WDLDraw)
 // (winning capture or winning pawn move). Also, DTZ store wrong values for positions
 // where the best move is an ep-move (even if losing). So in all these cases set
 // the state to ZEROING_BEST_MOVE.
+// In-RAM expanded bitbase tier, defined after search() below
+std::atomic<bool> BitbasesEnabled{false};
+bool              probe_expanded(const Position& pos, WDLScore& wdl);
+
 template<bool CheckZeroingMoves>
 WDLScore search(Position& pos, ProbeState* result) {
 
+    // The expanded tier stores fully resolved WDL values, so it answers for
+    // the whole subtree of this search. The DTZ path cannot take the shortcut
+    // because it must discover ZEROING_BEST_MOVE states itself.
+    if (!CheckZeroingMoves && BitbasesEnabled.load(std::memory_order_relaxed))
+        if (WDLScore wdl; probe_expanded(pos, wdl))
+            return *result = OK, wdl;
+
     WDLScore  value, bestValue = WDLLoss;
     StateInfo st;
 
@@ -1395,14 +1801,261 @@ WDLScore search(Position& pos, ProbeState* result) {
     return *result = OK, value;
 }
 
+
+// In-RAM expanded bitbase tier. For selected few-piece endgames the fully
+// expanded WDL sets are small enough to keep uncompressed in RAM: positions
+// are indexed directly by side to move and raw piece squares, 2 bits each,
+// so a probe is pure index arithmetic plus one cache line touch, with no
+// decompression or block cache traffic. Slot values: 0/1/2 = loss/draw/win,
+// 3 = "ask the regular path" (cursed and blessed scores do not fit 2 bits,
+// and unreachable placements are never asked). The dense encoding spends
+// 64^n slots per side to move, which is why the tier stops at 4 pieces:
+// 8.4 MiB per 4-man table, half a GiB for a single 5-man one.
+
+struct ExpandedBitbase {
+    std::vector<Piece> order;  // indexing order: the code's white pieces, then black
+    LargePagePtr<u8[]> data;
+};
+
+std::vector<std::unique_ptr<ExpandedBitbase>> BitbaseStore;
+
+// Material key -> (bitbase, probe with colors swapped and ranks flipped)
+std::unordered_map<Key, std::pair<const ExpandedBitbase*, bool>> BitbaseMap;
+
+// Fast path of search<false>(); returns false when the position is not
+// covered and the regular probe must run.
+bool probe_expanded(const Position& pos, WDLScore& wdl) {
+
+    // The dense index has no en passant dimension
+    if (pos.ep_square() != SQ_NONE)
+        return false;
+
+    auto it = BitbaseMap.find(pos.material_key());
+    if (it == BitbaseMap.end())
+        return false;
+
+    const ExpandedBitbase& bb   = *it->second.first;
+    const bool             flip = it->second.second;
+
+    usize idx = usize(int(pos.side_to_move()) ^ int(flip));
+    usize mul = 2;
+
+    for (usize i = 0; i < bb.order.size();)
+    {
+        const Piece pc = flip ? make_piece(~color_of(bb.order[i]), type_of(bb.order[i]))
+                              : bb.order[i];
+
+        usize group = 1;
+        while (i + group < bb.order.size() && bb.order[i + group] == bb.order[i])
+            ++group;
+
+        Bitboard b = pos.pieces(color_of(pc), type_of(pc));
+        if (usize(popcount(b)) != group)  // foils material key collisions
+            return false;
+
+        while (b)
+        {
+            Square s = pop_lsb(b);
+            idx += usize(flip ? flip_rank(s) : s) * mul;
+            mul *= 64;
+        }
+        i += group;
+    }
+
+    const u8 slot = (bb.data[idx >> 2] >> 2 * (idx & 3)) & 3;
+    if (slot == 3)
+        return false;
+
+    wdl = WDLScore(int(slot) * 2 - 2);
+    return true;
+}
+
+// Resolves one dense index through the regular probing machinery. Returns 3
+// for placements that cannot occur in a legal probe.
+u8 fill_slot(const std::vector<Piece>& order, usize idx, std::atomic<bool>& ok) {
+
+    const Color stm = Color(idx & 1);
+    usize       sqs = idx >> 1;
+
+    char board[SQUARE_NB] = {};
+
+    for (const Piece pc : order)
+    {
+        const Square s = Square(sqs & 63);
+        sqs >>= 6;
+
+        if (board[s] || (type_of(pc) == PAWN && (rank_of(s) == RANK_1 || rank_of(s) == RANK_8)))
+            return 3;
+        board[s] = PieceToChar[pc];
+    }
+
+    std::string fen;
+    for (Rank r = RANK_8;; --r)
+    {
+        int empty = 0;
+        for (File f = FILE_A; f <= FILE_H; ++f)
+        {
+            const char c = board[make_square(f, r)];
+            if (!c)
+                ++empty;
+            else
+            {
+                if (empty)
+                    fen += char('0' + empty);
+                empty = 0;
+                fen += c;
+            }
+        }
+        if (empty)
+            fen += char('0' + empty);
+
+        if (r == RANK_1)
+            break;
+        fen += '/';
+    }
+    fen += stm == WHITE ? " w - - 0 1" : " b - - 0 1";
+
+    Position  pos;
+    StateInfo st;
+    if (pos.set(fen, false, &st))
+        return 3;
+
+    // The side not to move may not stand in check
+    if (pos.attackers_to(pos.square<KING>(~stm)) & pos.pieces(stm))
+        return 3;
+
+    ProbeState res = OK;
+    WDLScore   wdl = search<false>(pos, &res);
+
+    if (res == FAIL)
+    {
+        ok = false;
+        return 3;
+    }
+
+    return wdl == WDLLoss ? 0 : wdl == WDLDraw ? 1 : wdl == WDLWin ? 2 : 3;
+}
+
+// Expands one material code (e.g. "KQvK") into a flat array by resolving
+// every slot through the regular machinery once, fanned out over a one-shot
+// crew of threads. Smaller codes are expanded first, so the capture
+// resolution of larger ones already hits the expanded tier.
+bool expand_bitbase(const std::string& code) {
+
+    auto bb = std::make_unique<ExpandedBitbase>();
+
+    bool white = true;
+    for (const char ch : code)
+        if (ch == 'v')
+            white = false;
+        else
+        {
+            const usize pt = PieceToChar.find(ch);
+            if (pt == std::string_view::npos || pt > KING)
+                return false;
+            bb->order.push_back(make_piece(white ? WHITE : BLACK, PieceType(pt)));
+        }
+
+    if (white || bb->order.size() > 4 || code[0] != 'K' || code[code.find('v') + 1] != 'K')
+        return false;
+
+    // Material keys of both orientations, as in the TBTable constructor
+    Position  pos;
+    StateInfo st;
+    (void) pos.set(code, WHITE, &st);
+    const Key key = pos.material_key();
+    (void) pos.set(code, BLACK, &st);
+    const Key key2 = pos.material_key();
+
+    const usize slots = usize(2) << 6 * bb->order.size();
+    const usize bytes = slots / 4;
+
+    bb->data = make_unique_large_page<u8[]>(bytes);
+
+    constexpr usize    BytesPerJob = 4096;
+    std::atomic<usize> next{0};
+    std::atomic<bool>  ok{true};
+
+    auto work = [&]() {
+        for (usize job; ok && (job = next.fetch_add(BytesPerJob)) < bytes;)
+            for (usize byte = job, end = std::min(job + BytesPerJob, bytes); byte < end; ++byte)
+            {
+                u8 packed = 0;
+                for (usize part = 0; part < 4; ++part)
+                    packed |= u8(fill_slot(bb->order, byte * 4 + part, ok) << 2 * part);
+                bb->data[byte] = packed;
+            }
+    };
+
+    const usize threadCount = std::min<usize>({bytes / BytesPerJob + 1, SYSTEM_THREADS_NB, 16});
+
+    std::vector<std::thread> crew;
+    for (usize t = 1; t < threadCount; ++t)
+        crew.emplace_back(work);
+    work();
+    for (auto& th : crew)
+        th.join();
+
+    if (!ok)
+        return false;
+
+    const ExpandedBitbase* p = BitbaseStore.emplace_back(std::move(bb)).get();
+
+    // For symmetric material both orientations share one entry
+    BitbaseMap.emplace(key, std::make_pair(p, false));
+    BitbaseMap.emplace(key2, std::make_pair(p, true));
+    return true;
+}
+
 }  // namespace
 
 
 // Called at startup and after every change to
 // "SyzygyPath" UCI option to (re)create the various tables. It is not thread
 // safe, nor it needs to be.
-void Tablebases::init(const std::string& paths) {
+void Tablebases::set_pin_limit(int maxPieces) {
+    PinLimit.store(maxPieces, std::memory_order_relaxed);
+}
+
+void Tablebases::set_block_cache_size(usize mb) { BlockCache.resize(mb); }
+
+void Tablebases::set_bitbases(const std::string& codes) {
+
+    BitbasesEnabled.store(false, std::memory_order_relaxed);
+    BitbaseMap.clear();
+    BitbaseStore.clear();
+
+    std::vector<std::string> requested;
+    std::string              code;
+    std::istringstream       ss(codes);
+
+    while (ss >> code)
+        requested.push_back(code);
+
+    // Fewest pieces first, so larger expansions probe through smaller ones
+    std::stable_sort(requested.begin(), requested.end(),
+                     [](const std::string& a, const std::string& b) { return a.size() < b.size(); });
+
+    for (const std::string& c : requested)
+    {
+        const TimePoint start = now();
+
+        if (expand_bitbase(c))
+        {
+            BitbasesEnabled.store(true, std::memory_order_relaxed);
+            sync_cout << "info string Expanded bitbase " << c << " in " << now() - start << "ms"
+                      << sync_endl;
+        }
+        else
+            sync_cout << "info string Bitbase expansion failed for " << c
+                      << " (missing tablebase files?)" << sync_endl;
+    }
+}
+
+void Tablebases::init(const std::string& paths, ThreadPool* threads) {
 
+    Prefetcher.stop();  // The prefetcher holds pointers into the tables
+    BlockCache.clear();  // Cached blocks are keyed by pointers into the tables
     TBTables.clear();
     MaxCardinality = 0;
     TBFile::Paths  = paths;
@@ -1410,6 +2063,10 @@ void Tablebases::init(const std::string& paths) {
     if (paths.empty())
         return;
 
+    // One directory listing per path replaces the thousands of per-file
+    // existence checks done in TBTables::add() below
+    TBFileIndex.scan(threads);
+
     // MapB1H1H7[] encodes a square below a1-h8 diagonal to 0..27
     int code = 0;
     for (Square s = SQ_A1; s <= SQ_H8; ++s)
@@ -1558,10 +2215,38 @@ void Tablebases::init(const std::string& paths) {
 //  0 : draw
 //  1 : win, but draw under 50-move rule
 //  2 : win
-WDLScore Tablebases::probe_wdl(Position& pos, ProbeState* result) {
+WDLScore Tablebases::probe_wdl(Position& pos, ProbeState* result, WDLCache* cache) {
+
+    PROFILE_SCOPE(TBProbe);
 
     *result = OK;
-    return search<false>(pos, result);
+
+    WDLScore wdl;
+    if (cache && cache->probe(pos.key(), wdl))
+        return wdl;
+
+    wdl = search<false>(pos, result);
+
+    if (cache && *result != FAIL)
+        cache->store(pos.key(), wdl);
+
+    return wdl;
+}
+
+// Queue the WDL table for the position's material for background mapping and
+// page touching, so that a later probe does not block on first-touch I/O.
+void Tablebases::prefetch_wdl(const Position& pos) {
+
+    if (pos.count<ALL_PIECES>() == 2)  // KvK
+        return;
+
+    TBTable<WDL>* entry = TBTables.get<WDL>(pos.material_key());
+
+    if (!entry || entry->ready.load(std::memory_order_acquire)
+        || entry->prefetched.exchange(true, std::memory_order_relaxed))
+        return;
+
+    Prefetcher.enqueue(entry, table_fname(*entry, pos));
 }
 
 // Probe the DTZ table for a particular position.
@@ -1629,7 +2314,7 @@ int Tablebases::probe_dtz(Position& pos, ProbeState* result) {
         dtz = zeroing ? -dtz_before_zeroing(search<false>(pos, result)) : -probe_dtz(pos, result);
 
         // If the move mates, force minDTZ to 1
-        if (dtz == 1 && pos.checkers() && MoveList<LEGAL>(pos).size() == 0)
+        if (dtz == 1 && pos.checkers() && LazyLegalMoveList(pos).empty())
             minDTZ = 1;
 
         // Convert result from 1-ply search. Zeroing moves are already accounted
@@ -1699,7 +2384,7 @@ bool Tablebases::root_probe(Position&                    pos,
         }
 
         // Make sure that a mating move is assigned a dtz value of 1
-        if (pos.checkers() && dtz == 2 && MoveList<LEGAL>(pos).size() == 0)
+        if (pos.checkers() && dtz == 2 && LazyLegalMoveList(pos).empty())
             dtz = 1;
 
         pos.undo_move(m.pv[0]);
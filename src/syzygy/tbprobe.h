@@ -23,10 +23,13 @@
 #include <string>
 #include <vector>
 
+#include "../types.h"
+
 
 namespace Stockfish {
 class Position;
 class OptionsMap;
+class ThreadPool;
 
 using Depth = int;
 
@@ -63,9 +66,56 @@ enum ProbeState {
 
 extern int MaxCardinality;
 
+// Small per-thread, direct-mapped cache of recent WDL probe results. WDL probes
+// are only issued when the rule50 counter is zero and no castling is possible,
+// so the position key alone identifies the result. One cache per search thread
+// avoids synchronization and skips repeated decompression on transpositions.
+struct WDLCache {
+    static constexpr usize Size = 1 << 12;  // Must be a power of two
+
+    bool probe(Key key, WDLScore& wdl) const {
+        const Entry& e = entries[key & (Size - 1)];
+        if (e.key != key)
+            return false;
+        wdl = e.wdl;
+        return true;
+    }
+
+    void store(Key key, WDLScore wdl) { entries[key & (Size - 1)] = {key, wdl}; }
+
+    void clear() {
+        for (Entry& e : entries)
+            e = Entry{};
+    }
+
+   private:
+    struct Entry {
+        Key      key = 0;
+        WDLScore wdl = WDLDraw;
+    };
+
+    Entry entries[Size];
+};
+
 
-void     init(const std::string& paths);
-WDLScore probe_wdl(Position& pos, ProbeState* result);
+// Scans the path directories and (re)builds the tables of available TBs. When
+// a thread pool is supplied, the directories are listed in parallel on it.
+void init(const std::string& paths, ThreadPool* threads = nullptr);
+// Tables with at most maxPieces pieces get locked into RAM when they are
+// memory mapped, so they cannot be evicted under memory pressure. 0 = off.
+void set_pin_limit(int maxPieces);
+// Resizes the LRU cache of decoded data blocks (in MiB). 0 disables it.
+void set_block_cache_size(usize mb);
+// Expands the WDL tables for the given space-separated material codes (e.g.
+// "KQvK KPvK", at most 4 pieces each) into flat in-RAM bitbases probed with
+// pure index arithmetic; anything not covered falls back to the regular
+// probe. Requires "SyzygyPath" to be set first. An empty string drops the
+// expanded tier.
+void set_bitbases(const std::string& codes);
+WDLScore probe_wdl(Position& pos, ProbeState* result, WDLCache* cache = nullptr);
+// Hand the WDL table for this material to the background prefetcher, which
+// memory maps it and touches its indexing pages ahead of the first real probe
+void prefetch_wdl(const Position& pos);
 int      probe_dtz(Position& pos, ProbeState* result);
 bool     root_probe(Position&                    pos,
                     Search::RootMoves&           rootMoves,
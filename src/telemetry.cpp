@@ -0,0 +1,66 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "telemetry.h"
+
+#include <cstring>
+
+namespace Stockfish::Telemetry {
+
+Publisher::Publisher() :
+    region("telemetry") {
+
+    Directory* dir = region.get();
+    if (dir == nullptr)
+        return;
+
+    dir->version = LayoutVersion;
+
+    // Any nonzero value works as an owner token; mix the clock with this
+    // object's address so concurrently starting engines do not collide.
+    u64 token = u64(now()) * 6364136223846793005ULL ^ u64(uintptr_t(this));
+    token += !token;
+
+    for (Slot& s : dir->slots)
+    {
+        u64 expected = 0;
+        if (s.owner.compare_exchange_strong(expected, token, std::memory_order_relaxed))
+        {
+            mySlot = &s;
+            return;
+        }
+    }
+}
+
+Publisher::~Publisher() {
+
+    if (mySlot == nullptr)
+        return;
+
+    // Zero the counters before releasing, so a reader never sees stale data
+    // under a new owner.
+    mySlot->nodes = mySlot->nps = mySlot->elapsedMs = 0;
+    mySlot->hashfull = mySlot->rootDepth = mySlot->selDepth = 0;
+    mySlot->searching = mySlot->threadCount = 0;
+    for (RelaxedAtomic<u32>& n : mySlot->numaThreads)
+        n = 0;
+
+    mySlot->owner.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace Stockfish::Telemetry
@@ -0,0 +1,86 @@
+/*
+  Stockfish, a UCI chess playing engine derived from Glaurung 2.1
+  Copyright (C) 2004-2026 The Stockfish developers (see AUTHORS file)
+
+  Stockfish is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Stockfish is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TELEMETRY_H_INCLUDED
+#define TELEMETRY_H_INCLUDED
+
+#include <atomic>
+
+#include "misc.h"
+#include "shm.h"
+#include "types.h"
+
+namespace Stockfish::Telemetry {
+
+// Live search counters exported through a shared-memory directory so that an
+// external monitoring agent can read them with plain loads, without scraping
+// 'info' lines and without any engine-side syscalls. The directory is one
+// SystemWideSharedRegion (named after the executable, see shm.h) holding a
+// fixed number of slots; every ThreadPool claims a free slot on startup, so
+// one agent mapping sees all engine instances of that build on the host.
+//
+// All fields are updated racily with relaxed stores, like the rest of the
+// Lazy SMP state: readers get per-field consistency and nothing more, which
+// is all monitoring needs.
+
+constexpr u32   LayoutVersion = 1;
+constexpr usize MaxSlots      = 64;
+constexpr usize MaxNumaNodes  = 16;
+
+struct alignas(64) Slot {
+    // Nonzero while an engine owns the slot; claimed by CAS from zero and
+    // reset on release, so a reader treats zero as "unused".
+    std::atomic<u64> owner;
+
+    RelaxedAtomic<u64> nodes;
+    RelaxedAtomic<u64> nps;
+    RelaxedAtomic<u64> elapsedMs;
+    RelaxedAtomic<u32> hashfull;  // permille, like the UCI field
+    RelaxedAtomic<u32> rootDepth;
+    RelaxedAtomic<u32> selDepth;
+    RelaxedAtomic<u32> searching;
+    RelaxedAtomic<u32> threadCount;
+    RelaxedAtomic<u32> numaThreads[MaxNumaNodes];  // searching threads per NUMA node
+};
+
+struct Directory {
+    RelaxedAtomic<u32> version;  // LayoutVersion, for the reader's sanity check
+    Slot               slots[MaxSlots];
+};
+
+// Attaches the directory and claims one slot for the lifetime of the owning
+// ThreadPool. When shared memory is unavailable or all slots are taken,
+// slot() is nullptr and publishing silently becomes a no-op.
+class Publisher {
+   public:
+    Publisher();
+    ~Publisher();
+
+    Publisher(const Publisher&)            = delete;
+    Publisher& operator=(const Publisher&) = delete;
+
+    Slot* slot() const { return mySlot; }
+
+   private:
+    SystemWideSharedRegion<Directory> region;
+    Slot*                             mySlot = nullptr;
+};
+
+}  // namespace Stockfish::Telemetry
+
+#endif  // #ifndef TELEMETRY_H_INCLUDED
@@ -20,9 +20,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
-#include <deque>
 #include <map>
 #include <memory>
 #include <string>
@@ -155,6 +155,7 @@ void ThreadPool::set(const NumaConfig&                           numaConfig,
 
     if (threads.size() > 0)  // destroy any existing thread(s)
     {
+        abortIdle = true;
         main_thread()->wait_for_search_finished();
 
         threads.clear();
@@ -203,7 +204,14 @@ void ThreadPool::set(const NumaConfig&                           numaConfig,
             NumaIndex numaIndex = pair.first;
             u64       count     = pair.second;
             auto      f         = [&]() {
-                sharedState.sharedHistories.try_emplace(numaIndex, next_power_of_two(count));
+                // With cross-process sharing all NUMA nodes attach to the same
+                // region; converging with other processes is worth the extra
+                // cross-node traffic in that (opt-in) configuration.
+                if (sharedState.crossProcessHistory)
+                    sharedState.sharedHistories.try_emplace(numaIndex,
+                                                            sharedState.crossProcessHistory);
+                else
+                    sharedState.sharedHistories.try_emplace(numaIndex, next_power_of_two(count));
             };
             if (doBindThreads)
                 numaConfig.execute_on_numa_node(numaIndex, f);
@@ -243,6 +251,31 @@ void ThreadPool::set(const NumaConfig&                           numaConfig,
                 create_thread();
         }
 
+        // Hybrid P/E-core placement (see the PCoreShare option): pin the main
+        // thread plus the configured share of helpers to performance cores and
+        // the remaining helpers to efficiency cores, so time management and PV
+        // reporting never land on a slow core by scheduler luck. Skipped when
+        // the NUMA policy already bound threads, since the two affinity masks
+        // would conflict; hybrid desktops are single-node in practice.
+        if (const int pShare = int(sharedState.options["PCoreShare"]); pShare && !doBindThreads)
+        {
+            static const HybridTopology hybrid = HybridTopology::from_system();
+
+            if (hybrid.is_hybrid())
+            {
+                const usize pCount = 1 + (threads.size() - 1) * usize(pShare) / 100;
+
+                for (usize i = 0; i < threads.size(); ++i)
+                {
+                    Thread& th          = *threads[i];
+                    th.onEfficiencyCore = i >= pCount;
+                    const auto& cpus =
+                      th.onEfficiencyCore ? hybrid.efficiencyCpus : hybrid.performanceCpus;
+                    th.run_custom_job([&cpus]() { bind_current_thread_to_cpus(cpus); });
+                }
+            }
+        }
+
         clear();
 
         main_thread()->wait_for_search_finished();
@@ -255,6 +288,8 @@ void ThreadPool::clear() {
     if (threads.size() == 0)
         return;
 
+    abortIdle = true;
+
     for (auto&& th : threads)
         th->clear_worker();
 
@@ -265,6 +300,8 @@ void ThreadPool::clear() {
     main_manager()->bestPreviousAverageScore = VALUE_INFINITE;
     main_manager()->previousTimeReduction    = 0.85;
 
+    treeRetention.clear();
+
     main_manager()->callsCnt           = 0;
     main_manager()->bestPreviousScore  = VALUE_INFINITE;
     main_manager()->originalTimeAdjust = -1;
@@ -273,6 +310,7 @@ void ThreadPool::clear() {
 
 void ThreadPool::run_on_thread(usize threadId, std::function<void()> f) {
     assert(threads.size() > threadId);
+    abortIdle = true;
     threads[threadId]->run_custom_job(std::move(f));
 }
 
@@ -284,6 +322,37 @@ void ThreadPool::wait_on_thread(usize threadId) {
 usize ThreadPool::num_threads() const { return threads.size(); }
 
 
+// Change the number of threads allowed to search. Parked helpers re-check
+// the target within a couple of milliseconds, so shrinking frees the cores
+// almost immediately and growing puts them back to work mid-iteration.
+void ThreadPool::set_active_threads(usize n) {
+    {
+        std::lock_guard<std::mutex> lock(parkMutex);
+        activeTarget.store(n, std::memory_order_relaxed);
+    }
+    parkCv.notify_all();
+}
+
+usize ThreadPool::active_threads() const {
+    usize n = activeTarget.load(std::memory_order_relaxed);
+    return n == 0 ? threads.size() : std::min(n, threads.size());
+}
+
+// Blocks a helper while it is above the active-thread target. The wait is a
+// short timed poll rather than a pure condition wait, so the many places that
+// raise threads.stop release parked helpers without having to notify anyone.
+void ThreadPool::park_point(usize threadIdx) {
+    assert(threadIdx != 0);
+
+    if (threadIdx < active_threads() || stop)
+        return;
+
+    std::unique_lock<std::mutex> lock(parkMutex);
+    while (!stop && threadIdx >= active_threads())
+        parkCv.wait_for(lock, std::chrono::milliseconds(2));
+}
+
+
 // Wakes up main thread waiting in idle_loop() and returns immediately.
 // Main thread will wake up other threads and start the search.
 void ThreadPool::start_thinking(const OptionsMap&  options,
@@ -291,6 +360,7 @@ void ThreadPool::start_thinking(const OptionsMap&  options,
                                 StateListPtr&      states,
                                 Search::LimitsType limits) {
 
+    abortIdle = true;
     main_thread()->wait_for_search_finished();
 
     main_manager()->stopOnPonderhit = stop = false;
@@ -298,8 +368,16 @@ void ThreadPool::start_thinking(const OptionsMap&  options,
 
     increaseDepth = true;
 
+    nodeBudget.store(i64(limits.nodes), std::memory_order_relaxed);
+
+    // Clear any stale root move claims; claims are balanced across a search,
+    // but resetting here keeps the counters sane after an aborted one.
+    for (auto& busy : rootMoveBusy)
+        busy.store(0, std::memory_order_relaxed);
+
     Search::RootMoves rootMoves;
     const auto        legalmoves = MoveList<LEGAL>(pos);
+    rootMoves.reserve(legalmoves.size());
 
     for (const auto& uciMove : limits.searchmoves)
     {
@@ -315,6 +393,30 @@ void ThreadPool::start_thinking(const OptionsMap&  options,
 
     Tablebases::Config tbConfig = Tablebases::rank_root_moves(options, pos, rootMoves);
 
+    // Re-apply root statistics from a restored search snapshot when this 'go'
+    // resumes the saved position; seeds are one-shot so stale state can never
+    // leak into an unrelated search.
+    if (resumeSeed)
+    {
+        if (resumeSeed->positionKey == pos.key())
+            for (const auto& e : resumeSeed->entries)
+            {
+                auto rm = std::find(rootMoves.begin(), rootMoves.end(), e.move);
+                if (rm == rootMoves.end())
+                    continue;
+                rm->previousScore      = e.previousScore;
+                rm->averageScore       = e.averageScore;
+                rm->meanSquaredScore   = e.meanSquaredScore;
+                rm->uciScore           = e.uciScore;
+                rm->previousScoreExact = e.previousScoreExact;
+                rm->selDepth           = e.selDepth;
+                rm->previousPV         = e.previousPV;
+            }
+        resumeSeed.reset();
+    }
+
+    multiPVResults.reset(std::min(usize(options["MultiPV"]), rootMoves.size()));
+
     // After ownership transfer 'states' becomes empty, so if we stop the search
     // and call 'go' again without setting a new position states.get() == nullptr.
     assert(states.get() || setupStates.get());
@@ -322,31 +424,73 @@ void ThreadPool::start_thinking(const OptionsMap&  options,
     if (states.get())
         setupStates = std::move(states);  // Ownership transfer, states is now empty
 
-    // We use Position::set() to set root position across threads. But there are
-    // some StateInfo fields (previous, pliesFromNull, capturedPiece) that cannot
-    // be deduced from a fen string, so set() clears them and they are set from
-    // setupStates->back() later. The rootState is per thread, earlier states are
-    // shared since they are read-only.
-    for (auto&& th : threads)
+    // Publish the root state once; the setup jobs below read it concurrently.
+    // No setup job from the previous search can still be looking at it: the
+    // previous main search synchronized with every one of them through
+    // ThreadPool::start_searching() before it produced its bestmove.
+    rootSnapshot.limits    = limits;
+    rootSnapshot.rootMoves = std::move(rootMoves);
+    rootSnapshot.fen       = pos.fen();
+    rootSnapshot.chess960  = pos.is_chess960();
+    rootSnapshot.tbConfig  = tbConfig;
+
+    if (scheduleRecorder.enabled())
+        scheduleRecorder.start_search(rootSnapshot.fen, rootSnapshot.chess960);
+
+    if (Telemetry::Slot* t = telemetry.slot())
     {
-        th->run_custom_job([&]() {
-            th->worker->limits = limits;
-            th->worker->nodes = th->worker->tbHits = th->worker->bestMoveChanges = 0;
-            th->worker->nmpMinPly                                                = 0;
-            th->worker->rootDepth                                                = 0;
-            th->worker->rootMoves                                                = rootMoves;
-            th->worker->rootPos.set(pos.fen(), pos.is_chess960(), &th->worker->rootState);
-            th->worker->rootState = setupStates->back();
-            th->worker->tbConfig  = tbConfig;
-        });
+        t->nodes = t->nps = t->elapsedMs = 0;
+        t->hashfull = t->rootDepth = t->selDepth = 0;
+        t->threadCount                           = u32(threads.size());
+
+        const std::vector<usize> counts = get_bound_thread_count_by_numa_node();
+        for (usize n = 0; n < Telemetry::MaxNumaNodes; ++n)
+            t->numaThreads[n] = n < counts.size() ? u32(counts[n]) : 0;
+
+        t->searching = 1;
     }
 
+    // The main thread is known to be idle, so its worker is set up right here
+    // and woken immediately, without waiting for the slowest helper. The
+    // helpers copy the snapshot concurrently; each one's eventual
+    // start_searching() call from the main thread queues behind its setup job
+    // (run_custom_job() waits for the thread to go idle), so no barrier is
+    // needed in between.
     for (auto&& th : threads)
-        th->wait_for_search_finished();
+        if (th == threads.front())
+            setup_worker(*th->worker);
+        else
+            th->run_custom_job([this, w = th->worker.get()]() { setup_worker(*w); });
+
+    // With no legal moves the main search replies immediately, without ever
+    // synchronizing with the helpers, so in that rare case keep the old
+    // barrier to guarantee the snapshot outlives the jobs.
+    if (rootSnapshot.rootMoves.empty())
+        for (auto&& th : threads)
+            th->wait_for_search_finished();
 
+    abortIdle = false;
     main_thread()->start_searching();
 }
 
+// Copies the published root state into one worker. We use Position::set() to
+// set the root position across threads. But there are some StateInfo fields
+// (previous, pliesFromNull, capturedPiece) that cannot be deduced from a fen
+// string, so set() clears them and they are set from setupStates->back()
+// later. The rootState is per thread, earlier states are shared since they
+// are read-only.
+void ThreadPool::setup_worker(Search::Worker& w) const {
+    w.limits = rootSnapshot.limits;
+    w.nodes = w.tbHits = w.bestMoveChanges = 0;
+    w.nodeTokens                           = 0;
+    w.nmpMinPly                            = 0;
+    w.rootDepth                            = 0;
+    w.rootMoves                            = rootSnapshot.rootMoves;
+    w.rootPos.set(rootSnapshot.fen, rootSnapshot.chess960, &w.rootState);
+    w.rootState = setupStates->back();
+    w.tbConfig  = rootSnapshot.tbConfig;
+}
+
 Thread* ThreadPool::get_best_thread() const {
 
     Thread* bestThread = threads.front().get();
@@ -359,9 +503,12 @@ Thread* ThreadPool::get_best_thread() const {
     for (auto&& th : threads)
         minScore = std::min(minScore, th->worker->rootMoves[0].score);
 
-    // Vote according to score and depth, and select the best thread
+    // Vote according to score and depth, and select the best thread. Helpers
+    // confined to efficiency cores complete fewer, shallower iterations per
+    // wall clock, so their say is damped accordingly.
     auto thread_voting_value = [minScore](Thread* th) {
-        return (th->worker->rootMoves[0].score - minScore + 14) * int(th->worker->rootDepth);
+        i64 value = (th->worker->rootMoves[0].score - minScore + 14) * int(th->worker->rootDepth);
+        return th->onEfficiencyCore ? value * 2 / 3 : value;
     };
 
     for (auto&& th : threads)
@@ -459,8 +606,15 @@ usize ThreadPool::numa_nodes() const {
 }
 
 void ThreadPool::ensure_network_replicated() {
+    // Run the forced access on every worker's own thread, so each node's
+    // replica is copied and its pages faulted on a thread bound to the target
+    // node, and all nodes replicate in parallel instead of one after another
+    // through the caller (the replicas take a per-node lock, see numa.h).
     for (auto&& th : threads)
-        th->ensure_network_replicated();
+        th->run_custom_job([&th]() { th->ensure_network_replicated(); });
+
+    for (auto&& th : threads)
+        th->wait_for_search_finished();
 }
 
 }  // namespace Stockfish
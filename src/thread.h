@@ -19,11 +19,13 @@
 #ifndef THREAD_H_INCLUDED
 #define THREAD_H_INCLUDED
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include "memory.h"
@@ -31,6 +33,7 @@
 #include "numa.h"
 #include "position.h"
 #include "search.h"
+#include "telemetry.h"
 #include "thread_win32_osx.h"
 
 namespace Stockfish {
@@ -98,6 +101,10 @@ class Thread {
     LargePagePtr<Search::Worker> worker;
     std::function<void()>        jobFunc;
 
+    // Set by the hybrid P/E-core placement in ThreadPool::set; efficiency-core
+    // helpers get a reduced say in best-thread voting
+    bool onEfficiencyCore = false;
+
    private:
     std::mutex                mutex;
     std::condition_variable   cv;
@@ -119,6 +126,7 @@ class ThreadPool {
         // destroy any existing thread(s)
         if (threads.size() > 0)
         {
+            abortIdle = true;
             main_thread()->wait_for_search_finished();
 
             threads.clear();
@@ -154,8 +162,57 @@ class ThreadPool {
 
     void ensure_network_replicated();
 
+    // Root move coordination (see the RootCoordination option). Each root move
+    // maps to a busy counter through its raw bits; helper threads claim a move
+    // while searching it, so their peers can deprioritize duplicated work.
+    // Counters are racy by design, exactly like the rest of Lazy SMP state.
+    void claim_root_move(Move m) { rootMoveBusy[m.raw()].fetch_add(1, std::memory_order_relaxed); }
+    void release_root_move(Move m) {
+        rootMoveBusy[m.raw()].fetch_sub(1, std::memory_order_relaxed);
+    }
+    bool root_move_busy(Move m) const {
+        return rootMoveBusy[m.raw()].load(std::memory_order_relaxed) > 0;
+    }
+
+    // Elastic sizing for co-tenanted hosts: helpers whose index is at or
+    // above the active target park at iteration boundaries instead of
+    // searching, keeping their OS thread, NUMA binding and history tables
+    // warm for an instant unpark. 0 means every thread is active. The target
+    // may be changed at any time, including during a search, from the UCI
+    // thread ('activethreads' command).
+    void  set_active_threads(usize n);
+    usize active_threads() const;
+    void  park_point(usize threadIdx);
+
     std::atomic_bool stop, increaseDepth;
 
+    // Pool-wide token bucket for node-limited searches: primed with
+    // limits.nodes by start_thinking(), drained in batches by the workers
+    // (see Worker::refill_node_tokens()), so the limit is enforced within
+    // threads * batch nodes with one shared fetch_sub per batch instead of
+    // summing every worker's counter on each time-check poll.
+    std::atomic<i64> nodeBudget{0};
+
+    // Interrupt flag for the idle-time maintenance that the main thread runs
+    // after sending its bestmove (see Worker::idle_maintenance()). Raised by
+    // every pool entry point that needs an idle thread and polled by the
+    // maintenance tasks at fine granularity, lowered by start_thinking() once
+    // the next search is set up.
+    std::atomic_bool abortIdle{true};
+
+    // Records per-iteration node schedules when the NodeScheduleFile option
+    // is set; lives here so every worker can reach it (see search.h)
+    Search::NodeScheduleRecorder scheduleRecorder;
+    Search::TreeRetention        treeRetention;
+    Search::MultiPVResults       multiPVResults;
+
+    // Set by Engine::load_search_state(), consumed by the next
+    // start_thinking(); see Search::RootResumeSeed
+    std::unique_ptr<Search::RootResumeSeed> resumeSeed;
+
+    // Live counters exported for external monitoring agents (see telemetry.h)
+    Telemetry::Publisher telemetry;
+
     auto cbegin() const noexcept { return threads.cbegin(); }
     auto begin() noexcept { return threads.begin(); }
     auto end() noexcept { return threads.end(); }
@@ -164,10 +221,32 @@ class ThreadPool {
     auto empty() const noexcept { return threads.empty(); }
 
    private:
+    // Root state published once per 'go' by start_thinking() and read
+    // concurrently by the per-thread setup jobs. It lives here because the
+    // jobs may still be copying from it after start_thinking() has returned.
+    struct RootStateSnapshot {
+        Search::LimitsType limits;
+        Search::RootMoves  rootMoves;
+        std::string        fen;
+        bool               chess960;
+        Tablebases::Config tbConfig;
+    };
+
+    void setup_worker(Search::Worker& w) const;
+
+    RootStateSnapshot                    rootSnapshot;
     StateListPtr                         setupStates;
     std::vector<std::unique_ptr<Thread>> threads;
     std::vector<NumaIndex>               boundThreadToNumaNode;
 
+    // See set_active_threads()/park_point()
+    std::atomic<usize>      activeTarget{0};
+    mutable std::mutex      parkMutex;
+    std::condition_variable parkCv;
+
+    // One counter per possible Move::raw() value; reset on each 'go'
+    std::array<std::atomic<u8>, 1 << 16> rootMoveBusy;
+
     u64 accumulate(RelaxedAtomic<u64> Search::Worker::* member) const {
 
         u64 sum = 0;
@@ -47,7 +47,8 @@ class TimeManagement {
     TimePoint elapsed(FUNC nodes) const {
         return useNodesTime ? TimePoint(nodes()) : elapsed_time();
     }
-    TimePoint elapsed_time() const { return now() - startTime; };
+    // Uses the syscall-free coarse clock: this runs on every time check
+    TimePoint elapsed_time() const { return CoarseClock::now() - startTime; };
 
     void clear();
     void advance_nodes_time(i64 nodes);
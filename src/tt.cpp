@@ -22,21 +22,29 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <vector>
 
+#include "bitboard.h"
+#include "disttt.h"
 #include "memory.h"
 #include "misc.h"
+#include "profile.h"
 #include "syzygy/tbprobe.h"
 #include "thread.h"
 
+#ifdef USE_SSE2
+    #include <emmintrin.h>
+#endif
+
 namespace Stockfish {
 
 
-// TTEntry struct is the 10 bytes transposition table entry, defined as:
+// TTEntry struct is the 8 bytes transposition table payload, defined as:
 //
-// key        16 bit
 // depth       8 bit
 // pv node     1 bit
 // bound type  2 bit
@@ -45,6 +53,10 @@ namespace Stockfish {
 // value      16 bit
 // evaluation 16 bit
 //
+// The 16-bit key lives outside the entry: the keys of a whole cluster are packed
+// contiguously at the front of the Cluster so that probe() can compare all of them
+// with a single SIMD compare, see TranspositionTable::probe().
+//
 // These fields are in the same order as accessed by TT::probe(), since memory is fastest sequentially.
 // Equally, the store order in save() matches this order.
 //
@@ -72,14 +84,21 @@ struct TTEntry {
     }
 
     bool is_occupied() const { return bool(depth8); };
-    void save(Key k, Value v, bool pv, Bound b, Depth d, Move m, Value ev, u8 curr_generation);
+    void save(RelaxedAtomic<u16>& key16,
+              Key                 k,
+              Value               v,
+              bool                pv,
+              Bound               b,
+              Depth               d,
+              Move                m,
+              Value               ev,
+              u8                  curr_generation);
     u8   relative_age(const u8 curr_generation) const;
 
    private:
     friend class TranspositionTable;
     friend struct TTWriter;
 
-    RelaxedAtomic<u16>  key16;
     RelaxedAtomic<u8>   depth8;
     RelaxedAtomic<u8>   genBound8;
     RelaxedAtomic<Move> move16;
@@ -89,8 +108,15 @@ struct TTEntry {
 
 // Populates the TTEntry with a new node's data, possibly
 // overwriting an old position. The update is non-atomic and can be racy.
-void TTEntry::save(
-  Key k, Value v, bool pv, Bound b, Depth d, Move m, Value ev, u8 curr_generation) {
+void TTEntry::save(RelaxedAtomic<u16>& key16,
+                   Key                 k,
+                   Value               v,
+                   bool                pv,
+                   Bound               b,
+                   Depth               d,
+                   Move                m,
+                   Value               ev,
+                   u8                  curr_generation) {
 
     // Preserve the old ttmove if we don't have a new one
     if (m || u16(k) != key16)
@@ -132,13 +158,18 @@ u8 TTEntry::relative_age(const u8 curr_generation) const {
 }
 
 
-// TTWriter is but a very thin wrapper around the pointer
-TTWriter::TTWriter(TTEntry* tte) :
-    entry(tte) {}
+// TTWriter is but a very thin wrapper around the entry and its key slot
+TTWriter::TTWriter(TTEntry* tte, RelaxedAtomic<u16>* k) :
+    entry(tte),
+    key(k) {}
 
 void TTWriter::write(
   Key k, Value v, bool pv, Bound b, Depth d, Move m, Value ev, u8 curr_generation) {
-    entry->save(k, v, pv, b, d, m, ev, curr_generation);
+    entry->save(*key, k, v, pv, b, d, m, ev, curr_generation);
+
+    // Deep entries are worth replicating across the cluster, when one exists
+    if (d >= DistTT::MinShareDepth && DistTT::enabled())
+        DistTT::publish(k, v, pv, b, d, m, ev);
 }
 
 void TTWriter::penalize(int penalty) {
@@ -148,33 +179,70 @@ void TTWriter::penalize(int penalty) {
 
 
 // A TranspositionTable is an array of Cluster, of size clusterCount. Each cluster consists of ClusterSize number
-// of TTEntry. Each non-empty TTEntry contains information on exactly one position. The size of a Cluster should
-// divide the size of a cache line for best performance, as the cacheline is prefetched when possible.
+// of TTEntry. Each non-empty TTEntry contains information on exactly one position. A Cluster fills exactly one
+// cache line, which is prefetched when possible, and the higher associativity (6-way instead of the former
+// 3-way) cuts collisions noticeably once the table runs near full.
+//
+// The layout is struct-of-arrays within the cluster: the six 16-bit keys are packed contiguously at the front
+// so a single 128-bit compare-and-movemask probes all of them at once, followed by the six 8-byte payloads.
 
-static constexpr int ClusterSize = 3;
+static constexpr int ClusterSize = 6;
 
 struct Cluster {
-    TTEntry entry[ClusterSize];
-    char    padding[2];  // Pad to 32 bytes
+    RelaxedAtomic<u16> key16[ClusterSize];
+    TTEntry            entry[ClusterSize];
+    // Soft-clear epoch: a cluster whose epoch lags the table-wide one holds
+    // only pre-clear data and is treated as empty, then lazily reset when
+    // probed. Uses one of the padding bytes, so clusters stay 64 bytes.
+    RelaxedAtomic<u8> epoch;
+    char              padding[3];  // Pad to 64 bytes
 };
 
-static_assert(sizeof(Cluster) == 32, "Suboptimal Cluster size");
+static_assert(sizeof(Cluster) == 64, "Suboptimal Cluster size");
 
 
 // Sets the size of the transposition table,
 // measured in megabytes. Transposition table consists
 // of clusters and each cluster consists of ClusterSize number of TTEntry.
+// An existing table whose shard layout is unchanged is resized in place with
+// its entries rehashed into the new geometry, so that adjusting Hash
+// mid-session does not discard the accumulated search state; see
+// resize_in_place() below. Everything else gets a fresh, zeroed table.
 void TranspositionTable::resize(usize mbSize, ThreadPool& threads) {
+
+    // In sharded mode the cluster array is partitioned into one equally sized,
+    // contiguous shard per NUMA node. Trim the remainder so shards are equal.
+    const usize newShardCount = sharded ? std::max<usize>(threads.numa_nodes(), 1) : 1;
+    const usize newShardClusterCount = mbSize * 1024 * 1024 / sizeof(Cluster) / newShardCount;
+    const usize newClusterCount      = newShardClusterCount * newShardCount;
+
+    if (table && newClusterCount == clusterCount && newShardCount == shardCount)
+        return;
+
+    if (table && newShardCount == shardCount && resize_in_place(newShardClusterCount))
+        return;
+
     aligned_large_pages_free(table);
 
-    clusterCount  = mbSize * 1024 * 1024 / sizeof(Cluster);
+    clusterCount      = newClusterCount;
+    shardCount        = newShardCount;
+    shardClusterCount = newShardClusterCount;
+
     usize ttBytes = clusterCount * sizeof(Cluster);
 
     // Request 1GB pages if we'd get at least eight per NUMA node, to avoid
     // memory oversubscription
     bool hugePageHint = ttBytes >= threads.numa_nodes() * HugePageSize * 8;
 
-    table = static_cast<Cluster*>(aligned_large_pages_alloc_with_hint(ttBytes, hugePageHint));
+    // On multi-node systems without sharding, interleave the table across the
+    // nodes so that a lone first-touching thread cannot pull the whole range
+    // onto its own node; with sharding, the parallel first touch in clear()
+    // already places each shard in node-local memory.
+    AllocPolicy policy = !sharded && threads.numa_nodes() > 1 ? AllocPolicy::Interleave
+                                                              : AllocPolicy::FirstTouch;
+
+    table =
+      static_cast<Cluster*>(aligned_large_pages_alloc_with_policy(ttBytes, hugePageHint, policy));
 
     if (!table)
     {
@@ -186,10 +254,159 @@ void TranspositionTable::resize(usize mbSize, ThreadPool& threads) {
 }
 
 
+namespace {
+
+// Approximate new within-shard home for an entry found in cluster oldIdx of a
+// shard that had oldCount clusters. Only the low 16 key bits are stored while
+// the cluster index is derived from the full key, so the exact new index
+// cannot be recomputed; instead the key range mapping to oldIdx is folded
+// through its midpoint. When shrinking, that range falls almost entirely into
+// one new cluster and nearly every entry stays reachable. When growing, the
+// range stretches over ~newCount/oldCount clusters and the midpoint guess is
+// right for roughly its reciprocal share of the entries - still proportional
+// to the old table instead of losing everything.
+usize rehash_index(usize oldIdx, usize oldCount, usize newCount) {
+    const u64 quantum = ~u64(0) / oldCount;  // ~ 2^64 / oldCount
+    return usize(mul_hi64(quantum * oldIdx + quantum / 2, newCount));
+}
+
+}
+
+
+// Remaps the cluster array to the new size while preserving its contents
+// (returns false where the platform cannot, upon which the caller falls back
+// to a fresh table) and rehashes every surviving entry into the new geometry,
+// keeping the deeper, younger entry whenever a destination cluster overflows.
+//
+// Within a shard a cluster's destination index never crosses its source index
+// (growing scales indices up, shrinking scales them down), so sweeping the
+// sources toward the receding end - downward from the top when growing,
+// upward from the bottom when shrinking, with the shards ordered the same
+// way - lets the rehash run in place: destinations only ever overlap source
+// clusters that were already carried over. The same ordering constraint makes
+// the sweep inherently sequential, but at one cluster copy per step it is
+// still far cheaper than refilling the table through search.
+bool TranspositionTable::resize_in_place(usize newShardClusterCount) {
+
+    const usize oldSCC          = shardClusterCount;
+    const usize newSCC          = newShardClusterCount;
+    const usize newClusterCount = newSCC * shardCount;
+    const bool  growing         = newSCC > oldSCC;
+
+    // Cheap feature probe: a same-size remap is a no-op where remapping is
+    // supported and returns nullptr elsewhere, before any work is done.
+    if (aligned_large_pages_remap(table, clusterCount * sizeof(Cluster)) != table)
+        return false;
+
+    if (growing)
+    {
+        auto* remapped = static_cast<Cluster*>(
+          aligned_large_pages_remap(table, newClusterCount * sizeof(Cluster)));
+        if (!remapped)
+            return false;
+        table = remapped;
+    }
+
+    // Reinserts one surviving entry into its new home cluster, preferring
+    // the more valuable entry (deeper, then younger) when all slots are taken
+    auto insert = [this](Cluster& c, u16 key16, const TTEntry& e) {
+        int replaceIdx   = 0;
+        int replaceValue = std::numeric_limits<int>::max();
+
+        for (int i = 0; i < ClusterSize; ++i)
+        {
+            if (!c.entry[i].is_occupied())
+            {
+                replaceIdx   = i;
+                replaceValue = std::numeric_limits<int>::min();
+                break;
+            }
+            const int value = c.entry[i].depth8 - 8 * c.entry[i].relative_age(generation8);
+            if (value < replaceValue)
+            {
+                replaceValue = value;
+                replaceIdx   = i;
+            }
+        }
+
+        if (replaceValue >= e.depth8 - 8 * e.relative_age(generation8))
+            return;
+
+        c.key16[replaceIdx] = key16;
+        std::memcpy(static_cast<void*>(&c.entry[replaceIdx]), &e, sizeof(TTEntry));
+    };
+
+    // Resets a destination cluster before its first insertion
+    auto fresh = [this](Cluster& c) {
+        std::memset(static_cast<void*>(&c), 0, sizeof(Cluster));
+        c.epoch = epoch8;
+    };
+
+    for (usize n = 0; n < shardCount; ++n)
+    {
+        const usize    s   = growing ? shardCount - 1 - n : n;
+        Cluster* const src = table + s * oldSCC;
+        Cluster* const dst = table + s * newSCC;
+
+        // One-past frontier of destination clusters already reset, swept from
+        // the receding end so that each cluster is reset exactly once, after
+        // its old contents were carried over and before anything lands in it
+        usize frontier = growing ? newSCC : 0;
+
+        for (usize n2 = 0; n2 < oldSCC; ++n2)
+        {
+            const usize i = growing ? oldSCC - 1 - n2 : n2;
+
+            const Cluster c = src[i];
+
+            const usize d = rehash_index(i, oldSCC, newSCC);
+            assert(growing ? d >= i : d <= i);
+
+            if (growing)
+                while (frontier > d)
+                    fresh(dst[--frontier]);
+            else
+                while (frontier <= d)
+                    fresh(dst[frontier++]);
+
+            if (c.epoch != epoch8)  // from before the last soft clear
+                continue;
+
+            for (int j = 0; j < ClusterSize; ++j)
+                if (c.entry[j].is_occupied())
+                    insert(dst[d], c.key16[j], c.entry[j]);
+        }
+
+        if (growing)
+            while (frontier > 0)
+                fresh(dst[--frontier]);
+        else
+            while (frontier < newSCC)
+                fresh(dst[frontier++]);
+    }
+
+    if (!growing)
+    {
+        // Shrinking an existing mapping in place cannot fail or move it
+        auto* remapped = static_cast<Cluster*>(
+          aligned_large_pages_remap(table, newClusterCount * sizeof(Cluster)));
+        assert(remapped == table);
+        if (remapped)
+            table = remapped;
+    }
+
+    clusterCount      = newClusterCount;
+    shardClusterCount = newSCC;
+    sweepCursor       = clusterCount;  // the rehash stamped every cluster current
+    return true;
+}
+
+
 // Initializes the entire transposition table to zero,
 // in a multi-threaded way.
 void TranspositionTable::clear(ThreadPool& threads) {
     generation8             = 0;
+    epoch8                  = 0;
     const usize threadCount = threads.num_threads();
 
     std::vector<usize> threadToNuma = threads.get_bound_thread_to_numa_node();
@@ -198,7 +415,8 @@ void TranspositionTable::clear(ThreadPool& threads) {
     std::iota(order.begin(), order.end(), 0);
 
     // To promote good NUMA distribution (esp. with huge pages), we permute threads so that
-    // all threads in a NUMA node clear a contiguous region of the TT.
+    // all threads in a NUMA node clear a contiguous region of the TT. With sharding enabled
+    // this same first-touch pattern places each node's shard in node-local memory.
     if (threadToNuma.size() == threadCount)
     {
         std::stable_sort(order.begin(), order.end(), [&threadToNuma](usize t1, usize t2) {
@@ -220,6 +438,56 @@ void TranspositionTable::clear(ThreadPool& threads) {
 
     for (usize i = 0; i < threadCount; ++i)
         threads.wait_on_thread(i);
+
+    sweepCursor = clusterCount;  // everything is at the current epoch now
+}
+
+
+// Treats everything currently in the table as stale: probes see such
+// clusters as empty and reset them on first touch, so the cost of the
+// sweep is paid lazily by the search instead of up front. On epoch
+// wraparound surviving untouched clusters would alias the new epoch, so
+// once every 256 soft clears we do the real thing.
+void TranspositionTable::soft_clear(ThreadPool& threads) {
+    if (++epoch8 == 0)
+        clear(threads);
+    else
+    {
+        generation8 = 0;
+        sweepCursor = 0;  // the whole table is stale; see idle_sweep()
+    }
+}
+
+
+// Runs the sweep soft_clear() deferred, on donated idle cycles: every
+// cluster left at an old epoch is reset and stamped current, so the search
+// stops paying the lazy per-probe reset and the memory densifies back to
+// zero pages. Only ever called while the engine is idle, never concurrently
+// with a search, so plain stores suffice. The abort flag is polled between
+// chunks; the persistent cursor lets an interrupted sweep resume in the
+// next idle period instead of starting over.
+bool TranspositionTable::idle_sweep(const std::atomic_bool& abort) {
+
+    constexpr usize ChunkClusters = 4096;  // 256KiB between abort checks
+
+    while (sweepCursor < clusterCount)
+    {
+        if (abort)
+            return true;
+
+        const usize end = std::min(sweepCursor + ChunkClusters, clusterCount);
+        for (; sweepCursor < end; ++sweepCursor)
+        {
+            Cluster& c = table[sweepCursor];
+            if (c.epoch != epoch8)
+            {
+                std::memset(static_cast<void*>(&c), 0, sizeof(Cluster));
+                c.epoch = epoch8;
+            }
+        }
+    }
+
+    return false;
 }
 
 
@@ -228,15 +496,106 @@ void TranspositionTable::clear(ThreadPool& threads) {
 // Only counts entries which are younger than maxAge.
 int TranspositionTable::hashfull(int maxAge) const {
     int cnt = 0;
-    for (int i = 0; i < 1000; ++i)
+    for (usize i = 0; i < 1000; ++i)
+    {
+        // Spread the sample over all shards; with a single shard this is table[i]
+        const Cluster& cluster = table[i / shardCount + (i % shardCount) * shardClusterCount];
         for (int j = 0; j < ClusterSize; ++j)
-            cnt += table[i].entry[j].is_occupied()
-                && table[i].entry[j].relative_age(generation8) <= maxAge;
+            cnt += cluster.epoch == epoch8 && cluster.entry[j].is_occupied()
+                && cluster.entry[j].relative_age(generation8) <= maxAge;
+    }
 
     return cnt / ClusterSize;
 }
 
 
+void TranspositionTable::set_sharding(bool enabled) { sharded = enabled; }
+
+
+namespace {
+
+// Returns the index of the first key slot in the cluster matching key16, or -1.
+// With SSE2 all six packed keys are compared at once; the 16-byte load
+// intentionally overreads into entry[0], which stays in-struct, and the stray
+// comparison bits are masked off. Like every other TT access the load is racy.
+int find_slot(const Cluster* cluster, u16 key16) {
+#ifdef USE_SSE2
+    const __m128i keys = _mm_load_si128(reinterpret_cast<const __m128i*>(cluster->key16));
+    const int     mask =
+      _mm_movemask_epi8(_mm_cmpeq_epi16(keys, _mm_set1_epi16(i16(key16)))) & 0xFFF;
+    return mask ? int(lsb(Bitboard(mask))) / 2 : -1;
+#else
+    for (int i = 0; i < ClusterSize; ++i)
+        if (cluster->key16[i] == key16)
+            return i;
+    return -1;
+#endif
+}
+
+}
+
+
+// Snapshot file layout: a small geometry header followed by the raw cluster
+// array. Entries are racy-by-design anyway, so a byte-level copy is a valid
+// table state as long as the geometry matches.
+namespace {
+
+struct SnapshotHeader {
+    static constexpr u32 SNAPSHOT_MAGIC = 0x53465454;  // "SFTT"
+
+    u32   magic;
+    u32   clusterSize;
+    usize clusterCount;
+    usize shardCount;
+    u8    generation;
+    u8    epoch;
+};
+
+}
+
+bool TranspositionTable::save(const std::string& path) const {
+    std::ofstream stream(path, std::ios_base::binary);
+    if (!stream)
+        return false;
+
+    SnapshotHeader header{SnapshotHeader::SNAPSHOT_MAGIC, u32(sizeof(Cluster)), clusterCount,
+                          shardCount, generation8, epoch8};
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(table), clusterCount * sizeof(Cluster));
+
+    return bool(stream);
+}
+
+bool TranspositionTable::load(const std::string& path) {
+    std::ifstream stream(path, std::ios_base::binary);
+    if (!stream)
+        return false;
+
+    SnapshotHeader header;
+    stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    // Only accept snapshots of identical geometry; anything else would need
+    // rehashing every entry, at which point a cold start is just as fast.
+    if (!stream || header.magic != SnapshotHeader::SNAPSHOT_MAGIC
+        || header.clusterSize != sizeof(Cluster) || header.clusterCount != clusterCount
+        || header.shardCount != shardCount)
+        return false;
+
+    stream.read(reinterpret_cast<char*>(table), clusterCount * sizeof(Cluster));
+    if (!stream)
+        return false;
+
+    // Restore the snapshot's generation so entry ages stay relative to it;
+    // new_search() takes over the aging from here as usual. The snapshot may
+    // carry stale-epoch clusters, so hand them to the idle sweep.
+    generation8 = header.generation & GENERATION_MASK;
+    epoch8      = header.epoch;
+    sweepCursor = 0;
+    return true;
+}
+
+
 void TranspositionTable::new_search() {
     ++generation8;
     // Don't overflow into the other bits of TTEntry::genBound8
@@ -251,31 +610,72 @@ u8 TranspositionTable::generation() const { return generation8; }
 // It returns true if the key is found (which may be a collision), and has non-null data.
 // Otherwise, it returns false and a pointer to an empty or least valuable TTEntry
 // to be replaced later. The value of an entry is its depth minus 8 times its relative age.
-std::tuple<bool, TTData, TTWriter> TranspositionTable::probe(const Key key) const {
+std::tuple<bool, TTData, TTWriter> TranspositionTable::probe(const Key key, NumaIndex node) const {
 
-    TTEntry* const tte   = first_entry(key);
+    PROFILE_SCOPE(TTProbe);
+
+    Cluster* const cluster =
+      &table[(node % shardCount) * shardClusterCount + mul_hi64(key, shardClusterCount)];
+    TTEntry* const tte   = cluster->entry;
     const u16      key16 = u16(key);  // Use the low 16 bits as key inside the cluster
 
-    for (int i = 0; i < ClusterSize; ++i)
-        if (tte[i].key16 == key16)
-            // This gap is the main place for read races.
-            // After `read()` completes that copy is final, but may be self-inconsistent.
-            return {tte[i].is_occupied(), tte[i].read(), TTWriter(&tte[i])};
+    // A cluster from before the last soft clear holds only stale data, so
+    // reset it here and let the scans below see ordinary empty entries. The
+    // reset races with concurrent writers like any other TT store.
+    if (cluster->epoch != epoch8)
+    {
+        std::memset(static_cast<void*>(cluster), 0, sizeof(Cluster));
+        cluster->epoch = epoch8;
+    }
 
-    // Find an entry to be replaced according to the replacement strategy
-    TTEntry* replace = tte;
+    if (const int i = find_slot(cluster, key16); i >= 0)
+        // This gap is the main place for read races.
+        // After `read()` completes that copy is final, but may be self-inconsistent.
+        return {tte[i].is_occupied(), tte[i].read(), TTWriter(&tte[i], &cluster->key16[i])};
+
+    // On a node-local miss in sharded mode, fall back to the remote shards. Remote hits
+    // pay the interconnect latency but are much rarer than local ones; new data is still
+    // written to the remote entry so the position has a single home across shards.
+    if (shardCount > 1)
+        for (usize s = 0; s < shardCount; ++s)
+        {
+            if (s == node % shardCount)
+                continue;
+
+            Cluster& remoteCluster = table[s * shardClusterCount + mul_hi64(key, shardClusterCount)];
+
+            // Stale remote clusters count as empty; leave the reset to a
+            // probe from their own shard.
+            if (remoteCluster.epoch != epoch8)
+                continue;
+
+            TTEntry* const remote = remoteCluster.entry;
+            if (const int i = find_slot(&remoteCluster, key16); i >= 0 && remote[i].is_occupied())
+                return {true, remote[i].read(), TTWriter(&remote[i], &remoteCluster.key16[i])};
+        }
+
+    // Find an entry to be replaced according to the replacement strategy,
+    // always within the probing thread's local shard. The selection is written
+    // branchlessly (conditional moves) since at six entries a mispredicted
+    // compare chain costs more than the extra arithmetic.
+    int replaceIdx   = 0;
+    int replaceValue = tte[0].depth8 - 8 * tte[0].relative_age(generation8);
     for (int i = 1; i < ClusterSize; ++i)
-        if (replace->depth8 - 8 * replace->relative_age(generation8)
-            > tte[i].depth8 - 8 * tte[i].relative_age(generation8))
-            replace = &tte[i];
+    {
+        const int  value  = tte[i].depth8 - 8 * tte[i].relative_age(generation8);
+        const bool better = value < replaceValue;
+        replaceIdx        = better ? i : replaceIdx;
+        replaceValue      = better ? value : replaceValue;
+    }
 
     return {false, TTData{Move::none(), VALUE_NONE, VALUE_NONE, DEPTH_NONE, BOUND_NONE, false},
-            TTWriter(replace)};
+            TTWriter(&tte[replaceIdx], &cluster->key16[replaceIdx])};
 }
 
 
-TTEntry* TranspositionTable::first_entry(const Key key) const {
-    return &table[mul_hi64(key, clusterCount)].entry[0];
+TTEntry* TranspositionTable::first_entry(const Key key, NumaIndex node) const {
+    return &table[(node % shardCount) * shardClusterCount + mul_hi64(key, shardClusterCount)]
+              .entry[0];
 }
 
 }  // namespace Stockfish
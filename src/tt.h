@@ -19,10 +19,13 @@
 #ifndef TT_H_INCLUDED
 #define TT_H_INCLUDED
 
+#include <atomic>
+#include <string>
 #include <tuple>
 
 #include "misc.h"
 #include "memory.h"
+#include "numa.h"
 #include "types.h"
 
 namespace Stockfish {
@@ -71,8 +74,9 @@ struct TTWriter {
 
    private:
     friend class TranspositionTable;
-    TTEntry* entry;
-    TTWriter(TTEntry* tte);
+    TTEntry*            entry;
+    RelaxedAtomic<u16>* key;
+    TTWriter(TTEntry* tte, RelaxedAtomic<u16>* k);
 };
 
 
@@ -81,8 +85,31 @@ class TranspositionTable {
    public:
     ~TranspositionTable() { aligned_large_pages_free(table); }
 
-    void resize(usize mbSize, ThreadPool& threads);  // Set TT size in MiB
-    void clear(ThreadPool& threads);                 // Re-initialize memory, multithreaded
+    // Set TT size in MiB. When a table already exists and only its size
+    // changes, it is remapped in place and the entries are rehashed into the
+    // new geometry, so a mid-session Hash change keeps the accumulated state.
+    void resize(usize mbSize, ThreadPool& threads);
+    void clear(ThreadPool& threads);  // Re-initialize memory, multithreaded
+
+    // Epoch-based soft clear: bumps the table epoch so existing entries are
+    // treated as empty on probe and lazily overwritten, making ucinewgame
+    // O(1) instead of a full memory sweep. Falls back to the parallel hard
+    // clear when the epoch counter wraps around.
+    void soft_clear(ThreadPool& threads);
+
+    // The sweep a soft_clear() deferred, run on donated idle cycles (see
+    // Worker::idle_maintenance()): eagerly resets the clusters the last
+    // soft_clear() left stale, so probes stop paying the lazy reset. The
+    // cursor persists across calls, so an interrupted sweep resumes in the
+    // next idle period; returns true while work remains.
+    bool idle_sweep(const std::atomic_bool& abort);
+
+    // Persist the table to a snapshot file / restore it after a process
+    // restart. The snapshot records the table geometry and the current
+    // generation, so restored entries keep their relative ages; loading
+    // requires a table of identical geometry (same Hash size and sharding).
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
 
     void
     new_search();  // This must be called at the beginning of each root search to track entry aging
@@ -90,21 +117,45 @@ class TranspositionTable {
     // Approximate what fraction of entries (permille) have been written to during this root search
     int hashfull(int maxAge = 0) const;
 
+    // Opt-in NUMA sharding: partition the cluster array into one shard per NUMA
+    // node, so that a worker writes to (and usually reads from) node-local memory.
+    // Takes effect on the next resize().
+    void set_sharding(bool enabled);
+
     // `probe` is the primary method: given a board position, we lookup its entry in the table, and return a tuple of:
     //   1) whether the entry already had data on this position
     //   2) a copy of the prior data, if any (may be self-inconsistent due to read races)
     //   3) a writer object to the entry
-    std::tuple<bool, TTData, TTWriter> probe(const Key key) const;
+    // `node` is the NUMA node of the probing thread; with sharding disabled it is ignored,
+    // and callers without NUMA context (e.g. prefetches from Position) default to node 0.
+    std::tuple<bool, TTData, TTWriter> probe(const Key key, NumaIndex node = 0) const;
     // The hash function; its only external use is memory prefetching
-    TTEntry* first_entry(const Key key) const;
+    TTEntry* first_entry(const Key key, NumaIndex node = 0) const;
 
    private:
     friend struct TTEntry;
 
+    // Entry-preserving remap-and-rehash used by resize(), see tt.cpp
+    bool resize_in_place(usize newShardClusterCount);
+
     usize    clusterCount;
     Cluster* table = nullptr;
 
+    // With sharding disabled there is a single shard covering the whole table,
+    // so shardClusterCount == clusterCount and all routing below is a no-op.
+    bool  sharded           = false;
+    usize shardCount        = 1;
+    usize shardClusterCount = 0;
+
     u8 generation8 = 0;
+
+    // Clusters whose epoch differs from this are from before the last
+    // soft_clear() and count as empty; see the epoch byte in Cluster.
+    u8 epoch8 = 0;
+
+    // One-past the last cluster idle_sweep() has brought to the current
+    // epoch; clusterCount when no sweep is pending.
+    usize sweepCursor = 0;
 };
 
 }  // namespace Stockfish
@@ -87,6 +87,29 @@ string Tune::next(string& names, bool pop) {
 }
 
 
+std::vector<Tune::Parameter> Tune::parameters() {
+
+    std::vector<Parameter> params;
+
+    for (auto& e : instance().list)
+        if (auto* entry = dynamic_cast<Entry<int>*>(e.get()))
+        {
+            // Same filter as make_option(): min == max means nothing to tune
+            const Range r = entry->range(entry->value);
+            if (r.first != r.second)
+                params.push_back({entry->name, &entry->value, r});
+        }
+
+    return params;
+}
+
+void Tune::run_post_updates() {
+
+    for (auto& e : instance().list)
+        if (auto* entry = dynamic_cast<Entry<PostUpdate>*>(e.get()))
+            entry->value();
+}
+
 template<>
 void Tune::Entry<int>::init_option() {
     make_option(options, name, value, range);
@@ -151,6 +151,19 @@ class Tune {
     std::vector<std::unique_ptr<EntryBase>> list;
 
    public:
+    // One registered int parameter, exposed to the in-process SPSA harness
+    // (the 'spsa' command). The pointer refers to the live engine variable;
+    // writes through it take effect on the next search, but bypass the UCI
+    // option and any post-update function, so run_post_updates() afterwards.
+    struct Parameter {
+        std::string name;
+        int*        value;
+        Range       range;
+    };
+
+    static std::vector<Parameter> parameters();
+    static void                   run_post_updates();
+
     template<typename... Args>
     static int add(const std::string& names, Args&&... args) {
         return instance().add(SetDefaultRange, names.substr(1, names.size() - 2),
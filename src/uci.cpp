@@ -19,10 +19,13 @@
 #include "uci.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cmath>
 #include <cstdlib>
+#include <fstream>
 #include <iterator>
+#include <map>
 #include <optional>
 #include <sstream>
 #include <string_view>
@@ -32,10 +35,15 @@
 #include "benchmark.h"
 #include "engine.h"
 #include "memory.h"
+#include "microbench.h"
 #include "movegen.h"
+#include "nnue/nnue_compress.h"
 #include "position.h"
+#include "profile.h"
 #include "score.h"
 #include "search.h"
+#include "selfplay.h"
+#include "spsa.h"
 #include "types.h"
 #include "ucioption.h"
 
@@ -143,12 +151,105 @@ void UCIEngine::loop() {
             bench(is);
         else if (token == BenchmarkCommand)
             benchmark(is);
+        else if (token == "benchrun")
+            benchrun(is);
+        else if (token == "microbench")
+            Microbench::run(is);
+        else if (token == "replaysched")
+            replaysched(is);
+        else if (token == "session")
+            session(is);
+        else if (token == "selfplay")
+            selfplay(is);
+        else if (token == "spsa")
+            spsa(is);
         else if (token == "d")
             sync_cout << engine.visualize() << sync_endl;
         else if (token == "eval")
             engine.trace_eval();
+        else if (token == "scorefens")
+            scorefens(is);
         else if (token == "compiler")
             sync_cout << compiler_info() << sync_endl;
+        else if (token == "profile")
+        {
+            std::string sub;
+            is >> sub;
+
+            if (sub == "clear")
+                Profile::clear();
+            else
+                sync_cout << Profile::dump() << sync_endl;
+        }
+        else if (token == "savehash" || token == "loadhash")
+        {
+            std::string file;
+            is >> file;
+
+            if (file.empty())
+                sync_cout << "Usage: " << token << " <file>" << sync_endl;
+            else
+            {
+                bool ok = token == "savehash" ? engine.save_hash(file) : engine.load_hash(file);
+                sync_cout << (ok ? "Hash snapshot " + file + (token == "savehash" ? " saved" : " loaded")
+                                 : "Failed to " + token.substr(0, 4) + " hash snapshot " + file
+                                     + " (missing file or mismatched Hash size?)")
+                          << sync_endl;
+            }
+        }
+        else if (token == "savesearch" || token == "loadsearch")
+        {
+            std::string file;
+            is >> file;
+
+            if (file.empty())
+                sync_cout << "Usage: " << token << " <file>" << sync_endl;
+            else
+            {
+                bool ok = token == "savesearch" ? engine.save_search_state(file)
+                                                : engine.load_search_state(file);
+                sync_cout << (ok ? "Search snapshot " + file
+                                     + (token == "savesearch" ? " saved" : " loaded")
+                                 : "Failed to " + token.substr(0, 4) + " search snapshot " + file
+                                     + " (missing file or mismatched Threads setting?)")
+                          << sync_endl;
+            }
+        }
+        else if (token == "activethreads")
+        {
+            // Unlike setoption this does not wait for the search, so a
+            // co-tenancy supervisor can park and unpark helpers mid-search.
+            std::string arg;
+            is >> arg;
+
+            if (arg.empty())
+                sync_cout << "Active threads: " << engine.active_threads() << " of "
+                          << engine.num_threads() << sync_endl;
+            else
+            {
+                usize n = arg == "all" ? 0 : usize(std::max(std::atoi(arg.c_str()), 0));
+                engine.set_active_threads(n);
+                sync_cout << "Active threads set to " << engine.active_threads() << " of "
+                          << engine.num_threads() << sync_endl;
+            }
+        }
+        else if (token == "compressnet")
+        {
+            std::string in, out;
+
+            if (!(is >> in))
+                sync_cout << "Usage: compressnet <input.nnue> [output]" << sync_endl;
+            else
+            {
+                if (!(is >> out))
+                    out = in + ".sfnc";
+
+                sync_cout << (Eval::NNUE::Compress::compress_file(in, out)
+                                ? "Compressed network written to " + out
+                                : "Failed to compress " + in)
+                          << sync_endl;
+            }
+        }
         else if (token == "export_net")
         {
             std::pair<std::optional<std::string>, std::string> file;
@@ -223,6 +324,36 @@ void UCIEngine::go(std::istringstream& is) {
         engine.go(limits);
 }
 
+// 'scorefens <file>' statically evaluates every FEN in the given file (one per
+// line, '-' for stdin) and prints one score per line, in input order. This is
+// the bulk counterpart of 'eval' for dataset-scoring workloads, skipping the
+// per-position UCI round-trip.
+void UCIEngine::scorefens(std::istream& args) {
+    std::string fname;
+    args >> fname;
+
+    if (fname.empty())
+    {
+        sync_cout << "Usage: scorefens <file>" << sync_endl;
+        return;
+    }
+
+    if (fname == "-")
+    {
+        engine.evaluate_fens(std::cin, std::cout);
+        return;
+    }
+
+    std::ifstream file(fname);
+    if (!file)
+    {
+        sync_cout << "Unable to open file: " << fname << sync_endl;
+        return;
+    }
+
+    engine.evaluate_fens(file, std::cout);
+}
+
 void UCIEngine::bench(std::istream& args) {
     std::string token;
     u64         num, nodes = 0, cnt = 1;
@@ -450,6 +581,284 @@ void UCIEngine::benchmark(std::istream& args) {
     init_search_update_listeners();
 }
 
+void UCIEngine::benchrun(std::istream& args) {
+    std::string token;
+    u64         nodesSearched = 0;
+
+    engine.set_on_update_full([&](const Engine::InfoFull& i) { nodesSearched = i.nodes; });
+
+    engine.set_on_iter([](const auto&) {});
+    engine.set_on_update_no_moves([](const auto&) {});
+    engine.set_on_bestmove([](const auto&, const auto&) {});
+    engine.set_on_verify_network([](const auto&) {});
+
+    Benchmark::BenchRunSetup setup = Benchmark::setup_benchrun(args);
+
+    const auto numGoCommands = count_if(setup.commands.begin(), setup.commands.end(),
+                                        [](const std::string& s) { return s.find("go ") == 0; });
+
+    auto mean = [](const std::vector<double>& v) {
+        double sum = 0;
+        for (double x : v)
+            sum += x;
+        return sum / double(v.size());
+    };
+
+    // Sample standard deviation, so single-repeat runs report 0
+    auto stddev = [&](const std::vector<double>& v) {
+        if (v.size() < 2)
+            return 0.0;
+        double m = mean(v), sum = 0;
+        for (double x : v)
+            sum += (x - m) * (x - m);
+        return std::sqrt(sum / double(v.size() - 1));
+    };
+
+    // One pass over the command list, returning searched nodes and elapsed
+    // search time. The warmup pass uses it as well, to fault in the TT and
+    // per-thread tables and let the OS settle thread placement before
+    // anything is measured.
+    auto runPass = [&](u64& nodes) {
+        TimePoint searchTime = 0;
+
+        for (const auto& cmd : setup.commands)
+        {
+            std::istringstream is(cmd);
+            is >> token;
+
+            if (token == "go")
+            {
+                Search::LimitsType limits = parse_limits(is);
+
+                nodesSearched     = 0;
+                TimePoint elapsed = now();
+
+                engine.go(limits);
+                engine.wait_for_search_finished();
+
+                searchTime += now() - elapsed;
+                nodes += nodesSearched;
+            }
+            else if (token == "setoption")
+                setoption(is);
+            else if (token == "position")
+                position(is);
+        }
+
+        return std::max<TimePoint>(searchTime, 1);
+    };
+
+    sync_cout << "benchrun invocation=" << setup.filledInvocation
+              << " positions=" << numGoCommands << sync_endl;
+
+    for (int threads : setup.threadCounts)
+        for (int ttSize : setup.ttSizes)
+        {
+            auto ss = std::istringstream("name Threads value " + std::to_string(threads));
+            setoption(ss);
+            ss = std::istringstream("name Hash value " + std::to_string(ttSize));
+            setoption(ss);
+
+            std::cerr << "Config threads=" << threads << " hash=" << ttSize << " warmup"
+                      << std::endl;
+
+            engine.search_clear();
+            u64 warmupNodes = 0;
+            runPass(warmupNodes);
+
+            std::vector<double> npsSamples, ttdSamples, hashfullSamples;
+
+            for (int rep = 1; rep <= setup.repeats; ++rep)
+            {
+                std::cerr << "Config threads=" << threads << " hash=" << ttSize << " repeat "
+                          << rep << '/' << setup.repeats << std::endl;
+
+                // Clearing between repeats makes them independent, so the
+                // spread below is run-to-run noise, not TT warming.
+                engine.search_clear();
+
+                u64       nodes      = 0;
+                TimePoint searchTime = runPass(nodes);
+
+                npsSamples.push_back(1000.0 * double(nodes) / double(searchTime));
+                ttdSamples.push_back(double(searchTime) / double(numGoCommands));
+                hashfullSamples.push_back(double(engine.get_hashfull()));
+            }
+
+            // One machine-readable line per configuration. Time-to-depth is
+            // the average per-position search time at the requested depth.
+            sync_cout << "benchrun-result"                            //
+                      << " threads=" << threads                       //
+                      << " hash=" << ttSize                           //
+                      << " depth=" << setup.depth                     //
+                      << " repeats=" << setup.repeats                 //
+                      << " nps_mean=" << u64(mean(npsSamples))        //
+                      << " nps_stddev=" << u64(stddev(npsSamples))    //
+                      << " ttd_ms_mean=" << mean(ttdSamples)          //
+                      << " ttd_ms_stddev=" << stddev(ttdSamples)      //
+                      << " hashfull_mean=" << u64(mean(hashfullSamples)) << sync_endl;
+        }
+
+    init_search_update_listeners();
+}
+
+// Re-executes a node schedule recorded through the NodeScheduleFile option
+// (see Search::NodeScheduleRecorder). For every recorded search the engine is
+// reset to the recorded root position with a cleared TT and a single-threaded
+// fixed-depth search up to the deepest recorded iteration is run; the
+// replayed per-depth node counts are printed next to the main thread's
+// recorded ones. A single-threaded recording replays to identical counts, so
+// regressions bisect offline; for a multithreaded recording the deltas show
+// how far the Lazy SMP run diverged from the deterministic baseline.
+void UCIEngine::replaysched(std::istream& args) {
+
+    std::string fname;
+    args >> fname;
+
+    std::ifstream f(fname);
+    if (!f)
+    {
+        sync_cout << "info string Could not open " << fname << sync_endl;
+        return;
+    }
+
+    // Silence the search output, keeping only the per-iteration node counts
+    std::map<int, u64> replayedNodes;
+    engine.set_on_update_full(
+      [&](const Engine::InfoFull& i) { replayedNodes[i.depth] = i.nodes; });
+    engine.set_on_iter([](const auto&) {});
+    engine.set_on_update_no_moves([](const auto&) {});
+    engine.set_on_bestmove([](const auto&, const auto&) {});
+
+    // The replay itself must be single-threaded to be deterministic; the
+    // previous setting is restored once the whole file has been replayed
+    const int prevThreads = int(engine.get_options()["Threads"]);
+
+    auto ss = std::istringstream("name Threads value 1");
+    setoption(ss);
+
+    struct Recorded {
+        int         depth;
+        u64         nodes;
+        std::string move;
+    };
+    std::string           line, fen;
+    std::vector<Recorded> mainThreadEntries;
+
+    auto replayBlock = [&]() {
+        if (fen.empty() || mainThreadEntries.empty())
+            return;
+
+        engine.set_position(fen, {});
+        engine.search_clear(true);
+        replayedNodes.clear();
+
+        Search::LimitsType limits;
+        limits.depth = mainThreadEntries.back().depth;
+        engine.go(limits);
+        engine.wait_for_search_finished();
+
+        sync_cout << "replaysched fen " << fen << sync_endl;
+        for (const Recorded& r : mainThreadEntries)
+        {
+            const auto it       = replayedNodes.find(r.depth);
+            const u64  replayed = it == replayedNodes.end() ? 0 : it->second;
+            sync_cout << "replaysched depth=" << r.depth << " nodes=" << replayed
+                      << " recorded=" << r.nodes << " move=" << r.move
+                      << (replayed == r.nodes ? " match" : " diff") << sync_endl;
+        }
+
+        mainThreadEntries.clear();
+    };
+
+    while (std::getline(f, line))
+    {
+        std::istringstream ls(line);
+        std::string        token;
+        ls >> token;
+
+        if (token == "search")
+        {
+            replayBlock();
+            std::getline(ls >> std::ws, fen);
+            continue;
+        }
+
+        usize              threadId = 0;
+        std::istringstream ts(token);
+        ts >> threadId;
+
+        Recorded r;
+        if ((ls >> r.depth >> r.nodes >> r.move) && threadId == 0)
+            mainThreadEntries.push_back(r);
+    }
+    replayBlock();
+
+    ss = std::istringstream("name Threads value " + std::to_string(prevThreads));
+    setoption(ss);
+
+    init_search_update_listeners();
+}
+
+// Multiplexes several concurrent analyses over this engine's threads and TT;
+// see SessionManager in session.h for the subcommands and output format.
+void UCIEngine::session(std::istream& args) {
+
+    if (!sessionManager)
+        sessionManager = std::make_unique<SessionManager>(engine);
+
+    // The manager holds the update listeners while it exists; 'session clear'
+    // hands the engine back to the normal UCI flow
+    if (!sessionManager->command(args))
+    {
+        sessionManager.reset();
+        init_search_update_listeners();
+    }
+}
+
+// Plays an engine-vs-engine match inside this process; see selfplay.h for
+// the accepted parameters. The opponent is a second Engine instance with its
+// own threads and transposition table, but the network weights are shared
+// through the usual system-wide content-addressed replication, so the match
+// costs one copy of the net, not two.
+void UCIEngine::selfplay(std::istream& args) {
+
+    Selfplay::Config config = Selfplay::parse(args);
+
+    Engine second(std::string(cli.argv[0]));
+    for (const char* name : {"Threads", "Hash"})
+    {
+        std::istringstream ss("name " + std::string(name) + " value "
+                              + std::string(engine.get_options()[name]));
+        second.get_options().setoption(ss);
+    }
+
+    Selfplay::run(engine, second, config);
+
+    init_search_update_listeners();
+}
+
+// Runs an in-process SPSA tuning session over the registered TUNE()
+// parameters; see spsa.h for the accepted parameters. The games reuse the
+// selfplay harness and the same second-engine setup as above, so the whole
+// session shares one copy of the net and needs no external orchestration.
+void UCIEngine::spsa(std::istream& args) {
+
+    Spsa::Config config = Spsa::parse(args);
+
+    Engine second(std::string(cli.argv[0]));
+    for (const char* name : {"Threads", "Hash"})
+    {
+        std::istringstream ss("name " + std::string(name) + " value "
+                              + std::string(engine.get_options()[name]));
+        second.get_options().setoption(ss);
+    }
+
+    Spsa::run(engine, second, config);
+
+    init_search_update_listeners();
+}
+
 void UCIEngine::setoption(std::istringstream& is) {
     engine.wait_for_search_finished();
     engine.get_options().setoption(is);
@@ -462,73 +871,104 @@ u64 UCIEngine::perft(const Search::LimitsType& limits) {
 }
 
 void UCIEngine::position(std::istringstream& is) {
-    const std::string fullCommand = is.str();
-
-    std::string token, fen;
+    // This is by far the hottest command under a supervisor, which can send
+    // thousands of position updates per second. Tokenize with string_views
+    // over a reused copy of the command (str() returns by value in C++17)
+    // and recycle the parsed FEN and move list, all of which keep their
+    // capacity between calls, so a steady stream of commands parses without
+    // allocating.
+    parsedCommand = is.str();
+    std::string_view args(parsedCommand);
+    args.remove_prefix(std::min(usize(std::max<std::streamoff>(is.tellg(), 0)), args.size()));
+
+    auto next_token = [&args]() {
+        const usize begin = std::min(args.find_first_not_of(' '), args.size());
+        const usize end   = std::min(args.find(' ', begin), args.size());
+
+        std::string_view token = args.substr(begin, end - begin);
+        args.remove_prefix(end);
+        return token;
+    };
 
-    is >> token;
+    std::string_view token = next_token();
 
     if (token == "startpos")
     {
-        fen = StartFEN;
-        is >> token;  // Consume the "moves" token, if any
+        parsedFen = StartFEN;
+        next_token();  // Consume the "moves" token, if any
     }
     else if (token == "fen")
-        while (is >> token && token != "moves")
-            fen += token + " ";
+    {
+        parsedFen.clear();
+        while (!(token = next_token()).empty() && token != "moves")
+        {
+            parsedFen += token;
+            parsedFen += ' ';
+        }
+    }
     else
         return;
 
-    std::vector<std::string> moves;
-
-    while (is >> token)
+    usize moveCount = 0;
+    while (!(token = next_token()).empty())
     {
-        moves.push_back(token);
+        if (moveCount < parsedMoves.size())
+            parsedMoves[moveCount].assign(token.data(), token.size());
+        else
+            parsedMoves.emplace_back(token);
+        ++moveCount;
     }
+    parsedMoves.resize(moveCount);
 
-    auto err = engine.set_position(fen, moves);
+    auto err = engine.set_position(parsedFen, parsedMoves);
     if (err.has_value())
     {
-        terminate_on_critical_error(fullCommand, err->what());
+        terminate_on_critical_error(parsedCommand, err->what());
     }
 }
 
 namespace {
 
-struct WinRateParams {
-    double a;
-    double b;
-};
-
-WinRateParams win_rate_params(const Position& pos) {
+// The fitted model only uses data for material counts in [17, 78], and is
+// anchored at count 58; 78 is the count of the initial position and the
+// maximum without promotions. Evaluating the polynomials per conversion is
+// wasteful on the info-emission path, so bake the whole family of curves
+// into a table indexed by the (clamped) material count.
+constexpr auto WinRateTable = []() {
+    std::array<WinRateParams, 79> table{};
 
-    int material = pos.count<PAWN>() + 3 * pos.count<KNIGHT>() + 3 * pos.count<BISHOP>()
-                 + 5 * pos.count<ROOK>() + 9 * pos.count<QUEEN>();
-
-    // The fitted model only uses data for material counts in [17, 78], and is anchored at count 58.
-    double m = std::clamp(material, 17, 78) / 58.0;
-
-    // Return a = p_a(material) and b = p_b(material), see github.com/official-stockfish/WDL_model
+    // a = p_a(material) and b = p_b(material), see github.com/official-stockfish/WDL_model
     constexpr double as[] = {-72.32565836, 185.93832038, -144.58862193, 416.44950446};
     constexpr double bs[] = {83.86794042, -136.06112997, 69.98820887, 47.62901433};
 
-    double a = (((as[0] * m + as[1]) * m + as[2]) * m) + as[3];
-    double b = (((bs[0] * m + bs[1]) * m + bs[2]) * m) + bs[3];
+    for (int material = 0; material < int(table.size()); ++material)
+    {
+        double m = std::clamp(material, 17, 78) / 58.0;
 
-    return {a, b};
-}
+        table[usize(material)] = {(((as[0] * m + as[1]) * m + as[2]) * m) + as[3],
+                                  (((bs[0] * m + bs[1]) * m + bs[2]) * m) + bs[3]};
+    }
+
+    return table;
+}();
 
 // The win rate model is 1 / (1 + exp((a - eval) / b)), where a = p_a(material) and b = p_b(material).
 // It fits the LTC fishtest statistics rather accurately.
-int win_rate_model(Value v, const Position& pos) {
-
-    auto [a, b] = win_rate_params(pos);
+int win_rate_model(Value v, const WinRateParams& params) {
 
     // Return the win rate in per mille units, rounded to the nearest integer.
-    return int(0.5 + 1000 / (1 + std::exp((a - double(v)) / b)));
+    return int(0.5 + 1000 / (1 + std::exp((params.a - double(v)) / params.b)));
 }
 }
 
+WinRateParams UCIEngine::win_rate_params(const Position& pos) {
+
+    int material = pos.count<PAWN>() + 3 * pos.count<KNIGHT>() + 3 * pos.count<BISHOP>()
+                 + 5 * pos.count<ROOK>() + 9 * pos.count<QUEEN>();
+
+    return WinRateTable[usize(std::min(material, 78))];
+}
+
 std::string UCIEngine::format_score(const Score& s) {
     constexpr int TB_CP = 20000;
     const auto    format =
@@ -548,22 +988,24 @@ std::string UCIEngine::format_score(const Score& s) {
 
 // Turns a Value to an integer centipawn number,
 // without treatment of mate and similar special scores.
-int UCIEngine::to_cp(Value v, const Position& pos) {
+int UCIEngine::to_cp(Value v, const Position& pos) { return to_cp(v, win_rate_params(pos)); }
+
+int UCIEngine::to_cp(Value v, const WinRateParams& params) {
 
     // In general, the score can be defined via the WDL as
     // (log(1/L - 1) - log(1/W - 1)) / (log(1/L - 1) + log(1/W - 1)).
     // Based on our win_rate_model, this simply yields v / a.
 
-    auto [a, b] = win_rate_params(pos);
-
-    return int(std::round(100 * int(v) / a));
+    return int(std::round(100 * int(v) / params.a));
 }
 
-std::string UCIEngine::wdl(Value v, const Position& pos) {
+std::string UCIEngine::wdl(Value v, const Position& pos) { return wdl(v, win_rate_params(pos)); }
+
+std::string UCIEngine::wdl(Value v, const WinRateParams& params) {
     std::stringstream ss;
 
-    int wdl_w = win_rate_model(v, pos);
-    int wdl_l = win_rate_model(-v, pos);
+    int wdl_w = win_rate_model(v, params);
+    int wdl_l = win_rate_model(-v, params);
     int wdl_d = 1000 - wdl_w - wdl_l;
     ss << wdl_w << " " << wdl_d << " " << wdl_l;
 
@@ -613,7 +1055,11 @@ Move UCIEngine::to_move(const Position& pos, std::string str) {
 }
 
 void UCIEngine::on_update_no_moves(const Engine::InfoShort& info) {
-    sync_cout << "info depth " << info.depth << " score " << format_score(info.score) << sync_endl;
+    std::stringstream ss;
+
+    ss << "info depth " << info.depth << " score " << format_score(info.score);
+
+    AsyncOutput::enqueue(ss.str());
 }
 
 void UCIEngine::on_update_full(const Engine::InfoFull& info, bool showWDL) {
@@ -638,7 +1084,7 @@ void UCIEngine::on_update_full(const Engine::InfoFull& info, bool showWDL) {
        << " time " << info.timeMs        //
        << " pv " << info.pv;             //
 
-    sync_cout << ss.str() << sync_endl;
+    AsyncOutput::enqueue(ss.str());
 }
 
 void UCIEngine::on_iter(const Engine::InfoIter& info) {
@@ -649,14 +1095,21 @@ void UCIEngine::on_iter(const Engine::InfoIter& info) {
        << " currmove " << info.currmove               //
        << " currmovenumber " << info.currmovenumber;  //
 
-    sync_cout << ss.str() << sync_endl;
+    AsyncOutput::enqueue(ss.str());
 }
 
 void UCIEngine::on_bestmove(std::string_view bestmove, std::string_view ponder) {
-    sync_cout << "bestmove " << bestmove;
+    std::string line = "bestmove ";
+    line += bestmove;
     if (!ponder.empty())
-        std::cout << " ponder " << ponder;
-    std::cout << sync_endl;
+    {
+        line += " ponder ";
+        line += ponder;
+    }
+
+    // Through the same queue as the info lines, so that the bestmove is
+    // guaranteed to reach stdout after every update of the final iteration.
+    AsyncOutput::enqueue(std::move(line));
 }
 
 void UCIEngine::terminate_on_critical_error(const std::string& fullCommand,
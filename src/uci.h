@@ -20,12 +20,15 @@
 #define UCI_H_INCLUDED
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "engine.h"
 #include "misc.h"
 #include "search.h"
+#include "session.h"
 
 namespace Stockfish {
 
@@ -37,17 +40,29 @@ using Value = int;
 
 constexpr auto StartFEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
 
+// Per-material-count parameters of the WDL model, precomputed at compile time
+// (see the table in uci.cpp). Callers converting many scores for one position,
+// like SearchManager::pv with MultiPV, fetch the parameters once and use the
+// batch overloads below.
+struct WinRateParams {
+    double a;
+    double b;
+};
+
 class UCIEngine {
    public:
     UCIEngine(int argc, char** argv);
 
     void loop();
 
-    static int         to_cp(Value v, const Position& pos);
-    static std::string format_score(const Score& s);
-    static std::string square(Square s);
-    static std::string move(Move m, bool chess960 = false);
-    static std::string wdl(Value v, const Position& pos);
+    static WinRateParams win_rate_params(const Position& pos);
+    static int           to_cp(Value v, const Position& pos);
+    static int           to_cp(Value v, const WinRateParams& params);
+    static std::string   format_score(const Score& s);
+    static std::string   square(Square s);
+    static std::string   move(Move m, bool chess960 = false);
+    static std::string   wdl(Value v, const Position& pos);
+    static std::string   wdl(Value v, const WinRateParams& params);
     static std::string to_lower(std::string str);
     static Move        to_move(const Position& pos, std::string str);
 
@@ -59,11 +74,27 @@ class UCIEngine {
     Engine      engine;
     CommandLine cli;
 
+    // Present only between the first 'session' command and 'session clear';
+    // destroyed before engine so its listeners cannot outlive it
+    std::unique_ptr<SessionManager> sessionManager;
+
+    // Reused by position() so a steady stream of position commands parses
+    // without allocating; see the comment there.
+    std::string              parsedCommand;
+    std::string              parsedFen;
+    std::vector<std::string> parsedMoves;
+
     static void print_info_string(std::string_view str);
 
     void go(std::istringstream& is);
+    void scorefens(std::istream& args);
     void bench(std::istream& args);
     void benchmark(std::istream& args);
+    void benchrun(std::istream& args);
+    void replaysched(std::istream& args);
+    void session(std::istream& args);
+    void selfplay(std::istream& args);
+    void spsa(std::istream& args);
     void position(std::istringstream& is);
     void setoption(std::istringstream& is);
     u64  perft(const Search::LimitsType&);
@@ -22,9 +22,19 @@
     #include <windows.h>
 #else
     #include <sys/auxv.h>
+    #include <sys/prctl.h>
     #ifndef HWCAP_ASIMDDP
         #define HWCAP_ASIMDDP (1 << 20)
     #endif
+    #ifndef HWCAP2_SVE2
+        #define HWCAP2_SVE2 (1 << 1)
+    #endif
+    #ifndef PR_SVE_GET_VL
+        #define PR_SVE_GET_VL 51
+    #endif
+    #ifndef PR_SVE_VL_LEN_MASK
+        #define PR_SVE_VL_LEN_MASK 0xffff
+    #endif
 #endif
 
 #define DEFINE_BUILD(x) \
@@ -42,21 +52,36 @@
 
 DEFINE_BUILD(armv8)
 DEFINE_BUILD(armv8_dotprod)
+DEFINE_BUILD(armv8_sve2)
 
 struct CpuFeatures {
     bool dotprod;
+    bool sve2_vl256;
 };
 
 
 static CpuFeatures query_cpu_features() {
 #if defined(_WIN32)
     return {
-      .dotprod = (bool) IsProcessorFeaturePresent(PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE),
+      .dotprod    = (bool) IsProcessorFeaturePresent(PF_ARM_V82_DP_INSTRUCTIONS_AVAILABLE),
+      .sve2_vl256 = false,
     };
 #else
-    unsigned long hwcap = getauxval(AT_HWCAP);
+    unsigned long hwcap  = getauxval(AT_HWCAP);
+    unsigned long hwcap2 = getauxval(AT_HWCAP2);
+
+    // The SVE2 slice is compiled with -msve-vector-bits=256, so it is only
+    // usable when the vector length the kernel hands us is exactly 256 bits
+    bool sve2_vl256 = false;
+    if (hwcap2 & HWCAP2_SVE2)
+    {
+        int vl     = prctl(PR_SVE_GET_VL);
+        sve2_vl256 = vl > 0 && (vl & PR_SVE_VL_LEN_MASK) == 32;
+    }
+
     return {
-      .dotprod = (bool) (hwcap & HWCAP_ASIMDDP),
+      .dotprod    = (bool) (hwcap & HWCAP_ASIMDDP),
+      .sve2_vl256 = sve2_vl256,
     };
 #endif
 }
@@ -64,6 +89,9 @@ static CpuFeatures query_cpu_features() {
 
 // Selects the most capable ISA variant supported by this CPU and OS
 static int dispatch(const CpuFeatures& f, int argc, char* argv[]) {
+    if (f.sve2_vl256)
+        return entry_armv8_sve2(argc, argv);
+
     if (!f.dotprod)
         return entry_armv8(argc, argv);
 
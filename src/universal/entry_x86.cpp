@@ -67,10 +67,54 @@ DEFINE_BUILD(x86_64_avx512)
 DEFINE_BUILD(x86_64_vnni512)
 DEFINE_BUILD(x86_64_avx512icl)
 
+// Times a dependent chain of either pext or imul instructions, returning the
+// elapsed TSC ticks. The mask popcount is fixed, so microcoded pext runs at a
+// constant (large) per-instruction cost. Inline asm is used because this
+// translation unit is compiled for the baseline arch, without -mbmi2.
+static uint64_t chain_ticks(bool usePext) {
+    constexpr int  Iters = 256;
+    const uint64_t mask  = 0x5555555555555555ULL;
+    uint64_t       acc   = ~uint64_t(0);
+
+    asm volatile("lfence");
+    uint64_t t0 = __builtin_ia32_rdtsc();
+    for (int i = 0; i < Iters; i++)
+    {
+        if (usePext)
+            asm("pextq %1, %0, %0" : "+r"(acc) : "r"(mask));
+        else
+            asm("imulq %1, %0" : "+r"(acc) : "r"(mask));
+    }
+    asm volatile("lfence");
+    uint64_t t1 = __builtin_ia32_rdtsc();
+
+    asm volatile("" : : "r"(acc));
+    return t1 - t0;
+}
+
+// For AMD parts the compiler does not recognize (families newer than the
+// compiler, or brand detection defeated by a hypervisor), measure instead of
+// guessing: hardware pext matches imul at 3 cycles of latency, while the
+// microcoded implementation costs an order of magnitude more. Minimum over
+// several trials discards interrupts and frequency ramp-up.
+static bool measured_slow_pext() {
+    uint64_t bestPext = ~uint64_t(0), bestMul = ~uint64_t(0);
+    for (int trial = 0; trial < 16; trial++)
+    {
+        uint64_t p = chain_ticks(true), m = chain_ticks(false);
+        bestPext = p < bestPext ? p : bestPext;
+        bestMul  = m < bestMul ? m : bestMul;
+    }
+    return bestPext > 4 * bestMul;
+}
+
 // AMD Excavator (family 15h) and Zen/Zen+/Zen2 (family 17h) implement pdep/pext via microcode.
 static bool has_slow_bmi2() {
-    return __builtin_cpu_is("amd")
-        && (__builtin_cpu_is("bdver4") || __builtin_cpu_is("znver1") || __builtin_cpu_is("znver2"));
+    if (!__builtin_cpu_is("amd"))
+        return false;
+    if (__builtin_cpu_is("bdver4") || __builtin_cpu_is("znver1") || __builtin_cpu_is("znver2"))
+        return true;
+    return measured_slow_pext();
 }
 
 struct CpuFeatures {